@@ -0,0 +1,262 @@
+// 平衡性蒙特卡洛测试：在所有CPU核心上并行运行大量无窗口、由机器人操作的对局，
+// 每局使用不同种子，汇总存活时间、得分分布、Boss击杀率和每局耗时，写成CSV
+// 用法: balance [--runs <局数>] [--threads <线程数>] [--seed <基础种子>] [--difficulty <0-2>]
+//               [--boss] [--bot <dodge|sweep>] [--bot-upgrades <策略>] [--max-minutes <分钟>]
+//               [--csv <每局结果.csv>] [--summary <汇总.csv>]
+// 需要在c++目录下运行，碰撞框大小从assets中的图片读取
+
+#include "SimWorld.h"
+#include "Random.h"
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    // 一局的结果和耗时
+    struct BalanceRun {
+        Uint64 seed = 0;
+        SimResult result;
+        double survivalSeconds = 0; // 到本局结束的模拟时间，超时的局为帧数上限
+        Uint64 wallNs = 0;          // 这一局的实际耗时
+        Uint64 maxTickNs = 0;       // 最慢一帧的耗时
+    };
+
+    // 已排序数据的百分位数（最近秩）
+    template <typename T>
+    T percentile(const std::vector<T>& sorted, double p)
+    {
+        if (sorted.empty()) {
+            return T();
+        }
+        size_t index = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+        return sorted[std::min(index, sorted.size() - 1)];
+    }
+
+    template <typename T>
+    double mean(const std::vector<T>& values)
+    {
+        if (values.empty()) {
+            return 0.0;
+        }
+        double total = 0;
+        for (T value : values) {
+            total += static_cast<double>(value);
+        }
+        return total / static_cast<double>(values.size());
+    }
+
+    const char* progressName(BossProgress progress)
+    {
+        switch (progress) {
+            case BossProgress::Reached: return "reached";
+            case BossProgress::Defeated: return "defeated";
+            default: return "none";
+        }
+    }
+
+    void runOne(const SimWorldConfig& config, BalanceRun& record)
+    {
+        SimWorld world(config);
+        Uint64 start = SDL_GetTicksNS();
+        if (!world.start()) {
+            return;
+        }
+        while (!world.isDone()) {
+            Uint64 tickStart = SDL_GetTicksNS();
+            world.step();
+            record.maxTickNs = std::max(record.maxTickNs, SDL_GetTicksNS() - tickStart);
+        }
+        record.wallNs = SDL_GetTicksNS() - start;
+        record.result = world.getResult();
+        Uint64 ms = record.result.finished ? record.result.durationMs : record.result.ticks * 1000 / config.fps;
+        record.survivalSeconds = static_cast<double>(ms) / 1000.0;
+    }
+
+    bool writeRuns(const std::string& path, const std::vector<BalanceRun>& records, int difficulty)
+    {
+        std::ofstream file(path);
+        if (!file.is_open()) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cannot write %s", path.c_str());
+            return false;
+        }
+        file << "run,seed,difficulty,finished,victory,boss_progress,score,survival_s,ticks,"
+                "weapon_level,damage,fire_rate,bounce,split,piercing,wall_ms,ns_per_tick,max_tick_us\n";
+        char line[512];
+        for (size_t i = 0; i < records.size(); i++) {
+            const BalanceRun& record = records[i];
+            const SimResult& result = record.result;
+            double nsPerTick = result.ticks > 0 ? static_cast<double>(record.wallNs) / static_cast<double>(result.ticks) : 0.0;
+            std::snprintf(line, sizeof(line), "%zu,%llu,%d,%d,%d,%s,%d,%.3f,%llu,%d,%d,%.2f,%d,%d,%d,%.3f,%.1f,%.1f\n",
+                          i, static_cast<unsigned long long>(record.seed), difficulty,
+                          result.finished ? 1 : 0, result.victory ? 1 : 0, progressName(result.bossProgress),
+                          result.finalScore, record.survivalSeconds, static_cast<unsigned long long>(result.ticks),
+                          result.weapon.level, result.weapon.damage, result.weapon.fireRate,
+                          result.weapon.bounceCount, result.weapon.splitCount, result.weapon.piercing ? 1 : 0,
+                          static_cast<double>(record.wallNs) / 1e6, nsPerTick, static_cast<double>(record.maxTickNs) / 1e3);
+            file << line;
+        }
+        return true;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int runs = 1000;
+    int threadCount = static_cast<int>(std::thread::hardware_concurrency());
+    Uint64 baseSeed = 1;
+    double maxMinutes = 30;
+    SimWorldConfig config;
+    std::string csvPath = "balance_runs.csv";
+    std::string summaryPath;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--runs" && hasValue) {
+            runs = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--threads" && hasValue) {
+            threadCount = std::atoi(argv[++i]);
+        } else if (arg == "--seed" && hasValue) {
+            baseSeed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--difficulty" && hasValue) {
+            config.difficulty = std::max(0, std::min(2, std::atoi(argv[++i])));
+        } else if (arg == "--boss") {
+            config.startAtBoss = true;
+        } else if (arg == "--bot" && hasValue) {
+            config.botKind = argv[++i];
+        } else if (arg == "--bot-upgrades" && hasValue) {
+            config.botUpgrades = argv[++i];
+        } else if (arg == "--max-minutes" && hasValue) {
+            maxMinutes = std::atof(argv[++i]);
+        } else if (arg == "--csv" && hasValue) {
+            csvPath = argv[++i];
+        } else if (arg == "--summary" && hasValue) {
+            summaryPath = argv[++i];
+        } else {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Unknown argument: %s", arg.c_str());
+        }
+    }
+    if (threadCount <= 0) {
+        threadCount = 1;
+    }
+    threadCount = std::min(threadCount, runs);
+    config.maxTicks = static_cast<Uint64>(maxMinutes * 60.0 * config.fps);
+
+    // 先检查机器人设置，避免每个线程各报一次错
+    if (BotController::create(config.botKind, config.botUpgrades) == nullptr) {
+        return 2;
+    }
+    // 每局场景初始化的日志没有意义
+    SDL_SetLogPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_WARN);
+
+    // 种子由基础种子展开，同样的参数总是得到同样的结果，与线程数无关
+    std::vector<BalanceRun> records(static_cast<size_t>(runs));
+    Uint64 seedState = baseSeed;
+    for (BalanceRun& record : records) {
+        record.seed = splitMix64(seedState);
+    }
+
+    std::atomic<int> nextRun{0};
+    auto worker = [&]() {
+        int index;
+        while ((index = nextRun.fetch_add(1)) < runs) {
+            BalanceRun& record = records[static_cast<size_t>(index)];
+            SimWorldConfig runConfig = config;
+            runConfig.seed = record.seed;
+            runOne(runConfig, record);
+        }
+    };
+    Uint64 start = SDL_GetTicksNS();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < threadCount; i++) {
+        threads.emplace_back(worker);
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    Uint64 wallNs = SDL_GetTicksNS() - start;
+
+    // 汇总
+    std::vector<double> survival;
+    std::vector<int> scores;
+    std::vector<double> nsPerTick;
+    std::vector<Uint64> maxTick;
+    int finished = 0, reached = 0, defeated = 0;
+    Uint64 totalTicks = 0;
+    for (const BalanceRun& record : records) {
+        const SimResult& result = record.result;
+        survival.push_back(record.survivalSeconds);
+        totalTicks += result.ticks;
+        maxTick.push_back(record.maxTickNs);
+        if (result.ticks > 0) {
+            nsPerTick.push_back(static_cast<double>(record.wallNs) / static_cast<double>(result.ticks));
+        }
+        // 超时的局没有结算得分，不计入得分分布
+        if (result.finished) {
+            finished++;
+            scores.push_back(result.finalScore);
+        }
+        if (result.bossProgress != BossProgress::None) {
+            reached++;
+        }
+        if (result.bossProgress == BossProgress::Defeated) {
+            defeated++;
+        }
+    }
+    std::sort(survival.begin(), survival.end());
+    std::sort(scores.begin(), scores.end());
+    std::sort(nsPerTick.begin(), nsPerTick.end());
+    std::sort(maxTick.begin(), maxTick.end());
+
+    std::vector<std::pair<std::string, double>> summary = {
+        {"runs", runs},
+        {"threads", threadCount},
+        {"difficulty", config.difficulty},
+        {"finished", finished},
+        {"timeouts", runs - finished},
+        {"survival_s_mean", mean(survival)},
+        {"survival_s_p10", percentile(survival, 0.10)},
+        {"survival_s_p50", percentile(survival, 0.50)},
+        {"survival_s_p90", percentile(survival, 0.90)},
+        {"score_mean", mean(scores)},
+        {"score_p10", percentile(scores, 0.10)},
+        {"score_p50", percentile(scores, 0.50)},
+        {"score_p90", percentile(scores, 0.90)},
+        {"score_max", scores.empty() ? 0 : scores.back()},
+        {"boss_reach_rate", static_cast<double>(reached) / runs},
+        {"boss_kill_rate", static_cast<double>(defeated) / runs},
+        {"ns_per_tick_p50", percentile(nsPerTick, 0.50)},
+        {"max_tick_us_p99", static_cast<double>(percentile(maxTick, 0.99)) / 1e3},
+        {"ticks_per_sec", wallNs > 0 ? static_cast<double>(totalTicks) * 1e9 / static_cast<double>(wallNs) : 0.0},
+        {"wall_s", static_cast<double>(wallNs) / 1e9},
+    };
+    for (const auto& [name, value] : summary) {
+        std::printf("%-20s %14.4g\n", name.c_str(), value);
+    }
+
+    if (!writeRuns(csvPath, records, config.difficulty)) {
+        return 1;
+    }
+    std::printf("Runs written to %s\n", csvPath.c_str());
+    if (!summaryPath.empty()) {
+        std::ofstream file(summaryPath);
+        if (!file.is_open()) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cannot write %s", summaryPath.c_str());
+            return 1;
+        }
+        file << "metric,value\n";
+        for (const auto& [name, value] : summary) {
+            file << name << ',' << value << '\n';
+        }
+        std::printf("Summary written to %s\n", summaryPath.c_str());
+    }
+    return 0;
+}
@@ -0,0 +1,347 @@
+// 基准测试回归检查：比较当前结果和基线结果的JSON，有测试变慢超过阈值时返回非零
+// 用法: bench_compare <基线.json> <当前.json> [--thresholds <文件>] [--default <百分比>] [--allow-missing]
+// 阈值文件每行 "<测试名前缀> <百分比>"，按最长前缀匹配，#开头为注释
+// 基线中有而当前结果中没有的测试视为失败，除非指定--allow-missing
+// 不依赖SDL，可以在没有图形环境的CI机器上单独编译运行
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr double MIN_NS = 1.0; // 低于此耗时的结果不参与判断
+    constexpr double MAX_NOISE_FACTOR = 3.0; // 基线波动最多把阈值放宽到配置阈值的这个倍数
+    // 比较需要的字段
+    struct Entry {
+        double nsPerOp = 0;
+        double spreadPercent = 0; // (最慢 - 最快) / 中位数，衡量这次测量本身的噪声
+    };
+
+    // 只解析基准测试JSON用到的子集：对象、数组、字符串、数字、true/false/null
+    class JsonReader
+    {
+    public:
+        explicit JsonReader(const std::string& text) : text(text) {}
+
+        // 读取results数组中每个对象的name和耗时字段
+        bool readResults(std::map<std::string, Entry>& entries)
+        {
+            skipSpace();
+            if (!consume('{')) {
+                return false;
+            }
+            while (true) {
+                skipSpace();
+                if (consume('}')) {
+                    return true;
+                }
+                std::string key;
+                if (!readString(key) || !expect(':')) {
+                    return false;
+                }
+                if (key == "results") {
+                    if (!readResultArray(entries)) {
+                        return false;
+                    }
+                } else if (!skipValue()) {
+                    return false;
+                }
+                skipSpace();
+                consume(',');
+            }
+        }
+
+    private:
+        const std::string& text;
+        size_t pos = 0;
+
+        void skipSpace()
+        {
+            while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) {
+                pos++;
+            }
+        }
+
+        bool consume(char c)
+        {
+            if (pos < text.size() && text[pos] == c) {
+                pos++;
+                return true;
+            }
+            return false;
+        }
+
+        bool expect(char c)
+        {
+            skipSpace();
+            return consume(c);
+        }
+
+        bool readString(std::string& out)
+        {
+            skipSpace();
+            if (!consume('"')) {
+                return false;
+            }
+            out.clear();
+            while (pos < text.size() && text[pos] != '"') {
+                if (text[pos] == '\\' && pos + 1 < text.size()) {
+                    pos++;
+                }
+                out.push_back(text[pos++]);
+            }
+            return consume('"');
+        }
+
+        bool readNumber(double& out)
+        {
+            skipSpace();
+            const char* start = text.c_str() + pos;
+            char* end = nullptr;
+            out = std::strtod(start, &end);
+            if (end == start) {
+                return false;
+            }
+            pos += static_cast<size_t>(end - start);
+            return true;
+        }
+
+        bool skipValue()
+        {
+            skipSpace();
+            if (pos >= text.size()) {
+                return false;
+            }
+            char c = text[pos];
+            if (c == '"') {
+                std::string ignored;
+                return readString(ignored);
+            }
+            if (c == '{' || c == '[') {
+                char close = c == '{' ? '}' : ']';
+                pos++;
+                while (true) {
+                    skipSpace();
+                    if (consume(close)) {
+                        return true;
+                    }
+                    if (c == '{') {
+                        std::string key;
+                        if (!readString(key) || !expect(':')) {
+                            return false;
+                        }
+                    }
+                    if (!skipValue()) {
+                        return false;
+                    }
+                    skipSpace();
+                    consume(',');
+                }
+            }
+            for (const char* word : {"true", "false", "null"}) {
+                size_t length = std::char_traits<char>::length(word);
+                if (text.compare(pos, length, word) == 0) {
+                    pos += length;
+                    return true;
+                }
+            }
+            double ignored;
+            return readNumber(ignored);
+        }
+
+        bool readResultArray(std::map<std::string, Entry>& entries)
+        {
+            if (!expect('[')) {
+                return false;
+            }
+            while (true) {
+                skipSpace();
+                if (consume(']')) {
+                    return true;
+                }
+                if (!expect('{')) {
+                    return false;
+                }
+                std::string name;
+                double nsPerOp = 0, minNs = 0, maxNs = 0;
+                while (true) {
+                    skipSpace();
+                    if (consume('}')) {
+                        break;
+                    }
+                    std::string key;
+                    if (!readString(key) || !expect(':')) {
+                        return false;
+                    }
+                    bool ok = true;
+                    if (key == "name") {
+                        ok = readString(name);
+                    } else if (key == "ns_per_op") {
+                        ok = readNumber(nsPerOp);
+                    } else if (key == "min_ns_per_op") {
+                        ok = readNumber(minNs);
+                    } else if (key == "max_ns_per_op") {
+                        ok = readNumber(maxNs);
+                    } else {
+                        ok = skipValue();
+                    }
+                    if (!ok) {
+                        return false;
+                    }
+                    skipSpace();
+                    consume(',');
+                }
+                if (!name.empty()) {
+                    Entry entry;
+                    entry.nsPerOp = nsPerOp;
+                    entry.spreadPercent = nsPerOp > 0 && maxNs >= minNs ? 100.0 * (maxNs - minNs) / nsPerOp : 0.0;
+                    entries[name] = entry;
+                }
+                skipSpace();
+                consume(',');
+            }
+        }
+    };
+
+    bool loadResults(const std::string& path, std::map<std::string, Entry>& entries)
+    {
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            std::fprintf(stderr, "Cannot open %s\n", path.c_str());
+            return false;
+        }
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        std::string text = buffer.str();
+        JsonReader reader(text);
+        if (!reader.readResults(entries)) {
+            std::fprintf(stderr, "Malformed benchmark JSON: %s\n", path.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    // 阈值文件：前缀 -> 允许变慢的百分比，"default" 为默认值
+    bool loadThresholds(const std::string& path, std::map<std::string, double>& thresholds, double& defaultThreshold)
+    {
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            std::fprintf(stderr, "Cannot open %s\n", path.c_str());
+            return false;
+        }
+        std::string line;
+        while (std::getline(file, line)) {
+            std::istringstream fields(line);
+            std::string prefix;
+            double percent = 0;
+            if (!(fields >> prefix) || prefix[0] == '#') {
+                continue;
+            }
+            if (!(fields >> percent)) {
+                std::fprintf(stderr, "Ignoring threshold line: %s\n", line.c_str());
+                continue;
+            }
+            if (prefix == "default") {
+                defaultThreshold = percent;
+            } else {
+                thresholds[prefix] = percent;
+            }
+        }
+        return true;
+    }
+
+    double thresholdFor(const std::string& name, const std::map<std::string, double>& thresholds, double defaultThreshold)
+    {
+        double result = defaultThreshold;
+        size_t bestLength = 0;
+        for (const auto& [prefix, percent] : thresholds) {
+            if (prefix.size() > bestLength && name.compare(0, prefix.size(), prefix) == 0) {
+                result = percent;
+                bestLength = prefix.size();
+            }
+        }
+        return result;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> files;
+    std::string thresholdPath;
+    double defaultThreshold = 10.0;
+    bool allowMissing = false;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--thresholds" && i + 1 < argc) {
+            thresholdPath = argv[++i];
+        } else if (arg == "--default" && i + 1 < argc) {
+            defaultThreshold = std::atof(argv[++i]);
+        } else if (arg == "--allow-missing") {
+            allowMissing = true;
+        } else {
+            files.push_back(arg);
+        }
+    }
+    if (files.size() != 2) {
+        std::fprintf(stderr, "Usage: bench_compare <baseline.json> <current.json> [--thresholds <file>] [--default <percent>] [--allow-missing]\n");
+        return 2;
+    }
+
+    std::map<std::string, Entry> baseline, current;
+    std::map<std::string, double> thresholds;
+    if (!loadResults(files[0], baseline) || !loadResults(files[1], current)) {
+        return 2;
+    }
+    if (!thresholdPath.empty() && !loadThresholds(thresholdPath, thresholds, defaultThreshold)) {
+        return 2;
+    }
+
+    int regressions = 0, unreliable = 0, missing = 0, improvements = 0, compared = 0;
+    std::printf("%-44s %14s %14s %9s %8s  %s\n", "benchmark", "baseline ns", "current ns", "change", "limit", "status");
+    for (const auto& [name, now] : current) {
+        auto it = baseline.find(name);
+        if (it == baseline.end()) {
+            std::printf("%-44s %14s %14.1f %9s %8s  %s\n", name.c_str(), "-", now.nsPerOp, "-", "-", "new");
+            continue;
+        }
+        const Entry& before = it->second;
+        compared++;
+        // 允许的波动只由基线决定，并且有上限：当前结果再吵也不能放宽自己的阈值
+        double threshold = thresholdFor(name, thresholds, defaultThreshold);
+        double limit = std::min(std::max(threshold, before.spreadPercent), threshold * MAX_NOISE_FACTOR);
+        double change = before.nsPerOp > 0 ? 100.0 * (now.nsPerOp - before.nsPerOp) / before.nsPerOp : 0.0;
+        const char* status = "ok";
+        if (before.nsPerOp < MIN_NS && now.nsPerOp < MIN_NS) {
+            status = "ok (tiny)"; // 不到1纳秒的区段只是计时误差
+        } else if (now.spreadPercent > limit) {
+            status = "UNRELIABLE"; // 当前测量的波动超过允许范围，结果不能说明快慢
+            unreliable++;
+        } else if (change > limit) {
+            status = "REGRESSION";
+            regressions++;
+        } else if (change < -limit) {
+            status = "faster";
+            improvements++;
+        }
+        std::printf("%-44s %14.1f %14.1f %+8.1f%% %7.1f%%  %s\n", name.c_str(), before.nsPerOp, now.nsPerOp, change, limit, status);
+    }
+    for (const auto& [name, before] : baseline) {
+        if (current.find(name) == current.end()) {
+            std::printf("%-44s %14.1f %14s %9s %8s  %s\n", name.c_str(), before.nsPerOp, "-", "-", "-",
+                        allowMissing ? "missing (allowed)" : "MISSING");
+            missing++;
+        }
+    }
+
+    std::printf("\n%d regression(s), %d unreliable, %d missing, %d improvement(s), %d benchmark(s) compared\n",
+                regressions, unreliable, missing, improvements, compared);
+    bool failed = regressions > 0 || unreliable > 0 || (missing > 0 && !allowMissing);
+    return failed ? 1 : 0;
+}
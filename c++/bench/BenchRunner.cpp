@@ -0,0 +1,65 @@
+#include "BenchRunner.h"
+#include <algorithm>
+
+void BenchRunner::add(const std::string& name, Uint64 itemsPerOp, std::function<Uint64()> op)
+{
+    Case bench;
+    bench.name = name;
+    bench.itemsPerOp = itemsPerOp > 0 ? itemsPerOp : 1;
+    bench.op = std::move(op);
+    cases.push_back(std::move(bench));
+}
+
+Uint64 BenchRunner::timeOps(const Case& bench, Uint64 iterations)
+{
+    Uint64 start = SDL_GetTicksNS();
+    for (Uint64 i = 0; i < iterations; i++) {
+        sink += bench.op();
+    }
+    return SDL_GetTicksNS() - start;
+}
+
+BenchResult BenchRunner::runCase(const Case& bench)
+{
+    // 预热并确定每轮次数：每次翻倍，直到一轮耗时达到最短时间
+    Uint64 iterations = 1;
+    Uint64 elapsed = timeOps(bench, iterations);
+    while (elapsed < minTimeNs && iterations < (1ull << 40)) {
+        Uint64 grow = elapsed > 0 ? minTimeNs / elapsed + 1 : 2;
+        iterations *= std::max<Uint64>(2, std::min<Uint64>(grow, 100));
+        elapsed = timeOps(bench, iterations);
+    }
+
+    std::vector<double> perOp;
+    for (int i = 0; i < samples; i++) {
+        perOp.push_back(static_cast<double>(timeOps(bench, iterations)) / static_cast<double>(iterations));
+    }
+    std::sort(perOp.begin(), perOp.end());
+
+    BenchResult result;
+    result.name = bench.name;
+    result.nsPerOp = perOp[perOp.size() / 2];
+    result.minNsPerOp = perOp.front();
+    result.maxNsPerOp = perOp.back();
+    result.itemsPerSec = result.nsPerOp > 0 ? static_cast<double>(bench.itemsPerOp) * 1e9 / result.nsPerOp : 0.0;
+    result.iterations = iterations;
+    result.samples = samples;
+    return result;
+}
+
+void BenchRunner::runAll()
+{
+    results.clear();
+    SDL_Log("%-40s %14s %14s %16s", "benchmark", "ns/op", "spread", "items/s");
+    for (const Case& bench : cases) {
+        if (!filter.empty() && bench.name.find(filter) == std::string::npos) {
+            continue;
+        }
+        BenchResult result = runCase(bench);
+        double spread = result.nsPerOp > 0 ? 100.0 * (result.maxNsPerOp - result.minNsPerOp) / result.nsPerOp : 0.0;
+        SDL_Log("%-40s %14.1f %13.1f%% %16.4g", result.name.c_str(), result.nsPerOp, spread, result.itemsPerSec);
+        results.push_back(result);
+    }
+    // 输出累加值，保证被测操作的结果被使用
+    SDL_LogDebug(SDL_LOG_CATEGORY_APPLICATION, "checksum %llu", static_cast<unsigned long long>(sink));
+}
@@ -0,0 +1,56 @@
+#ifndef BENCH_RUNNER_H
+#define BENCH_RUNNER_H
+
+#include "BenchReport.h"
+#include <SDL3/SDL.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * 微基准测试运行器
+ * 先自动增加操作次数直到一轮耗时超过最短时间，再采样若干轮取中位数，
+ * 结果输出成表格，并可写成JSON供回归比较
+ */
+class BenchRunner
+{
+public:
+    /**
+     * 注册一个基准测试
+     * @param name 测试名，用"/"分组
+     * @param itemsPerOp 每次操作处理的元素数，用于计算每秒元素数
+     * @param op 被测操作，返回值会累加起来防止被编译器优化掉
+     */
+    void add(const std::string& name, Uint64 itemsPerOp, std::function<Uint64()> op);
+
+    void setFilter(const std::string& text) { filter = text; }  // 只运行名字包含该文本的测试
+    void setMinTimeMs(Uint64 ms) { minTimeNs = ms * SDL_NS_PER_MS; } // 每轮最短时间
+    void setSamples(int count) { samples = count > 0 ? count : 1; }  // 采样轮数
+
+    void runAll(); // 运行全部测试并输出表格
+    const std::vector<BenchResult>& getResults() const { return results; }
+
+    bool writeJson(const std::string& path) const { return BenchReport::writeJson(path, "micro", results); } // 把结果写成JSON
+
+private:
+    struct Case {
+        std::string name;
+        Uint64 itemsPerOp = 1;
+        std::function<Uint64()> op;
+    };
+
+    std::vector<Case> cases;
+    std::vector<BenchResult> results;
+    std::string filter;
+    Uint64 minTimeNs = 100 * SDL_NS_PER_MS;
+    int samples = 5;
+    Uint64 sink = 0; // 累加操作返回值，防止被测代码被优化掉
+
+    Uint64 timeOps(const Case& bench, Uint64 iterations); // 运行iterations次，返回耗时（纳秒）
+    BenchResult runCase(const Case& bench);
+};
+
+// 注册所有微基准测试（Benchmarks.cpp）
+void registerBenchmarks(BenchRunner& runner);
+
+#endif // BENCH_RUNNER_H
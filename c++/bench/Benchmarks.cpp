@@ -0,0 +1,300 @@
+#include "BenchRunner.h"
+#include "FastMath.h"
+#include "EcsSystems.h"
+#include "EnemyArchetype.h"
+#include "Game.h"
+#include "Object.h"
+#include "Random.h"
+#include <climits>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr float WIDTH = 1200.0f;      // 与游戏窗口相同的场地大小
+    constexpr float HEIGHT = 750.0f;
+    constexpr float DELTA_TIME = 1.0f / 60.0f;
+    constexpr float ENEMY_SIZE = 64.0f;   // 敌人尺寸按类型共用，测试中统一取64
+
+    /**
+     * 实体的生成和删除：场上保持固定数量的实体，每次操作随机删除一批，flush后再生成同样多的新实体
+     * 删除的实体分散在整个原型中，flush需要移动后面的实体
+     * @param spawn 生成一个实体的函数
+     */
+    template<typename F>
+    void addEntityChurn(BenchRunner& runner, const char* kind, size_t population, size_t batch, F spawn)
+    {
+        struct State {
+            EcsWorld world;
+            std::vector<Entity> live;
+            Rng rng{1};
+        };
+        auto state = std::make_shared<State>();
+        for (size_t i = 0; i < population; i++) {
+            state->live.push_back(spawn(state->world, state->rng));
+        }
+
+        runner.add(std::string("ecs/churn/") + kind, batch, [state, batch, spawn]() {
+            EcsWorld& world = state->world;
+            std::vector<Entity>& live = state->live;
+            for (size_t i = 0; i < batch; i++) {
+                size_t index = static_cast<size_t>(state->rng.nextInt(static_cast<int>(live.size())));
+                world.destroy(live[index]);
+                live[index] = live.back();
+                live.pop_back();
+            }
+            world.flush();
+            for (size_t i = 0; i < batch; i++) {
+                live.push_back(spawn(world, state->rng));
+            }
+            return static_cast<Uint64>(world.count<Transform>());
+        });
+    }
+
+    // 按类型的移动方式生成敌人，与SceneMain::createEnemy的原型组合相同
+    void addEnemies(EcsWorld& world, Rng& rng, size_t count)
+    {
+        for (size_t i = 0; i < count; i++) {
+            Enemy enemy;
+            enemy.type = static_cast<int>(i % ENEMY_ARCHETYPE_COUNT);
+            enemy.currentHealth = INT_MAX; // 测试中敌人不会被击毁
+            enemy.id = static_cast<Uint32>(i + 1);
+            Transform transform;
+            transform.position = {rng.range(0, WIDTH), rng.range(0, HEIGHT)};
+            transform.width = ENEMY_SIZE;
+            transform.height = ENEMY_SIZE;
+            Velocity velocity = {{-1, 0}, ENEMY_ARCHETYPES[enemy.type].speed};
+            switch (ENEMY_ARCHETYPES[enemy.type].motion) {
+                case EnemyMotion::Wave:
+                    world.create(transform, velocity, Sprite{}, enemy, EnemyDrift{});
+                    break;
+                case EnemyMotion::Spin:
+                    world.create(transform, velocity, Sprite{}, enemy, EnemySpin{});
+                    break;
+                default:
+                    world.create(transform, velocity, Sprite{}, enemy);
+                    break;
+            }
+        }
+    }
+
+    // 在场地内随机位置生成一颗随机方向的玩家子弹
+    void addRandomShot(EcsWorld& world, Rng& rng, const ProjectilePlayer& prototype, int maxBounces)
+    {
+        SDL_FPoint position = {rng.range(1, WIDTH - prototype.width - 1), rng.range(1, HEIGHT - prototype.height - 1)};
+        float angle = rng.range(0, 2 * SDL_PI_F);
+        spawnPlayerShot(world, prototype, position, {std::cos(angle), std::sin(angle)}, prototype.damage, maxBounces);
+    }
+
+    /**
+     * 游戏中的玩家子弹更新（playerShotSystem）的各个特化：移动、边界处理和与敌人的碰撞
+     * 每次操作后补齐被删除的子弹，保证每次操作的子弹数量不变
+     */
+    template <bool Bounce, bool Pierce>
+    void addPlayerShots(BenchRunner& runner, const char* kind, size_t count, size_t enemyCount)
+    {
+        struct State {
+            EcsWorld world;
+            ProjectilePlayer prototype;
+            Rng rng{2};
+        };
+        auto state = std::make_shared<State>();
+        state->prototype.width = 16;
+        state->prototype.height = 16;
+        int maxBounces = Bounce ? 3 : 0;
+        EcsWorld& world = state->world;
+        world.reserve<Transform, Velocity, Sprite, PlayerShot>(count);
+        addEnemies(world, state->rng, enemyCount);
+        for (size_t i = 0; i < count; i++) {
+            addRandomShot(world, state->rng, state->prototype, maxBounces);
+        }
+
+        std::string name = std::string("projectile/") + kind + "/" + std::to_string(count);
+        runner.add(name, count, [state, count, maxBounces]() {
+            EcsWorld& world = state->world;
+            int hits = playerShotSystem<Bounce, Pierce>(world, DELTA_TIME, WIDTH, HEIGHT, nullptr);
+            world.flush();
+            for (size_t live = world.count<PlayerShot>(); live < count; live++) {
+                addRandomShot(world, state->rng, state->prototype, maxBounces);
+            }
+            return static_cast<Uint64>(hits);
+        });
+    }
+
+    /**
+     * 游戏中的玩家子弹与敌人碰撞检测（collidePlayerShot），子弹和敌人在同一个EcsWorld中
+     * 穿透子弹每次操作前清空击中记录，同时测量击中记录的查询和插入
+     */
+    template <bool Pierce>
+    void addCollision(BenchRunner& runner, size_t bulletCount, size_t enemyCount)
+    {
+        struct State {
+            EcsWorld world;
+        };
+        auto state = std::make_shared<State>();
+        Rng rng(3);
+        ProjectilePlayer prototype;
+        prototype.width = 16;
+        prototype.height = 16;
+        EcsWorld& world = state->world;
+        world.reserve<Transform, Velocity, Sprite, PlayerShot>(bulletCount);
+        for (size_t i = 0; i < bulletCount; i++) {
+            spawnPlayerShot(world, prototype, {rng.range(0, WIDTH), rng.range(0, HEIGHT)}, {1, 0}, prototype.damage, 0);
+        }
+        addEnemies(world, rng, enemyCount);
+
+        std::string name = std::string("collision/") + (Pierce ? "pierce" : "first_hit") + "/" +
+                           std::to_string(bulletCount) + "x" + std::to_string(enemyCount);
+        runner.add(name, bulletCount * enemyCount, [state]() {
+            EcsWorld& world = state->world;
+            Uint64 hits = 0;
+            world.each<PlayerShot, Transform>([&](Entity, PlayerShot& shot, Transform& transform) {
+                if constexpr (Pierce) {
+                    shot.hitEnemies.clear();
+                }
+                SDL_FRect shotRect = {transform.position.x, transform.position.y, transform.width, transform.height};
+                hits += collidePlayerShot<Pierce>(world, shot, shotRect);
+            });
+            return hits;
+        });
+    }
+
+    // 正弦余弦：libm与FastMath的查表版本、批量版本对比，角度取游戏中常见的[-2π, 2π]
+    void addSinCos(BenchRunner& runner, size_t count)
+    {
+        struct State {
+            std::vector<float> angles;
+            std::vector<float> sines;
+            std::vector<float> cosines;
+        };
+        auto state = std::make_shared<State>();
+        Rng rng(4);
+        for (size_t i = 0; i < count; i++) {
+            state->angles.push_back(rng.range(-2 * SDL_PI_F, 2 * SDL_PI_F));
+        }
+        state->sines.resize(count);
+        state->cosines.resize(count);
+
+        // 返回值只用于防止计算被优化掉
+        auto checksum = [](const State& state) {
+            float sum = 0;
+            for (size_t i = 0; i < state.sines.size(); i++) {
+                sum += state.sines[i] + state.cosines[i];
+            }
+            return static_cast<Uint64>(sum * 1000.0f + 1e9f);
+        };
+
+        std::string suffix = "/" + std::to_string(count);
+        runner.add("math/sincos_libm" + suffix, count, [state, checksum]() {
+            for (size_t i = 0; i < state->angles.size(); i++) {
+                state->sines[i] = std::sin(state->angles[i]);
+                state->cosines[i] = std::cos(state->angles[i]);
+            }
+            return checksum(*state);
+        });
+        runner.add("math/sincos_fast" + suffix, count, [state, checksum]() {
+            for (size_t i = 0; i < state->angles.size(); i++) {
+                fastSinCos(state->angles[i], state->sines[i], state->cosines[i]);
+            }
+            return checksum(*state);
+        });
+        runner.add("math/sincos_batch" + suffix, count, [state, checksum]() {
+            fastSinCosBatch(state->angles.data(), state->sines.data(), state->cosines.data(), state->angles.size());
+            return checksum(*state);
+        });
+    }
+
+    // 方向归一化和子弹朝向：sqrt + atan2与FastMath对比
+    void addNormalize(BenchRunner& runner, size_t count)
+    {
+        struct State {
+            std::vector<SDL_FPoint> offsets;
+        };
+        auto state = std::make_shared<State>();
+        Rng rng(5);
+        for (size_t i = 0; i < count; i++) {
+            state->offsets.push_back({rng.range(-WIDTH, WIDTH), rng.range(-HEIGHT, HEIGHT)});
+        }
+
+        std::string suffix = "/" + std::to_string(count);
+        runner.add("math/direction_libm" + suffix, count, [state]() {
+            float sum = 0;
+            for (const SDL_FPoint& offset : state->offsets) {
+                float length = std::sqrt(offset.x * offset.x + offset.y * offset.y);
+                sum += offset.x / length + std::atan2(offset.y, offset.x);
+            }
+            return static_cast<Uint64>(sum * 1000.0f + 1e9f);
+        });
+        runner.add("math/direction_fast" + suffix, count, [state]() {
+            float sum = 0;
+            for (const SDL_FPoint& offset : state->offsets) {
+                sum += fastNormalize(offset.x, offset.y).x + fastAtan2(offset.y, offset.x);
+            }
+            return static_cast<Uint64>(sum * 1000.0f + 1e9f);
+        });
+    }
+}
+
+void registerBenchmarks(BenchRunner& runner)
+{
+    // 与游戏相同的玩家子弹和爆炸原型
+    ProjectilePlayer shotPrototype;
+    shotPrototype.width = 16;
+    shotPrototype.height = 16;
+    addEntityChurn(runner, "player_shot", 256, 64, [shotPrototype](EcsWorld& world, Rng& rng) {
+        return spawnPlayerShot(world, shotPrototype, {rng.range(0, WIDTH), rng.range(0, HEIGHT)}, {1, 0},
+                               shotPrototype.damage, 3);
+    });
+    Explosion explosionPrototype;
+    explosionPrototype.width = 64;
+    explosionPrototype.height = 64;
+    explosionPrototype.totlaFrame = 8;
+    explosionPrototype.frameSize = 64;
+    addEntityChurn(runner, "explosion", 64, 16, [explosionPrototype](EcsWorld& world, Rng& rng) {
+        return spawnExplosion(world, explosionPrototype, {rng.range(0, WIDTH), rng.range(0, HEIGHT)}, 0);
+    });
+
+    // 每种武器特性组合一个特化，basic是不反弹不穿透的无分支版本
+    for (size_t count : {100, 1000}) {
+        addPlayerShots<false, false>(runner, "basic", count, 30);
+        addPlayerShots<true, false>(runner, "bounce", count, 30);
+        addPlayerShots<false, true>(runner, "pierce", count, 30);
+        addPlayerShots<true, true>(runner, "bounce_pierce", count, 30);
+    }
+
+    addCollision<false>(runner, 50, 10);
+    addCollision<false>(runner, 200, 30);
+    addCollision<false>(runner, 1000, 100);
+    addCollision<true>(runner, 50, 10);
+    addCollision<true>(runner, 200, 30);
+    addCollision<true>(runner, 1000, 100);
+
+    addSinCos(runner, 1000);
+    addNormalize(runner, 1000);
+
+    // 渲染测试使用游戏本身的渲染代码，需要Game已用dummy驱动初始化；
+    // 每次操作后立即执行渲染命令，避免命令在队列中无限堆积
+    Game& game = Game::getInstance();
+    if (game.getRenderer() == nullptr) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "No renderer, skipping render benchmarks");
+        return;
+    }
+    runner.add("render/text", 1, [&game]() {
+        game.renderTextPos("SCORE: 123456", 20, 20);
+        SDL_FlushRenderer(game.getRenderer());
+        return Uint64(1);
+    });
+    runner.add("render/text_centered", 1, [&game]() {
+        SDL_FPoint end = game.renderTextCentered("游戏结束", 0.4f, true);
+        SDL_FlushRenderer(game.getRenderer());
+        return static_cast<Uint64>(end.x);
+    });
+    runner.add("render/background", 1, [&game]() {
+        game.backgroundUpdate(DELTA_TIME);
+        game.renderBackground();
+        SDL_FlushRenderer(game.getRenderer());
+        return Uint64(1);
+    });
+}
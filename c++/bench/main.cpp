@@ -0,0 +1,54 @@
+#include "BenchRunner.h"
+#include "Game.h"
+#include <SDL3/SDL_main.h>
+#include <cstdlib>
+#include <string>
+
+/**
+ * 微基准测试入口
+ * 用法: bench [--filter <文本>] [--json <文件>] [--min-time <毫秒>] [--samples <轮数>]
+ * 需要在c++目录下运行，渲染测试会读取assets中的图片和字体
+ */
+int main(int argc, char* argv[])
+{
+    BenchRunner runner;
+    std::string jsonPath;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--filter" && hasValue) {
+            runner.setFilter(argv[++i]);
+        } else if (arg == "--json" && hasValue) {
+            jsonPath = argv[++i];
+        } else if (arg == "--min-time" && hasValue) {
+            runner.setMinTimeMs(std::strtoull(argv[++i], nullptr, 10));
+        } else if (arg == "--samples" && hasValue) {
+            runner.setSamples(std::atoi(argv[++i]));
+        } else {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Unknown argument: %s", arg.c_str());
+        }
+    }
+
+    // 用无窗口模式初始化游戏，渲染测试直接调用游戏的渲染函数
+    char program[] = "bench";
+    char headless[] = "--headless";
+    char* gameArgs[] = {program, headless};
+    Game& game = Game::getInstance();
+    game.parseArgs(2, gameArgs);
+    game.init();
+
+    registerBenchmarks(runner);
+    runner.runAll();
+
+    bool written = true;
+    if (!jsonPath.empty()) {
+        written = runner.writeJson(jsonPath);
+        if (written) {
+            SDL_Log("Results written to %s", jsonPath.c_str());
+        }
+    }
+
+    // 停止音频和存档线程并释放SDL资源
+    game.clean();
+    return written ? 0 : 1;
+}
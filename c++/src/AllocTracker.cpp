@@ -0,0 +1,369 @@
+#include "AllocTracker.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <new>
+
+#if defined(ALLOC_TRACKING) && !defined(NDEBUG) && (defined(__GNUC__) || defined(__clang__)) && !defined(_WIN32)
+#define ALLOC_TRACKING_SITES // 调试版本按调用位置统计
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define ALLOC_CALLER __builtin_return_address(0)
+#else
+#define ALLOC_CALLER nullptr
+#endif
+
+namespace
+{
+    thread_local bool tracking = false;          // 当前线程是否统计
+    thread_local AllocCounters counters;         // 当前线程的累计值
+    thread_local const char* currentZone = nullptr; // 当前计时区段
+
+#ifdef ALLOC_TRACKING_SITES
+    constexpr int SITE_DEPTH = 8; // 每个调用位置保存的调用栈深度
+
+    // 一段调用栈在某个区段中的分配
+    struct Site {
+        void* frames[SITE_DEPTH] = {}; // 从分配函数的调用者开始的返回地址
+        int depth = 0;
+        const char* zone = nullptr;
+        Uint64 count = 0;
+        Uint64 bytes = 0;
+    };
+
+    // 固定大小的开放寻址表，记录时不能再分配内存
+    constexpr size_t SITE_CAPACITY = 4096;
+    Site sites[SITE_CAPACITY];
+    std::atomic_flag siteLock = ATOMIC_FLAG_INIT;
+    thread_local bool capturing = false; // 正在取调用栈，其间的分配不记录位置
+
+    // 把地址写成"模块+偏移 函数名"，不受地址随机化影响，可直接交给addr2line
+    void describeAddress(void* address, char* text, size_t size)
+    {
+        Dl_info info;
+        if (dladdr(address, &info) != 0 && info.dli_fname != nullptr) {
+            const char* name = std::strrchr(info.dli_fname, '/');
+            size_t offset = static_cast<size_t>(static_cast<char*>(address) - static_cast<char*>(info.dli_fbase));
+            int status = -1;
+            char* function = info.dli_sname != nullptr ? abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status) : nullptr;
+            const char* symbol = status == 0 ? function : (info.dli_sname != nullptr ? info.dli_sname : "");
+            std::snprintf(text, size, "%s+0x%zx %s", name != nullptr ? name + 1 : info.dli_fname, offset, symbol);
+            std::free(function);
+        } else {
+            std::snprintf(text, size, "%p", address);
+        }
+    }
+
+    // 修饰名是否属于std或__gnu_cxx命名空间（St以及Sa、Ss等std::缩写）
+    bool isStdSymbol(const char* mangled)
+    {
+        if (std::strncmp(mangled, "_Z", 2) != 0) {
+            return false;
+        }
+        const char* p = mangled + 2;
+        if (*p == 'N') {
+            p++;
+            while (*p == 'K' || *p == 'V' || *p == 'r') {
+                p++;
+            }
+        }
+        if (p[0] == 'S' && p[1] != '\0' && std::strchr("tabsiod", p[1]) != nullptr) {
+            return true;
+        }
+        return std::strncmp(p, "9__gnu_cxx", 10) == 0;
+    }
+
+    // 帧是否在标准库、容器分配器或SDL内部，报告时跳过这些帧
+    bool isLibraryFrame(void* address)
+    {
+        Dl_info info;
+        if (dladdr(address, &info) == 0) {
+            return false;
+        }
+        if (info.dli_fname != nullptr) {
+            const char* name = std::strrchr(info.dli_fname, '/');
+            name = name != nullptr ? name + 1 : info.dli_fname;
+            if (std::strncmp(name, "libstdc++", 9) == 0 || std::strncmp(name, "libc++", 6) == 0 ||
+                std::strncmp(name, "libSDL3", 7) == 0) {
+                return true;
+            }
+        }
+        // 可执行文件里实例化的模板要导出符号才能认出来（CMake中随分配统计开启ENABLE_EXPORTS）
+        return info.dli_sname != nullptr && isStdSymbol(info.dli_sname);
+    }
+
+    // 第一个不在库内部的帧，全部在库内部时取最外层的帧
+    void* callSite(const Site& site)
+    {
+        for (int i = 0; i < site.depth; i++) {
+            if (!isLibraryFrame(site.frames[i])) {
+                return site.frames[i];
+            }
+        }
+        return site.frames[site.depth - 1];
+    }
+
+    void recordSite(void* caller, size_t size)
+    {
+        if (capturing) {
+            return;
+        }
+        // 调用栈开头是统计函数自身，从分配函数的调用者开始保存
+        void* stack[SITE_DEPTH + 8];
+        capturing = true;
+        int captured = backtrace(stack, static_cast<int>(sizeof(stack) / sizeof(stack[0])));
+        capturing = false;
+        int first = 0;
+        while (first < captured && stack[first] != caller) {
+            first++;
+        }
+        if (first == captured) {
+            stack[0] = caller;
+            first = 0;
+            captured = 1;
+        }
+        int depth = std::min(captured - first, SITE_DEPTH);
+        void** frames = stack + first;
+
+        size_t key = reinterpret_cast<size_t>(currentZone) >> 3;
+        for (int i = 0; i < depth; i++) {
+            key = (key ^ reinterpret_cast<size_t>(frames[i])) * 0x100000001B3ull;
+        }
+        size_t index = (key * 0x9E3779B97F4A7C15ull) >> 20;
+        while (siteLock.test_and_set(std::memory_order_acquire)) {
+        }
+        for (size_t probe = 0; probe < SITE_CAPACITY; probe++) {
+            Site& site = sites[(index + probe) & (SITE_CAPACITY - 1)];
+            if (site.depth == 0) {
+                std::copy(frames, frames + depth, site.frames);
+                site.depth = depth;
+                site.zone = currentZone;
+            }
+            if (site.depth == depth && site.zone == currentZone && std::equal(frames, frames + depth, site.frames)) {
+                site.count++;
+                site.bytes += size;
+                break;
+            }
+        }
+        // 表满时不再记录新位置
+        siteLock.clear(std::memory_order_release);
+    }
+#endif
+
+#ifdef ALLOC_TRACKING
+    void countAllocation(size_t size, void* caller)
+    {
+        if (!tracking) {
+            return;
+        }
+        counters.count++;
+        counters.bytes += size;
+#ifdef ALLOC_TRACKING_SITES
+        recordSite(caller, size);
+#else
+        (void)caller;
+#endif
+    }
+
+    void* allocate(size_t size, void* caller)
+    {
+        void* memory = std::malloc(size > 0 ? size : 1);
+        if (memory != nullptr) {
+            countAllocation(size, caller);
+        }
+        return memory;
+    }
+
+    // SDL原来的分配函数，统计后转交给它们
+    SDL_malloc_func sdlMalloc = nullptr;
+    SDL_calloc_func sdlCalloc = nullptr;
+    SDL_realloc_func sdlRealloc = nullptr;
+    SDL_free_func sdlFree = nullptr;
+
+    void* SDLCALL trackedMalloc(size_t size)
+    {
+        void* memory = sdlMalloc(size);
+        if (memory != nullptr) {
+            countAllocation(size, ALLOC_CALLER);
+        }
+        return memory;
+    }
+
+    void* SDLCALL trackedCalloc(size_t count, size_t size)
+    {
+        void* memory = sdlCalloc(count, size);
+        if (memory != nullptr) {
+            countAllocation(count * size, ALLOC_CALLER);
+        }
+        return memory;
+    }
+
+    // 重新分配可能搬移内存，也算一次分配；大小为0时相当于释放，不计入
+    void* SDLCALL trackedRealloc(void* memory, size_t size)
+    {
+        void* result = sdlRealloc(memory, size);
+        if (result != nullptr && size > 0) {
+            countAllocation(size, ALLOC_CALLER);
+        }
+        return result;
+    }
+
+    void SDLCALL trackedFree(void* memory)
+    {
+        sdlFree(memory);
+    }
+#endif
+}
+
+#ifdef ALLOC_TRACKING
+// 替换全局分配函数；对齐分配仍使用标准库的实现，它们有各自对应的释放函数
+void* operator new(std::size_t size)
+{
+    void* memory = allocate(size, ALLOC_CALLER);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new[](std::size_t size)
+{
+    void* memory = allocate(size, ALLOC_CALLER);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate(size, ALLOC_CALLER);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate(size, ALLOC_CALLER);
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+#endif
+
+bool AllocTracker::isAvailable()
+{
+#ifdef ALLOC_TRACKING
+    return true;
+#else
+    return false;
+#endif
+}
+
+void AllocTracker::setThreadTracking(bool enabled)
+{
+#ifdef ALLOC_TRACKING_SITES
+    // 第一次取调用栈时会加载展开库，提前做掉，不算进第一帧
+    if (enabled) {
+        void* frame;
+        backtrace(&frame, 1);
+    }
+#endif
+    tracking = enabled;
+}
+
+void AllocTracker::hookSdlAllocations()
+{
+#ifdef ALLOC_TRACKING
+    if (sdlMalloc != nullptr) {
+        return;
+    }
+    SDL_GetOriginalMemoryFunctions(&sdlMalloc, &sdlCalloc, &sdlRealloc, &sdlFree);
+    if (!SDL_SetMemoryFunctions(trackedMalloc, trackedCalloc, trackedRealloc, trackedFree)) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Failed to hook SDL allocations: %s", SDL_GetError());
+    }
+#endif
+}
+
+AllocCounters AllocTracker::current()
+{
+    return counters;
+}
+
+const char* AllocTracker::enterZone(const char* zone)
+{
+    const char* previous = currentZone;
+    currentZone = zone;
+    return previous;
+}
+
+void AllocTracker::leaveZone(const char* previous)
+{
+    currentZone = previous;
+}
+
+void AllocTracker::reportSites(int count)
+{
+#ifdef ALLOC_TRACKING_SITES
+    // 输出过程本身的分配不计入
+    bool wasTracking = tracking;
+    tracking = false;
+
+    // 按第一个游戏代码的帧和区段合并调用栈
+    struct Report {
+        void* address;
+        const char* zone;
+        Uint64 count;
+        Uint64 bytes;
+    };
+    static Site copied[SITE_CAPACITY];
+    static Report reports[SITE_CAPACITY];
+    while (siteLock.test_and_set(std::memory_order_acquire)) {
+    }
+    std::copy(sites, sites + SITE_CAPACITY, copied);
+    siteLock.clear(std::memory_order_release);
+    size_t used = 0;
+    for (const Site& site : copied) {
+        if (site.depth > 0) {
+            reports[used++] = {callSite(site), site.zone, site.count, site.bytes};
+        }
+    }
+
+    auto byLocation = [](const Report& a, const Report& b) {
+        return a.address != b.address ? a.address < b.address : a.zone < b.zone;
+    };
+    std::sort(reports, reports + used, byLocation);
+    size_t merged = 0;
+    for (size_t i = 0; i < used; i++) {
+        if (merged > 0 && reports[merged - 1].address == reports[i].address && reports[merged - 1].zone == reports[i].zone) {
+            reports[merged - 1].count += reports[i].count;
+            reports[merged - 1].bytes += reports[i].bytes;
+        } else {
+            reports[merged++] = reports[i];
+        }
+    }
+    std::sort(reports, reports + merged, [](const Report& a, const Report& b) { return a.count > b.count; });
+
+    SDL_Log("%-20s %12s %14s  %s", "zone", "allocs", "bytes", "call site");
+    for (size_t i = 0; i < merged && i < static_cast<size_t>(count); i++) {
+        char location[512];
+        describeAddress(reports[i].address, location, sizeof(location));
+        SDL_Log("%-20s %12llu %14llu  %s", reports[i].zone != nullptr ? reports[i].zone : "-",
+                static_cast<unsigned long long>(reports[i].count), static_cast<unsigned long long>(reports[i].bytes), location);
+    }
+    tracking = wasTracking;
+#else
+    (void)count;
+    if (isAvailable()) {
+        SDL_Log("Allocation call sites are only recorded in debug builds");
+    }
+#endif
+}
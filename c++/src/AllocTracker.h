@@ -0,0 +1,54 @@
+#ifndef ALLOC_TRACKER_H
+#define ALLOC_TRACKER_H
+
+#include <SDL3/SDL.h>
+
+// 堆分配计数
+struct AllocCounters {
+    Uint64 count = 0; // 分配次数
+    Uint64 bytes = 0; // 分配的字节数
+};
+
+/**
+ * 堆分配统计（可选）
+ * 用CMake选项ENABLE_ALLOC_TRACKING编译时替换全局operator new并接管SDL_malloc，
+ * 统计开启了计数的线程（主线程）的分配次数和字节数；调试版本还按调用位置和计时区段汇总，
+ * 用于找出每帧的堆分配。未开启时所有函数都是空操作，没有任何开销
+ */
+class AllocTracker
+{
+public:
+    static bool isAvailable(); // 是否编译了分配统计
+
+    /**
+     * 开始或停止统计当前线程的分配
+     * 音频、存档等后台线程不开启，统计的只是游戏逻辑和渲染
+     */
+    static void setThreadTracking(bool enabled);
+
+    /**
+     * 让SDL及SDL_ttf、SDL_mixer、SDL_image经SDL_malloc的分配也计入统计
+     * 需在SDL_Init之前调用；之前由原分配函数得到的内存仍可正常释放
+     */
+    static void hookSdlAllocations();
+
+    static AllocCounters current(); // 当前线程开启统计以来的累计值
+
+    /**
+     * 进入计时区段，之后的分配在调用位置统计中记到该区段下
+     * @param zone 区段名（字符串常量）
+     * @return 之前的区段，离开时交给leaveZone
+     */
+    static const char* enterZone(const char* zone);
+    static void leaveZone(const char* previous);
+
+    /**
+     * 输出分配次数最多的调用位置（只有GCC/Clang编译的调试版本记录调用位置）
+     * 记录时保存一小段调用栈，输出时跳过标准库、容器分配器和SDL内部的帧，
+     * 位置是第一个游戏代码的帧，写成"模块+偏移 函数名"，可用 addr2line -f -C -i -e <模块> <偏移> 查到源代码行
+     * @param count 最多输出的条数
+     */
+    static void reportSites(int count);
+};
+
+#endif // ALLOC_TRACKER_H
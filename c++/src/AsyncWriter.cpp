@@ -0,0 +1,187 @@
+#include "AsyncWriter.h"
+#include <cstdio>
+#include <filesystem>
+#include <system_error>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+AsyncWriter::~AsyncWriter()
+{
+    shutdown();
+}
+
+void AsyncWriter::init()
+{
+    if (running) {
+        return;
+    }
+    stopping = false;
+    running = true;
+    writerThread = std::thread(&AsyncWriter::writerLoop, this);
+}
+
+void AsyncWriter::shutdown()
+{
+    if (!running) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueCondition.notify_one();
+    if (writerThread.joinable()) {
+        writerThread.join();
+    }
+    running = false;
+}
+
+void AsyncWriter::replaceFile(const std::string& path, std::vector<Uint8> data)
+{
+    Job job;
+    job.path = path;
+    job.data = std::move(data);
+    job.append = false;
+    enqueue(std::move(job));
+}
+
+void AsyncWriter::appendFile(const std::string& path, std::vector<Uint8> data)
+{
+    Job job;
+    job.path = path;
+    job.data = std::move(data);
+    job.append = true;
+    enqueue(std::move(job));
+}
+
+void AsyncWriter::enqueue(Job job)
+{
+    // 写入线程未启动时直接在当前线程写入
+    if (!running) {
+        if (job.append) {
+            appendToFile(job.path, job.data);
+        } else {
+            writeFileAtomic(job.path, job.data);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if (!job.append) {
+            // 同一文件的整体替换只需保留最新一次；其后已有追加任务时不能合并，否则顺序会被打乱
+            for (auto it = jobs.rbegin(); it != jobs.rend(); ++it) {
+                if (it->path != job.path) {
+                    continue;
+                }
+                if (!it->append) {
+                    it->data = std::move(job.data);
+                    return;
+                }
+                break;
+            }
+        }
+        jobs.push_back(std::move(job));
+    }
+    queueCondition.notify_one();
+}
+
+void AsyncWriter::flush()
+{
+    if (!running) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(queueMutex);
+    idleCondition.wait(lock, [this] { return jobs.empty() && !busy; });
+}
+
+void AsyncWriter::writerLoop()
+{
+    std::unique_lock<std::mutex> lock(queueMutex);
+    while (true) {
+        queueCondition.wait(lock, [this] { return stopping || !jobs.empty(); });
+        if (jobs.empty()) {
+            // 只有在队列写完后才退出
+            break;
+        }
+
+        Job job = std::move(jobs.front());
+        jobs.pop_front();
+        busy = true;
+        lock.unlock();
+
+        if (job.append) {
+            appendToFile(job.path, job.data);
+        } else {
+            writeFileAtomic(job.path, job.data);
+        }
+
+        lock.lock();
+        busy = false;
+        if (jobs.empty()) {
+            idleCondition.notify_all();
+        }
+    }
+    idleCondition.notify_all();
+}
+
+// 把文件缓冲区刷到磁盘，保证重命名之前数据已经落盘
+static bool syncFile(FILE* file)
+{
+    if (std::fflush(file) != 0) {
+        return false;
+    }
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+bool AsyncWriter::writeFileAtomic(const std::string& path, const std::vector<Uint8>& data)
+{
+    std::string tempPath = path + ".tmp";
+    FILE* file = std::fopen(tempPath.c_str(), "wb");
+    if (file == nullptr) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to open %s for writing", tempPath.c_str());
+        return false;
+    }
+
+    bool ok = data.empty() || std::fwrite(data.data(), 1, data.size(), file) == data.size();
+    ok = syncFile(file) && ok;
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to write %s", tempPath.c_str());
+        std::remove(tempPath.c_str());
+        return false;
+    }
+
+    // 重命名是原子操作：文件要么是旧内容，要么是完整的新内容
+    std::error_code error;
+    std::filesystem::rename(tempPath, path, error);
+    if (error) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to replace %s: %s", path.c_str(), error.message().c_str());
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool AsyncWriter::appendToFile(const std::string& path, const std::vector<Uint8>& data)
+{
+    FILE* file = std::fopen(path.c_str(), "ab");
+    if (file == nullptr) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to open %s for appending", path.c_str());
+        return false;
+    }
+    bool ok = data.empty() || std::fwrite(data.data(), 1, data.size(), file) == data.size();
+    ok = syncFile(file) && ok;
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to append to %s", path.c_str());
+    }
+    return ok;
+}
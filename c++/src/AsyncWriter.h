@@ -0,0 +1,72 @@
+#ifndef ASYNC_WRITER_H
+#define ASYNC_WRITER_H
+
+#include <SDL3/SDL.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * 后台文件写入线程
+ * 调用方只把数据交给队列，由后台线程完成磁盘写入；
+ * 整体替换的文件先写入临时文件再重命名，写入中途崩溃不会破坏旧文件
+ */
+class AsyncWriter
+{
+public:
+    AsyncWriter() = default;
+    ~AsyncWriter();
+    AsyncWriter(const AsyncWriter&) = delete;
+    AsyncWriter& operator=(const AsyncWriter&) = delete;
+
+    void init();     // 启动写入线程
+    void shutdown(); // 写完队列中剩余的数据后停止线程
+
+    /**
+     * 原子地替换整个文件（写临时文件 -> 刷盘 -> 重命名）
+     * 同一文件尚未写入的旧请求会被新请求覆盖
+     * @param path 目标文件路径
+     * @param data 文件内容
+     */
+    void replaceFile(const std::string& path, std::vector<Uint8> data);
+
+    /**
+     * 在文件末尾追加数据
+     * @param path 目标文件路径
+     * @param data 追加的内容
+     */
+    void appendFile(const std::string& path, std::vector<Uint8> data);
+
+    void flush(); // 阻塞直到队列中的数据全部写入磁盘
+
+    /**
+     * 在当前线程中原子地替换文件
+     * @return 写入成功返回true
+     */
+    static bool writeFileAtomic(const std::string& path, const std::vector<Uint8>& data);
+
+private:
+    struct Job {
+        std::string path;
+        std::vector<Uint8> data;
+        bool append = false;
+    };
+
+    std::thread writerThread;
+    std::mutex queueMutex;
+    std::condition_variable queueCondition; // 有新任务或需要退出
+    std::condition_variable idleCondition;  // 队列已清空
+    std::deque<Job> jobs;
+    bool busy = false;     // 写入线程正在处理任务
+    bool stopping = false;
+    bool running = false;
+
+    void writerLoop();
+    void enqueue(Job job);
+    static bool appendToFile(const std::string& path, const std::vector<Uint8>& data);
+};
+
+#endif // ASYNC_WRITER_H
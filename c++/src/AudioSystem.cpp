@@ -0,0 +1,238 @@
+#include "AudioSystem.h"
+
+AudioSystem::~AudioSystem()
+{
+    clean();
+}
+
+void AudioSystem::init()
+{
+    if (running) {
+        return;
+    }
+
+    // 音频线程启动前在当前线程完成资源加载
+    sfxManager.init();
+    musicManager.init();
+    musicManager.setCrossfadeTime(crossfadeMs);
+
+    wakeSemaphore = SDL_CreateSemaphore(0);
+    if (wakeSemaphore == nullptr) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to create audio semaphore: %s", SDL_GetError());
+        return;
+    }
+    running = true;
+    audioThread = std::thread(&AudioSystem::threadLoop, this);
+}
+
+void AudioSystem::clean()
+{
+    if (!running) {
+        return;
+    }
+
+    // 停止音频线程，剩余命令不再执行
+    running = false;
+    SDL_SignalSemaphore(wakeSemaphore);
+    if (audioThread.joinable()) {
+        audioThread.join();
+    }
+    SDL_DestroySemaphore(wakeSemaphore);
+    wakeSemaphore = nullptr;
+
+    musicManager.clean();
+    sfxManager.clean();
+}
+
+void AudioSystem::postControl(const AudioCommand& command)
+{
+    // 音效给控制命令留了空间，队列仍然满说明音频线程卡住了，合并而不是等待；
+    // 已有合并的状态时也不再入队，否则这条命令会先于更早的合并状态执行
+    if (overflowMask.load(std::memory_order_acquire) != 0 || !commands.push(command)) {
+        coalesceControl(command);
+    }
+    wake();
+}
+
+void AudioSystem::coalesceControl(const AudioCommand& command)
+{
+    Uint32 bit = 0;
+    switch (command.type) {
+        case AudioCommandType::PlayMusic:
+            overflowMusic.store((command.value << 1) | (command.extra != 0 ? 1 : 0), std::memory_order_relaxed);
+            bit = OVERFLOW_MUSIC;
+            break;
+        case AudioCommandType::StopMusic:
+            overflowMusic.store(-1, std::memory_order_relaxed);
+            bit = OVERFLOW_MUSIC;
+            break;
+        case AudioCommandType::SetMusicVolume:
+            overflowMusicVolume.store(command.value, std::memory_order_relaxed);
+            bit = OVERFLOW_MUSIC_VOLUME;
+            break;
+        case AudioCommandType::SetSfxVolume:
+            overflowSfxVolume.store(command.value, std::memory_order_relaxed);
+            bit = OVERFLOW_SFX_VOLUME;
+            break;
+        case AudioCommandType::SetCrossfade:
+            overflowCrossfade.store(command.value, std::memory_order_relaxed);
+            bit = OVERFLOW_CROSSFADE;
+            break;
+        case AudioCommandType::EndFrame:
+            overflowFrameTime.store(command.time, std::memory_order_relaxed);
+            bit = OVERFLOW_END_FRAME;
+            break;
+        case AudioCommandType::PreloadMusic: // 预加载只是提前准备，丢弃不影响播放
+        case AudioCommandType::PlaySfx:
+            droppedCommands++;
+            return;
+    }
+    // 值先写入，音频线程取走位之后一定能读到
+    if (overflowMask.fetch_or(bit, std::memory_order_release) == 0) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Audio command queue is full, coalescing control commands");
+    }
+    coalescedCommands++;
+}
+
+void AudioSystem::wake()
+{
+    // 与threadLoop中的检查配对：先写入命令再读sleeping，两边至少有一方看到对方的写入
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping.load(std::memory_order_relaxed) && sleeping.exchange(false, std::memory_order_acq_rel)) {
+        SDL_SignalSemaphore(wakeSemaphore);
+    }
+}
+
+void AudioSystem::endFrame(Uint64 now)
+{
+    // 合并后的音效，空间不足时丢弃音效而不是控制命令
+    int dropped = 0;
+    for (int i = 0; pendingSfx != 0; i++) {
+        Uint32 bit = 1u << i;
+        if (!(pendingSfx & bit)) {
+            continue;
+        }
+        pendingSfx &= ~bit;
+        if (commands.freeSpace() <= CONTROL_RESERVE || !commands.push({AudioCommandType::PlaySfx, i})) {
+            dropped++;
+        }
+    }
+    if (dropped > 0) {
+        droppedCommands += dropped;
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Audio command queue is full, dropped %d sound effects", dropped);
+    }
+
+    AudioCommand command;
+    command.type = AudioCommandType::EndFrame;
+    command.time = now;
+    postControl(command);
+}
+
+void AudioSystem::playMusic(MusicId music, bool forceRestart)
+{
+    requestedMusic = music;
+    postControl({AudioCommandType::PlayMusic, static_cast<int>(music), forceRestart ? 1 : 0});
+}
+
+void AudioSystem::stopMusic()
+{
+    requestedMusic = MusicId::None;
+    postControl({AudioCommandType::StopMusic});
+}
+
+void AudioSystem::setCrossfadeTime(int ms)
+{
+    crossfadeMs = ms < 0 ? 0 : ms;
+    postControl({AudioCommandType::SetCrossfade, crossfadeMs});
+}
+
+void AudioSystem::threadLoop()
+{
+    while (running.load(std::memory_order_acquire)) {
+        AudioCommand command;
+        while (commands.pop(command)) {
+            execute(command);
+        }
+        applyCoalesced();
+        musicManager.update();
+
+        // 先声明要等待再检查一次，检查之后投递的命令一定会发信号
+        sleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!commands.empty() || overflowMask.load(std::memory_order_relaxed) != 0 ||
+            !running.load(std::memory_order_relaxed)) {
+            if (sleeping.exchange(false, std::memory_order_acq_rel)) {
+                continue;
+            }
+            // 生产者已经取走标记并发了信号，下面的等待会立即返回
+        }
+        // 音乐切换进行中时定期醒来推进淡出和加载状态
+        if (musicManager.isSwitching()) {
+            SDL_WaitSemaphoreTimeout(wakeSemaphore, 10);
+        } else {
+            SDL_WaitSemaphore(wakeSemaphore);
+        }
+        sleeping.store(false, std::memory_order_relaxed);
+    }
+}
+
+void AudioSystem::applyCoalesced()
+{
+    Uint32 mask = overflowMask.exchange(0, std::memory_order_acquire);
+    if (mask == 0) {
+        return;
+    }
+    if (mask & OVERFLOW_MUSIC) {
+        int music = overflowMusic.load(std::memory_order_relaxed);
+        if (music < 0) {
+            execute({AudioCommandType::StopMusic});
+        } else {
+            execute({AudioCommandType::PlayMusic, music >> 1, music & 1});
+        }
+    }
+    if (mask & OVERFLOW_MUSIC_VOLUME) {
+        execute({AudioCommandType::SetMusicVolume, overflowMusicVolume.load(std::memory_order_relaxed)});
+    }
+    if (mask & OVERFLOW_SFX_VOLUME) {
+        execute({AudioCommandType::SetSfxVolume, overflowSfxVolume.load(std::memory_order_relaxed)});
+    }
+    if (mask & OVERFLOW_CROSSFADE) {
+        execute({AudioCommandType::SetCrossfade, overflowCrossfade.load(std::memory_order_relaxed)});
+    }
+    if (mask & OVERFLOW_END_FRAME) {
+        AudioCommand command;
+        command.type = AudioCommandType::EndFrame;
+        command.time = overflowFrameTime.load(std::memory_order_relaxed);
+        execute(command);
+    }
+}
+
+void AudioSystem::execute(const AudioCommand& command)
+{
+    switch (command.type) {
+        case AudioCommandType::PlaySfx:
+            sfxManager.play(static_cast<SoundId>(command.value));
+            break;
+        case AudioCommandType::EndFrame:
+            sfxManager.flush(command.time);
+            break;
+        case AudioCommandType::PlayMusic:
+            musicManager.play(static_cast<MusicId>(command.value), command.extra != 0);
+            break;
+        case AudioCommandType::PreloadMusic:
+            musicManager.preload(static_cast<MusicId>(command.value));
+            break;
+        case AudioCommandType::StopMusic:
+            musicManager.stop();
+            break;
+        case AudioCommandType::SetMusicVolume:
+            Mix_VolumeMusic(command.value);
+            break;
+        case AudioCommandType::SetSfxVolume:
+            Mix_Volume(-1, command.value);
+            break;
+        case AudioCommandType::SetCrossfade:
+            musicManager.setCrossfadeTime(command.value);
+            break;
+    }
+}
@@ -0,0 +1,110 @@
+#ifndef AUDIO_SYSTEM_H
+#define AUDIO_SYSTEM_H
+
+#include "MusicManager.h"
+#include "SfxManager.h"
+#include "SpscQueue.h"
+#include <SDL3/SDL.h>
+#include <atomic>
+#include <thread>
+
+// 音频命令类型
+enum class AudioCommandType : Uint8 {
+    PlaySfx,        // 播放音效，value为SoundId
+    EndFrame,       // 一帧结束，派发本帧音效，time为当前时间
+    PlayMusic,      // 切换背景音乐，value为MusicId，extra为是否强制重启
+    PreloadMusic,   // 预加载背景音乐，value为MusicId
+    StopMusic,      // 停止背景音乐
+    SetMusicVolume, // 设置音乐音量，value为0-MIX_MAX_VOLUME
+    SetSfxVolume,   // 设置音效音量，value为0-MIX_MAX_VOLUME
+    SetCrossfade    // 设置音乐切换时长，value为毫秒
+};
+
+// 音频命令，可平凡复制以便放入无锁队列
+struct AudioCommand {
+    AudioCommandType type = AudioCommandType::EndFrame;
+    int value = 0;
+    int extra = 0;
+    Uint64 time = 0;
+};
+
+/**
+ * 音频系统
+ * 游戏逻辑（唯一的生产者线程）只向无锁队列投递命令，立即返回，投递路径上没有锁也不会等待；
+ * 独立的音频线程取出命令并调用SDL_mixer，游戏逻辑不会被混音器的内部锁阻塞
+ * 音效在生产者一侧按帧合并，每帧每种音效最多一条命令，在endFrame时一起投递；
+ * 队列保留一部分空间给控制命令（音乐、音量、帧结束）。音频线程卡住导致队列仍然满时，
+ * 控制命令合并为最新的状态（音乐请求、音量、帧结束时间），由音频线程取完队列后执行
+ */
+class AudioSystem
+{
+public:
+    AudioSystem() = default;
+    ~AudioSystem();
+    AudioSystem(const AudioSystem&) = delete;
+    AudioSystem& operator=(const AudioSystem&) = delete;
+
+    void init();  // 加载音效并启动音频线程（需在Mix_OpenAudio之后调用）
+    void clean(); // 停止音频线程并释放资源
+
+    // 以下方法只能由同一个线程调用（单生产者）
+    void playSfx(SoundId sound) { pendingSfx |= 1u << static_cast<int>(sound); } // 本帧内重复请求只播放一次
+    void endFrame(Uint64 now); // 投递本帧音效并通知音频线程派发
+    void playMusic(MusicId music, bool forceRestart = false);
+    void preloadMusic(MusicId music) { postControl({AudioCommandType::PreloadMusic, static_cast<int>(music)}); }
+    void stopMusic();
+    void setMusicVolume(int volume) { postControl({AudioCommandType::SetMusicVolume, volume}); }
+    void setSfxVolume(int volume) { postControl({AudioCommandType::SetSfxVolume, volume}); }
+    void setCrossfadeTime(int ms);
+
+    MusicId getRequestedMusic() const { return requestedMusic; } // 最近一次请求播放的曲目
+    int getCrossfadeTime() const { return crossfadeMs; }         // 音乐切换时长（毫秒）
+    size_t getDroppedCommands() const { return droppedCommands; } // 队列满时丢弃的音效和预加载命令数
+    size_t getCoalescedCommands() const { return coalescedCommands; } // 队列满时合并的控制命令数
+
+private:
+    static constexpr size_t CONTROL_RESERVE = 64; // 音效不能占用的队列空间，留给控制命令
+    static_assert(static_cast<int>(SoundId::Count) <= 32, "pendingSfx holds one bit per SoundId");
+
+    SpscQueue<AudioCommand, 1024> commands; // 游戏逻辑 -> 音频线程
+    MusicManager musicManager;              // 只在音频线程中访问
+    SfxManager sfxManager;                  // 只在音频线程中访问
+
+    std::thread audioThread;
+    std::atomic<bool> running{false};
+
+    // 唤醒音频线程：音频线程取空队列后先置sleeping再等待信号量，
+    // 生产者只在sleeping为true时（队列由空变为非空）发信号
+    SDL_Semaphore* wakeSemaphore = nullptr;
+    std::atomic<bool> sleeping{false};
+
+    // 队列满时合并的控制状态，overflowMask中的位表示对应的值有待执行；
+    // 有待执行的合并状态时，之后的控制命令也合并到这里，保持先后顺序
+    static constexpr Uint32 OVERFLOW_MUSIC = 1u << 0;
+    static constexpr Uint32 OVERFLOW_MUSIC_VOLUME = 1u << 1;
+    static constexpr Uint32 OVERFLOW_SFX_VOLUME = 1u << 2;
+    static constexpr Uint32 OVERFLOW_CROSSFADE = 1u << 3;
+    static constexpr Uint32 OVERFLOW_END_FRAME = 1u << 4;
+    std::atomic<Uint32> overflowMask{0};
+    std::atomic<int> overflowMusic{0};        // 最近的音乐请求：(MusicId << 1) | 是否强制重启，-1为停止
+    std::atomic<int> overflowMusicVolume{0};
+    std::atomic<int> overflowSfxVolume{0};
+    std::atomic<int> overflowCrossfade{0};
+    std::atomic<Uint64> overflowFrameTime{0}; // 最近一次帧结束的时间
+
+    // 生产者线程记录的状态
+    MusicId requestedMusic = MusicId::None;
+    int crossfadeMs = 1000;
+    size_t droppedCommands = 0;
+    size_t coalescedCommands = 0;
+    Uint32 pendingSfx = 0; // 本帧请求的音效，每个SoundId一位
+
+    void postControl(const AudioCommand& command);     // 投递控制命令，队列满时合并，不会等待
+    void coalesceControl(const AudioCommand& command); // 把控制命令合并到overflow状态
+    void wake();                                       // 音频线程在等待时唤醒它
+    void threadLoop();                                 // 音频线程主循环
+    void applyCoalesced();                             // 在音频线程中执行合并的控制状态
+    void execute(const AudioCommand& command); // 在音频线程中执行命令
+};
+
+#endif // AUDIO_SYSTEM_H
@@ -0,0 +1,44 @@
+#include "BenchReport.h"
+#include <cstdio>
+#include <fstream>
+
+namespace
+{
+    // 测试名只含ASCII，这里只需转义引号和反斜杠
+    std::string escapeJson(const std::string& text)
+    {
+        std::string out;
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                out.push_back('\\');
+            }
+            out.push_back(c);
+        }
+        return out;
+    }
+}
+
+bool BenchReport::writeJson(const std::string& path, const std::string& suite, const std::vector<BenchResult>& results)
+{
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to open %s for writing", path.c_str());
+        return false;
+    }
+
+    file << "{\n  \"version\": 1,\n  \"suite\": \"" << escapeJson(suite) << "\",\n  \"results\": [";
+    char line[512];
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& result = results[i];
+        std::snprintf(line, sizeof(line),
+                      "%s\n    {\"name\": \"%s\", \"ns_per_op\": %.3f, \"min_ns_per_op\": %.3f, \"max_ns_per_op\": %.3f, "
+                      "\"items_per_sec\": %.3f, \"iterations\": %llu, \"samples\": %d}",
+                      i == 0 ? "" : ",",
+                      escapeJson(result.name).c_str(),
+                      result.nsPerOp, result.minNsPerOp, result.maxNsPerOp, result.itemsPerSec,
+                      static_cast<unsigned long long>(result.iterations), result.samples);
+        file << line;
+    }
+    file << "\n  ]\n}\n";
+    return file.good();
+}
@@ -0,0 +1,33 @@
+#ifndef BENCH_REPORT_H
+#define BENCH_REPORT_H
+
+#include <SDL3/SDL.h>
+#include <string>
+#include <vector>
+
+// 一个基准测试的结果
+struct BenchResult {
+    std::string name;          // 测试名，例如 "ecs/churn/player_shot"
+    double nsPerOp = 0;        // 每次操作耗时（各轮采样的中位数）
+    double minNsPerOp = 0;     // 最快一轮
+    double maxNsPerOp = 0;     // 最慢一轮
+    double itemsPerSec = 0;    // 每秒处理的元素数（子弹数、碰撞检测次数等）
+    Uint64 iterations = 0;     // 每轮的操作次数
+    int samples = 0;           // 采样轮数
+};
+
+/**
+ * 基准测试结果的JSON格式，bench、无窗口运行的游戏和bench_compare共用
+ * {"version": 1, "suite": "...", "results": [{"name": ..., "ns_per_op": ..., ...}]}
+ */
+namespace BenchReport
+{
+    /**
+     * 把结果写成JSON
+     * @param suite 结果集名称（"micro"、"sim"）
+     * @return 写入成功时返回true
+     */
+    bool writeJson(const std::string& path, const std::string& suite, const std::vector<BenchResult>& results);
+}
+
+#endif // BENCH_REPORT_H
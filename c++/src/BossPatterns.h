@@ -0,0 +1,45 @@
+#ifndef BOSS_PATTERNS_H
+#define BOSS_PATTERNS_H
+
+#include "BulletPattern.h"
+
+// Boss的发射器表，弹幕和子发射器按下标引用
+inline constexpr BulletEmitterDef BOSS_EMITTERS[] = {
+    // 0: 圆形弹幕，16颗，随时间慢慢旋转
+    {EmitterShape::Ring, 16, 0, 0, 1.0f, -1, 200, 0, 200},
+    // 1: 螺旋弹幕，8颗，旋转速度是圆形弹幕的3倍
+    {EmitterShape::Ring, 8, 0, 0, 3.0f, -1, 200, 0, 200},
+    // 2: 扇形弹幕，12颗，60度
+    {EmitterShape::Fan, 12, SDL_PI_F / 3.0f, 0, 0, -1, 200, 0, 200},
+    // 3: 花形弹幕：6个方向反向旋转，每个方向展开一个小扇形（4号）
+    {EmitterShape::Ring, 6, 0, 0, -1.5f, 4, 0, 0, 0},
+    // 4: 花瓣，3颗，先慢后快
+    {EmitterShape::Fan, 3, 0.35f, 0, 0, -1, 60, 240, 320},
+};
+constexpr int BOSS_EMITTER_COUNT = static_cast<int>(sizeof(BOSS_EMITTERS) / sizeof(BOSS_EMITTERS[0]));
+
+inline constexpr BulletPatternDef BOSS_PATTERNS[] = {
+    {0, false, true},  // 圆形
+    {1, false, false}, // 螺旋
+    {2, true, false},  // 朝玩家的扇形
+    {3, false, true},  // 花形
+};
+constexpr int BOSS_PATTERN_COUNT = static_cast<int>(sizeof(BOSS_PATTERNS) / sizeof(BOSS_PATTERNS[0]));
+
+// Boss的攻击阶段，按顺序循环，跳过当前难度不启用的阶段
+struct BossPhaseDef {
+    int pattern;       // BOSS_PATTERNS的下标
+    Uint32 duration;   // 持续时间（毫秒）
+    int minDifficulty; // 难度不低于该值时才启用：0-简单，1-普通，2-困难
+};
+
+inline constexpr BossPhaseDef BOSS_PHASES[] = {
+    {0, 5000, 0},
+    {1, 5000, 0},
+    {2, 5000, 0},
+    {3, 5000, 2}, // 花形弹幕只在困难难度出现
+};
+constexpr int BOSS_PHASE_COUNT = static_cast<int>(sizeof(BOSS_PHASES) / sizeof(BOSS_PHASES[0]));
+static_assert(BOSS_PHASES[0].minDifficulty == 0, "the first boss phase must be enabled on every difficulty");
+
+#endif // BOSS_PATTERNS_H
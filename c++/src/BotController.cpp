@@ -0,0 +1,233 @@
+#include "BotController.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr int LOOKAHEAD_STEPS = 8;          // 预测的采样次数
+    constexpr float STEP_SECONDS = 4.0f / 60.0f; // 每次采样间隔（约4个逻辑帧）
+    constexpr float THREAT_RADIUS = 450.0f;     // 只考虑这个距离内的威胁
+    constexpr float SAFETY_MARGIN = 6.0f;       // 玩家碰撞框向外扩大的距离
+    constexpr float BOOST_FACTOR = 1.3f;        // 与场景中的加速倍率一致
+
+    bool overlaps(const SDL_FRect& a, const SDL_FRect& b)
+    {
+        return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h;
+    }
+
+    float centerY(const SDL_FRect& rect)
+    {
+        return rect.y + rect.h / 2;
+    }
+
+    WeaponUpgrade parseUpgrade(const std::string& name, bool& ok)
+    {
+        ok = true;
+        if (name == "damage") return WeaponUpgrade::DAMAGE_UP;
+        if (name == "rate") return WeaponUpgrade::SPEED_UP;
+        if (name == "bounce") return WeaponUpgrade::BOUNCE_UP;
+        if (name == "split") return WeaponUpgrade::SPLIT_UP;
+        if (name == "pierce") return WeaponUpgrade::PIERCE_UP;
+        ok = false;
+        return WeaponUpgrade::DAMAGE_UP;
+    }
+}
+
+void BotView::clear()
+{
+    controllable = false;
+    facingLeft = false;
+    canTurn = false;
+    threats.clear();
+    targets.clear();
+    pickups.clear();
+    upgrades.clear();
+}
+
+std::unique_ptr<BotController> BotController::create(const std::string& kind, const std::string& upgradePolicy)
+{
+    std::unique_ptr<BotController> bot;
+    if (kind == "dodge") {
+        bot = std::make_unique<DodgeBot>();
+    } else if (kind == "sweep") {
+        bot = std::make_unique<SweepBot>();
+    } else {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unknown bot: %s (expected dodge or sweep)", kind.c_str());
+        return nullptr;
+    }
+
+    // 指定一种升级时优先选它，其余按默认顺序
+    std::vector<WeaponUpgrade> defaultOrder = {
+        WeaponUpgrade::DAMAGE_UP, WeaponUpgrade::SPEED_UP, WeaponUpgrade::SPLIT_UP,
+        WeaponUpgrade::PIERCE_UP, WeaponUpgrade::BOUNCE_UP
+    };
+    bool ok = true;
+    if (upgradePolicy == "cycle") {
+        bot->upgradePreference = defaultOrder;
+        bot->cyclePreference = true;
+    } else if (upgradePolicy != "first") {
+        WeaponUpgrade preferred = parseUpgrade(upgradePolicy, ok);
+        if (!ok) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unknown upgrade policy: %s", upgradePolicy.c_str());
+            return nullptr;
+        }
+        bot->upgradePreference.push_back(preferred);
+        for (WeaponUpgrade upgrade : defaultOrder) {
+            if (upgrade != preferred) {
+                bot->upgradePreference.push_back(upgrade);
+            }
+        }
+    }
+    return bot;
+}
+
+int BotController::chooseUpgrade(const std::vector<WeaponUpgrade>& options)
+{
+    for (size_t rank = 0; rank < upgradePreference.size(); rank++) {
+        for (size_t i = 0; i < options.size(); i++) {
+            if (options[i] == upgradePreference[rank]) {
+                if (cyclePreference) {
+                    // 选中的一项移到末尾，下次优先其他升级
+                    WeaponUpgrade chosen = upgradePreference[rank];
+                    upgradePreference.erase(upgradePreference.begin() + static_cast<long>(rank));
+                    upgradePreference.push_back(chosen);
+                }
+                return static_cast<int>(i);
+            }
+        }
+    }
+    return 0;
+}
+
+PlayerInput SweepBot::decide(const BotView& view, Uint64 tick)
+{
+    PlayerInput input;
+    input.keys |= (tick / 90) % 2 == 0 ? INPUT_UP : INPUT_DOWN;
+    input.keys |= (tick / 150) % 2 == 0 ? INPUT_RIGHT : INPUT_LEFT;
+    if ((tick / 45) % 4 == 0) {
+        input.keys |= INPUT_BOOST;
+    }
+    if (!view.upgrades.empty()) {
+        input.upgradeChoice = static_cast<Sint8>(chooseUpgrade(view.upgrades));
+    }
+    return input;
+}
+
+PlayerInput DodgeBot::decide(const BotView& view, Uint64)
+{
+    PlayerInput input;
+    if (!view.upgrades.empty()) {
+        input.upgradeChoice = static_cast<Sint8>(chooseUpgrade(view.upgrades));
+    }
+    if (!view.controllable) {
+        return input;
+    }
+
+    const SDL_FRect& player = view.player;
+    float playerX = player.x + player.w / 2;
+    float playerY = player.y + player.h / 2;
+
+    nearby.clear();
+    for (const BotThreat& threat : view.threats) {
+        float dx = threat.rect.x + threat.rect.w / 2 - playerX;
+        float dy = threat.rect.y + threat.rect.h / 2 - playerY;
+        if (dx * dx + dy * dy < THREAT_RADIUS * THREAT_RADIUS) {
+            nearby.push_back(&threat);
+        }
+    }
+
+    // 瞄准：与玩家垂直距离最近、且在射击方向前方的目标
+    const SDL_FRect* target = nullptr;
+    float bestDistance = 0;
+    for (const SDL_FRect& candidate : view.targets) {
+        bool inFront = candidate.x + candidate.w > player.x + player.w;
+        if (!inFront) {
+            continue;
+        }
+        float distance = std::fabs(centerY(candidate) - playerY);
+        if (target == nullptr || distance < bestDistance) {
+            target = &candidate;
+            bestDistance = distance;
+        }
+    }
+    const SDL_FPoint* pickup = nullptr;
+    float pickupDistance = 250.0f;
+    for (const SDL_FPoint& candidate : view.pickups) {
+        float distance = std::hypot(candidate.x - playerX, candidate.y - playerY);
+        if (distance < pickupDistance) {
+            pickup = &candidate;
+            pickupDistance = distance;
+        }
+    }
+
+    float homeX = view.fieldWidth * 0.12f;
+    float bestCost = 0;
+    Uint8 bestKeys = 0;
+    bool first = true;
+    for (int boost = 0; boost < 2; boost++) {
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                if (boost && dx == 0 && dy == 0) {
+                    continue;
+                }
+                float speed = view.playerSpeed * (boost ? BOOST_FACTOR : 1.0f);
+                float cost = 0;
+
+                // 按当前方向持续移动时，越早发生的碰撞代价越高
+                SDL_FRect future = player;
+                for (int step = 1; step <= LOOKAHEAD_STEPS; step++) {
+                    float t = step * STEP_SECONDS;
+                    future.x = std::max(0.0f, std::min(view.fieldWidth - player.w, player.x + dx * speed * t));
+                    future.y = std::max(0.0f, std::min(view.fieldHeight - player.h, player.y + dy * speed * t));
+                    SDL_FRect padded = {future.x - SAFETY_MARGIN, future.y - SAFETY_MARGIN,
+                                        future.w + 2 * SAFETY_MARGIN, future.h + 2 * SAFETY_MARGIN};
+                    for (const BotThreat* threat : nearby) {
+                        SDL_FRect moved = threat->rect;
+                        moved.x += threat->velocity.x * t;
+                        moved.y += threat->velocity.y * t;
+                        if (overlaps(padded, moved)) {
+                            cost += 1000.0f / step;
+                        }
+                    }
+                }
+
+                // 一次采样后的位置用于位置偏好
+                float t = STEP_SECONDS;
+                float nextX = std::max(0.0f, std::min(view.fieldWidth - player.w, player.x + dx * speed * t));
+                float nextY = std::max(0.0f, std::min(view.fieldHeight - player.h, player.y + dy * speed * t));
+                float nextCenterY = nextY + player.h / 2;
+                if (target != nullptr) {
+                    cost += std::fabs(nextCenterY - centerY(*target)) * 0.5f;
+                }
+                if (pickup != nullptr) {
+                    cost += std::hypot(pickup->x - (nextX + player.w / 2), pickup->y - nextCenterY) * 0.3f;
+                }
+                cost += std::fabs(nextX - homeX) * 0.2f;
+                // 贴着上下边缘容易被逼进死角
+                if (nextY < 30.0f || nextY > view.fieldHeight - player.h - 30.0f) {
+                    cost += 40.0f;
+                }
+                // 主场景中向左移动会转身，背对敌人无法射击
+                bool facesLeft = dx < 0 || (dx == 0 && view.facingLeft);
+                if (view.canTurn && facesLeft) {
+                    cost += 200.0f;
+                }
+                // 加速只在有意义时使用，同等情况下不加速
+                cost += boost * 1.0f;
+
+                if (first || cost < bestCost) {
+                    first = false;
+                    bestCost = cost;
+                    bestKeys = 0;
+                    if (dy < 0) bestKeys |= INPUT_UP;
+                    if (dy > 0) bestKeys |= INPUT_DOWN;
+                    if (dx < 0) bestKeys |= INPUT_LEFT;
+                    if (dx > 0) bestKeys |= INPUT_RIGHT;
+                    if (boost) bestKeys |= INPUT_BOOST;
+                }
+            }
+        }
+    }
+    input.keys = bestKeys;
+    return input;
+}
@@ -0,0 +1,85 @@
+#ifndef BOT_CONTROLLER_H
+#define BOT_CONTROLLER_H
+
+#include "Input.h"
+#include "Object.h"
+#include <SDL3/SDL.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+// 会伤害玩家的物体（敌方子弹、敌人机体）
+struct BotThreat {
+    SDL_FRect rect = {};        // 当前位置和大小
+    SDL_FPoint velocity = {};   // 速度（像素/秒）
+};
+
+// 场景提供给机器人的信息，每个逻辑帧由当前场景填写
+struct BotView {
+    bool controllable = false;          // 当前场景有可操作的玩家
+    SDL_FRect player = {};              // 玩家位置和大小
+    float playerSpeed = 0;              // 玩家移动速度（像素/秒，不含加速）
+    bool facingLeft = false;            // 玩家是否朝左射击
+    bool canTurn = false;               // 左右移动是否会改变射击方向
+    float fieldWidth = 0;               // 场地宽度
+    float fieldHeight = 0;              // 场地高度
+    std::vector<BotThreat> threats;     // 需要躲避的物体
+    std::vector<SDL_FRect> targets;     // 射击目标（敌人、Boss）
+    std::vector<SDL_FPoint> pickups;    // 道具中心点
+    std::vector<WeaponUpgrade> upgrades; // 正在等待选择的武器升级
+
+    void clear(); // 清空内容，保留容器容量
+};
+
+/**
+ * 自动操作玩家的机器人
+ * 只根据场景状态和逻辑帧序号决定输入，同一种子下每次运行完全相同
+ */
+class BotController
+{
+public:
+    virtual ~BotController() = default;
+
+    /**
+     * 决定本逻辑帧的输入
+     * @param view 当前场景状态
+     * @param tick 本局逻辑帧序号
+     */
+    virtual PlayerInput decide(const BotView& view, Uint64 tick) = 0;
+
+    /**
+     * 创建机器人
+     * @param kind "dodge"（躲避子弹并瞄准敌人）或 "sweep"（固定的来回移动）
+     * @param upgradePolicy 升级选择策略：first、cycle、damage、rate、bounce、split、pierce
+     * @return 名称无法识别时返回空指针
+     */
+    static std::unique_ptr<BotController> create(const std::string& kind, const std::string& upgradePolicy);
+
+protected:
+    std::vector<WeaponUpgrade> upgradePreference; // 升级偏好顺序，为空表示总选第一个
+    bool cyclePreference = false;                 // 每次升级后把最偏好的一项移到末尾
+    int chooseUpgrade(const std::vector<WeaponUpgrade>& options); // 按策略选出升级序号
+};
+
+// 固定的来回移动，不看场景状态，用于稳定的负载
+class SweepBot : public BotController
+{
+public:
+    PlayerInput decide(const BotView& view, Uint64 tick) override;
+};
+
+/**
+ * 躲避型机器人
+ * 对几个候选移动方向预测未来约半秒内与子弹和敌人的碰撞，
+ * 选出代价最小的方向；没有危险时对准最近的敌人并靠近道具
+ */
+class DodgeBot : public BotController
+{
+public:
+    PlayerInput decide(const BotView& view, Uint64 tick) override;
+
+private:
+    std::vector<const BotThreat*> nearby; // 本帧需要考虑的威胁（复用容量）
+};
+
+#endif // BOT_CONTROLLER_H
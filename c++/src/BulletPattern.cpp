@@ -0,0 +1,102 @@
+#include "BulletPattern.h"
+#include "EcsSystems.h"
+#include "FastMath.h"
+
+namespace
+{
+    constexpr int MAX_EMITTER_DEPTH = 4; // 嵌套层数上限，防止发射器表中出现循环
+
+    bool expandEmitter(const BulletEmitterDef* emitters, int emitterCount, int index, float baseAngle, float spin,
+                       int depth, BulletProgram& program)
+    {
+        if (index < 0 || index >= emitterCount) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Bullet emitter %d out of range", index);
+            return false;
+        }
+        if (depth >= MAX_EMITTER_DEPTH) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Bullet emitters nested too deep at %d", index);
+            return false;
+        }
+        const BulletEmitterDef& emitter = emitters[index];
+        float totalSpin = spin + emitter.spin;
+        for (int i = 0; i < emitter.count; i++) {
+            float local = 0;
+            if (emitter.shape == EmitterShape::Ring) {
+                local = 2.0f * SDL_PI_F * i / emitter.count;
+            } else if (emitter.count > 1) {
+                local = -emitter.arc / 2 + (emitter.arc * i / (emitter.count - 1));
+            }
+            float angle = baseAngle + emitter.offset + local;
+
+            if (emitter.child >= 0) {
+                if (!expandEmitter(emitters, emitterCount, emitter.child, angle, totalSpin, depth + 1, program)) {
+                    return false;
+                }
+                continue;
+            }
+
+            // 与上一个方向的旋转倍数相同时并入同一组
+            if (program.groups.empty() || program.groups.back().spin != totalSpin) {
+                BulletProgram::Group group;
+                group.spin = totalSpin;
+                group.first = program.shots.size();
+                program.groups.push_back(group);
+            }
+            BulletProgram::Shot shot;
+            fastSinCos(angle, shot.direction.y, shot.direction.x);
+            shot.angle = angle;
+            shot.speed = emitter.speed;
+            shot.acceleration = emitter.acceleration;
+            shot.maxSpeed = emitter.maxSpeed;
+            program.shots.push_back(shot);
+            program.groups.back().count++;
+        }
+        return true;
+    }
+}
+
+bool compileBulletPattern(const BulletPatternDef& pattern, const BulletEmitterDef* emitters, int emitterCount,
+                          BulletProgram& program)
+{
+    program = BulletProgram();
+    program.aimed = pattern.aimed;
+    program.sound = pattern.sound;
+    return expandEmitter(emitters, emitterCount, pattern.emitter, 0.0f, 0.0f, 0, program);
+}
+
+size_t fireBulletProgram(EcsWorld& world, const BulletProgram& program, const BulletVolley& volley)
+{
+    size_t total = program.shots.size() < volley.capacity ? program.shots.size() : volley.capacity;
+    if (total == 0) {
+        return 0;
+    }
+    world.reserve<Transform, Velocity, Acceleration, Bounds, Sprite, Hitbox, Damage, EnemyShot>(total);
+
+    Transform transform;
+    transform.position = {volley.center.x - volley.width / 2, volley.center.y - volley.height / 2};
+    transform.width = volley.width;
+    transform.height = volley.height;
+    Sprite sprite;
+    sprite.texture = volley.texture;
+    sprite.rotated = true;
+    float baseAngle = program.aimed ? volley.aimAngle : 0.0f;
+
+    size_t spawned = 0;
+    for (const BulletProgram::Group& group : program.groups) {
+        // 每组旋转一次，组内的方向按复数乘法旋转
+        float rotation = baseAngle + group.spin * volley.time;
+        float c, s;
+        fastSinCos(rotation, s, c);
+        for (size_t i = group.first; i < group.first + group.count && spawned < total; i++, spawned++) {
+            const BulletProgram::Shot& shot = program.shots[i];
+            Velocity velocity;
+            velocity.direction = {shot.direction.x * c - shot.direction.y * s,
+                                  shot.direction.x * s + shot.direction.y * c};
+            velocity.speed = shot.speed;
+            sprite.rotation = (shot.angle + rotation) * 180.0f / SDL_PI_F;
+            world.create(transform, velocity, Acceleration{shot.acceleration, shot.maxSpeed}, Bounds{32}, sprite,
+                         Hitbox{volley.hitboxScale}, Damage{volley.damage}, EnemyShot{});
+        }
+    }
+    return spawned;
+}
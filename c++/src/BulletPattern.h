@@ -0,0 +1,91 @@
+#ifndef BULLET_PATTERN_H
+#define BULLET_PATTERN_H
+
+#include "Ecs.h"
+#include <SDL3/SDL.h>
+#include <vector>
+
+// 发射器的形状
+enum class EmitterShape : Uint8 {
+    Ring, // 均匀分布在一整圈上
+    Fan   // 均匀分布在以基准方向为中心的扇形上
+};
+
+/**
+ * 发射器：在基准方向周围产生count个方向
+ * 没有子发射器时每个方向发射一颗子弹，有子发射器时每个方向作为子发射器的基准方向（嵌套弹幕）
+ */
+struct BulletEmitterDef {
+    EmitterShape shape;
+    int count;
+    float arc;          // 扇形的总角度（弧度），Ring不使用
+    float offset;       // 相对基准方向的固定偏转（弧度）
+    float spin;         // 随时间参数旋转的倍数（弧度/单位时间参数），子发射器的旋转在父发射器之上叠加
+    int child;          // 子发射器在表中的下标，-1表示直接发射子弹
+    // 子弹速度曲线：从speed开始按acceleration变化，到maxSpeed后保持
+    float speed;        // 初速度（像素/秒）
+    float acceleration; // 加速度（像素/秒²），可以为负
+    float maxSpeed;     // 加速度为正时的上限，为负时的下限
+};
+
+// 一种弹幕：从根发射器展开
+struct BulletPatternDef {
+    int emitter;  // 根发射器在表中的下标
+    bool aimed;   // 基准方向朝向玩家，否则为0（向右）
+    bool sound;   // 发射时播放音效
+};
+
+/**
+ * 编译后的弹幕
+ * 嵌套的发射器在加载时展开成一张方向表，发射时每组只需一次cos/sin旋转整张表
+ * 旋转倍数相同的连续方向为一组
+ */
+struct BulletProgram {
+    struct Group {
+        float spin = 0;    // 这一组的总旋转倍数
+        size_t first = 0;  // 第一个方向的下标
+        size_t count = 0;
+    };
+    struct Shot {
+        SDL_FPoint direction = {1, 0}; // 未旋转的单位方向
+        float angle = 0;               // 对应的角度（弧度），用于子弹贴图的朝向
+        float speed = 0;
+        float acceleration = 0;
+        float maxSpeed = 0;
+    };
+    std::vector<Group> groups;
+    std::vector<Shot> shots;
+    bool aimed = false;
+    bool sound = false;
+};
+
+// 一次发射的参数
+struct BulletVolley {
+    SDL_FPoint center = {0, 0};       // 发射点
+    float aimAngle = 0;               // 朝向玩家的角度（弧度），aimed为true时使用
+    float time = 0;                   // 驱动spin的时间参数
+    SDL_Texture* texture = nullptr;   // 子弹贴图
+    float width = 0, height = 0;      // 子弹显示尺寸
+    float hitboxScale = 1.0f;         // 碰撞框比例
+    int damage = 1;
+    size_t capacity = 0;              // 本次最多生成的子弹数
+};
+
+/**
+ * 把弹幕定义展开成方向表
+ * @param pattern 弹幕定义
+ * @param emitters 发射器表，pattern和子发射器按下标引用
+ * @param emitterCount 发射器表的长度
+ * @param program 输出
+ * @return 下标越界或嵌套过深时返回false
+ */
+bool compileBulletPattern(const BulletPatternDef& pattern, const BulletEmitterDef* emitters, int emitterCount,
+                          BulletProgram& program);
+
+/**
+ * 按编译后的弹幕一次生成一批敌人子弹（EnemyShot实体）
+ * @return 实际生成的子弹数，超过volley.capacity的部分不生成
+ */
+size_t fireBulletProgram(EcsWorld& world, const BulletProgram& program, const BulletVolley& volley);
+
+#endif // BULLET_PATTERN_H
@@ -0,0 +1,169 @@
+#include "DesyncChecker.h"
+#include "SaveStore.h"
+#include <cstring>
+
+namespace
+{
+    constexpr Uint8 MAGIC[4] = {'D', 'Q', 'S', 'H'};
+    constexpr Uint32 VERSION = 1;
+    constexpr size_t HEADER_SIZE = 9; // 魔数 + 版本 + 详细模式
+
+    void writeU16(std::vector<Uint8>& out, Uint16 value)
+    {
+        out.push_back(static_cast<Uint8>(value));
+        out.push_back(static_cast<Uint8>(value >> 8));
+    }
+
+    void writeU32(std::vector<Uint8>& out, Uint32 value)
+    {
+        for (int i = 0; i < 4; i++) {
+            out.push_back(static_cast<Uint8>(value >> (i * 8)));
+        }
+    }
+
+    Uint16 getU16(const Uint8* in)
+    {
+        return static_cast<Uint16>(in[0] | (in[1] << 8));
+    }
+
+    Uint32 getU32(const Uint8* in)
+    {
+        Uint32 value = 0;
+        for (int i = 0; i < 4; i++) {
+            value |= static_cast<Uint32>(in[i]) << (i * 8);
+        }
+        return value;
+    }
+}
+
+std::string DesyncChecker::getPathForReplay(const std::string& replayPath)
+{
+    const std::string extension = ".dqr";
+    if (replayPath.size() > extension.size() &&
+        replayPath.compare(replayPath.size() - extension.size(), extension.size(), extension) == 0) {
+        return replayPath.substr(0, replayPath.size() - extension.size()) + ".dqh";
+    }
+    return replayPath + ".dqh";
+}
+
+void DesyncChecker::beginRecording(bool detailMode)
+{
+    detail = detailMode;
+    data.assign(MAGIC, MAGIC + 4);
+    writeU32(data, VERSION);
+    data.push_back(detail ? 1 : 0);
+}
+
+void DesyncChecker::record(const TickHash& hash)
+{
+    writeU32(data, hash.tick);
+    for (int i = 0; i < HASH_CATEGORY_COUNT; i++) {
+        writeU16(data, hash.counts[i]);
+        writeU32(data, hash.hashes[i]);
+        if (detail) {
+            for (Uint32 entity : hash.entities[i]) {
+                writeU32(data, entity);
+            }
+        }
+    }
+}
+
+bool DesyncChecker::load(const std::string& path)
+{
+    if (!SaveStore::readFile(path, data)) {
+        return false;
+    }
+    if (data.size() < HEADER_SIZE || std::memcmp(data.data(), MAGIC, 4) != 0 || getU32(data.data() + 4) != VERSION) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "State hash log %s has an invalid header", path.c_str());
+        data.clear();
+        return false;
+    }
+    detail = data[8] != 0;
+    readPos = HEADER_SIZE;
+    diverged = false;
+    exhausted = false;
+    checkedTicks = 0;
+    return true;
+}
+
+bool DesyncChecker::readTick(TickHash& expected)
+{
+    if (readPos + 4 > data.size()) {
+        return false;
+    }
+    expected.tick = getU32(data.data() + readPos);
+    readPos += 4;
+    for (int i = 0; i < HASH_CATEGORY_COUNT; i++) {
+        if (readPos + 6 > data.size()) {
+            return false;
+        }
+        expected.counts[i] = getU16(data.data() + readPos);
+        expected.hashes[i] = getU32(data.data() + readPos + 2);
+        readPos += 6;
+        expected.entities[i].clear();
+        if (detail) {
+            if (readPos + expected.counts[i] * 4 > data.size()) {
+                return false;
+            }
+            for (Uint16 n = 0; n < expected.counts[i]; n++) {
+                expected.entities[i].push_back(getU32(data.data() + readPos));
+                readPos += 4;
+            }
+        }
+    }
+    return true;
+}
+
+bool DesyncChecker::check(const TickHash& hash)
+{
+    if (diverged || exhausted) {
+        return !diverged;
+    }
+
+    TickHash expected;
+    if (!readTick(expected)) {
+        exhausted = true;
+        SDL_Log("State hash log ended after %u ticks", checkedTicks);
+        return true;
+    }
+
+    if (expected.tick != hash.tick) {
+        diverged = true;
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Desync: expected tick %u but simulation is at tick %u", expected.tick, hash.tick);
+        return false;
+    }
+    for (int i = 0; i < HASH_CATEGORY_COUNT; i++) {
+        if (expected.counts[i] != hash.counts[i] || expected.hashes[i] != hash.hashes[i]) {
+            diverged = true;
+            reportDivergence(expected, hash, i);
+            return false;
+        }
+    }
+    checkedTicks++;
+    return true;
+}
+
+void DesyncChecker::reportDivergence(const TickHash& expected, const TickHash& actual, int category)
+{
+    const char* name = StateHasher::getCategoryName(static_cast<HashCategory>(category));
+    if (expected.counts[category] != actual.counts[category]) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Desync at tick %u: %s count %u, expected %u",
+                     actual.tick, name, actual.counts[category], expected.counts[category]);
+        return;
+    }
+
+    // 两边都有实体哈希时找出第一个不同的实体
+    const auto& expectedEntities = expected.entities[category];
+    const auto& actualEntities = actual.entities[category];
+    if (detail && expectedEntities.size() == actualEntities.size()) {
+        for (size_t i = 0; i < expectedEntities.size(); i++) {
+            if (expectedEntities[i] != actualEntities[i]) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Desync at tick %u: %s #%zu differs (hash %08x, expected %08x)",
+                             actual.tick, name, i, actualEntities[i], expectedEntities[i]);
+                return;
+            }
+        }
+    }
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Desync at tick %u: %s differs (hash %08x, expected %08x)",
+                 actual.tick, name, actual.hashes[category], expected.hashes[category]);
+}
@@ -0,0 +1,58 @@
+#ifndef DESYNC_CHECKER_H
+#define DESYNC_CHECKER_H
+
+#include "StateHasher.h"
+#include <SDL3/SDL.h>
+#include <string>
+#include <vector>
+
+/**
+ * 状态哈希日志和不一致检查
+ * 录制时每个逻辑帧追加一条哈希，回放时逐帧与日志比较，
+ * 报告第一个不一致的逻辑帧和分类；日志带实体哈希（详细模式）时还能定位到具体实体。
+ * 文件格式（小端序）："DQSH" | u32 版本 | u8 详细模式 | 逐帧记录
+ * 每帧: u32 帧序号，每个分类 u16 实体数 | u32 哈希 | [实体数 x u32 实体哈希]
+ */
+class DesyncChecker
+{
+public:
+    /**
+     * 开始录制新的哈希日志
+     * @param detail 是否保存每个实体的哈希
+     */
+    void beginRecording(bool detail);
+    void record(const TickHash& hash);         // 追加一帧
+    const std::vector<Uint8>& getData() const { return data; } // 日志文件内容
+
+    /**
+     * 读取哈希日志用于检查
+     * @return 文件存在且文件头正确时返回true
+     */
+    bool load(const std::string& path);
+
+    /**
+     * 与日志中的下一帧比较，只报告第一次不一致
+     * @param hash 当前逻辑帧的哈希
+     * @return 一致或日志已结束时返回true
+     */
+    bool check(const TickHash& hash);
+
+    bool isDetail() const { return detail; }
+    bool hasDiverged() const { return diverged; }
+    Uint32 getCheckedTicks() const { return checkedTicks; }
+
+    static std::string getPathForReplay(const std::string& replayPath); // 录像对应的哈希日志路径
+
+private:
+    std::vector<Uint8> data;
+    size_t readPos = 0;
+    bool detail = false;
+    bool diverged = false;
+    bool exhausted = false;
+    Uint32 checkedTicks = 0;
+
+    bool readTick(TickHash& expected); // 从日志读取下一帧
+    void reportDivergence(const TickHash& expected, const TickHash& actual, int category);
+};
+
+#endif // DESYNC_CHECKER_H
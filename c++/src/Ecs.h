@@ -0,0 +1,332 @@
+#ifndef ECS_H
+#define ECS_H
+
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+// 实体句柄；实体销毁后代数增加，旧句柄随之失效
+struct Entity {
+    Uint32 index = 0;
+    Uint32 generation = 0;
+};
+
+using ComponentMask = Uint64;
+constexpr int ECS_MAX_COMPONENTS = 64;
+
+namespace ecs_detail
+{
+    inline int nextComponentId()
+    {
+        static std::atomic<int> counter{0};
+        return counter.fetch_add(1);
+    }
+
+    // 每种组件类型第一次用到时分配一个编号
+    template <typename T>
+    int componentId()
+    {
+        static const int id = nextComponentId();
+        SDL_assert(id < ECS_MAX_COMPONENTS);
+        return id;
+    }
+
+    template <typename... Ts>
+    ComponentMask maskOf()
+    {
+        return (ComponentMask(0) | ... | (ComponentMask(1) << componentId<Ts>()));
+    }
+}
+
+/**
+ * 组件组合相同的一组实体
+ * 每种组件连续存放在自己的数组中（SoA），遍历时按顺序访问内存
+ */
+struct EcsArchetype {
+    struct Column {
+        int component = 0;
+        size_t elementSize = 0;
+        std::vector<unsigned char> data;
+    };
+
+    ComponentMask mask = 0;
+    std::vector<Entity> entities;
+    std::vector<Uint8> alive;   // 0表示已销毁，等待flush移除
+    size_t deadCount = 0;
+    std::vector<Column> columns;
+    int columnOf[ECS_MAX_COMPONENTS]; // 组件编号对应的列，-1表示没有该组件
+
+    EcsArchetype() { std::fill(columnOf, columnOf + ECS_MAX_COMPONENTS, -1); }
+
+    template <typename T>
+    T* column()
+    {
+        return reinterpret_cast<T*>(columns[columnOf[ecs_detail::componentId<T>()]].data.data());
+    }
+};
+
+/**
+ * 按组件组合（原型）存储实体的简单ECS
+ * 组件必须可以平凡复制；实体按创建顺序存放，销毁后flush时保持其余实体的相对顺序，
+ * 遍历顺序因此与创建顺序一致，不影响确定性回放
+ */
+class EcsWorld
+{
+public:
+    // 创建实体，组件按值复制
+    template <typename... Ts>
+    Entity create(const Ts&... components)
+    {
+        static_assert(sizeof...(Ts) > 0, "entity needs at least one component");
+        static_assert((std::is_trivially_copyable<Ts>::value && ...), "components must be trivially copyable");
+        static_assert(((alignof(Ts) <= alignof(std::max_align_t)) && ...), "component alignment is too large");
+
+        Uint32 archetypeIndex = findArchetype<Ts...>();
+        EcsArchetype& archetype = archetypes[archetypeIndex];
+
+        Entity entity;
+        if (!freeIndices.empty()) {
+            entity.index = freeIndices.back();
+            freeIndices.pop_back();
+        } else {
+            entity.index = static_cast<Uint32>(records.size());
+            records.emplace_back();
+        }
+        Record& record = records[entity.index];
+        entity.generation = record.generation;
+        record.archetype = archetypeIndex;
+        record.row = static_cast<Uint32>(archetype.entities.size());
+        record.alive = true;
+
+        archetype.entities.push_back(entity);
+        archetype.alive.push_back(1);
+        (appendComponent(archetype, components), ...);
+        return entity;
+    }
+
+    // 为Ts...组合的实体预留extra个位置，批量创建时不再逐个扩容
+    template <typename... Ts>
+    void reserve(size_t extra)
+    {
+        EcsArchetype& archetype = archetypes[findArchetype<Ts...>()];
+        size_t target = archetype.entities.size() + extra;
+        archetype.entities.reserve(target);
+        archetype.alive.reserve(target);
+        for (EcsArchetype::Column& column : archetype.columns) {
+            column.data.reserve(target * column.elementSize);
+        }
+        if (freeIndices.size() < extra) {
+            records.reserve(records.size() + extra - freeIndices.size());
+        }
+    }
+
+    /**
+     * 销毁实体
+     * 之后的遍历不再访问它，存储空间在flush时回收；可以在遍历的回调中调用
+     */
+    void destroy(Entity entity)
+    {
+        if (!isAlive(entity)) {
+            return;
+        }
+        Record& record = records[entity.index];
+        record.alive = false;
+        record.generation++;
+        EcsArchetype& archetype = archetypes[record.archetype];
+        archetype.alive[record.row] = 0;
+        archetype.deadCount++;
+    }
+
+    bool isAlive(Entity entity) const
+    {
+        return entity.index < records.size() && records[entity.index].alive &&
+               records[entity.index].generation == entity.generation;
+    }
+
+    // 取实体的组件，实体已销毁或没有该组件时为空
+    template <typename T>
+    T* get(Entity entity)
+    {
+        if (!isAlive(entity)) {
+            return nullptr;
+        }
+        const Record& record = records[entity.index];
+        EcsArchetype& archetype = archetypes[record.archetype];
+        if (archetype.columnOf[ecs_detail::componentId<T>()] < 0) {
+            return nullptr;
+        }
+        return archetype.column<T>() + record.row;
+    }
+
+    template <typename T>
+    const T* get(Entity entity) const
+    {
+        return const_cast<EcsWorld*>(this)->get<T>(entity);
+    }
+
+    /**
+     * 按创建顺序遍历同时拥有Ts...组件的实体，fn(Entity, Ts&...)
+     * 回调中可以创建和销毁实体；本次遍历不会访问新创建的实体，
+     * 但创建同类实体后，回调参数中的组件引用可能失效
+     */
+    template <typename... Ts, typename F>
+    void each(F&& fn)
+    {
+        ComponentMask mask = ecs_detail::maskOf<Ts...>();
+        for (size_t a = 0; a < archetypes.size(); a++) {
+            if ((archetypes[a].mask & mask) != mask) {
+                continue;
+            }
+            EcsArchetype* archetype = &archetypes[a];
+            size_t count = archetype->entities.size();
+            size_t size = count;
+            std::tuple<Ts*...> columns(archetype->column<Ts>()...);
+            for (size_t row = 0; row < count; row++) {
+                if (!archetype->alive[row]) {
+                    continue;
+                }
+                std::apply([&](Ts*... data) { fn(archetype->entities[row], data[row]...); }, columns);
+                // 回调中新建了原型或同类实体时存储可能已经搬移，重新取各列的地址
+                if (archetypes.data() + a != archetype || archetype->entities.size() != size) {
+                    archetype = &archetypes[a];
+                    size = archetype->entities.size();
+                    columns = std::tuple<Ts*...>(archetype->column<Ts>()...);
+                }
+            }
+        }
+    }
+
+    template <typename... Ts, typename F>
+    void each(F&& fn) const
+    {
+        const_cast<EcsWorld*>(this)->each<Ts...>([&](Entity entity, Ts&... components) {
+            fn(entity, static_cast<const Ts&>(components)...);
+        });
+    }
+
+    // 同时拥有Ts...组件的存活实体数
+    template <typename... Ts>
+    size_t count() const
+    {
+        ComponentMask mask = ecs_detail::maskOf<Ts...>();
+        size_t total = 0;
+        for (const EcsArchetype& archetype : archetypes) {
+            if ((archetype.mask & mask) == mask) {
+                total += archetype.entities.size() - archetype.deadCount;
+            }
+        }
+        return total;
+    }
+
+    // 移除已销毁的实体，其余实体保持原来的顺序
+    void flush()
+    {
+        for (EcsArchetype& archetype : archetypes) {
+            if (archetype.deadCount == 0) {
+                continue;
+            }
+            size_t write = 0;
+            for (size_t row = 0; row < archetype.entities.size(); row++) {
+                if (!archetype.alive[row]) {
+                    freeIndices.push_back(archetype.entities[row].index);
+                    continue;
+                }
+                if (write != row) {
+                    archetype.entities[write] = archetype.entities[row];
+                    for (EcsArchetype::Column& column : archetype.columns) {
+                        std::memcpy(column.data.data() + write * column.elementSize,
+                                    column.data.data() + row * column.elementSize, column.elementSize);
+                    }
+                    records[archetype.entities[write].index].row = static_cast<Uint32>(write);
+                }
+                archetype.alive[write] = 1;
+                write++;
+            }
+            archetype.entities.resize(write);
+            archetype.alive.resize(write);
+            for (EcsArchetype::Column& column : archetype.columns) {
+                column.data.resize(write * column.elementSize);
+            }
+            archetype.deadCount = 0;
+        }
+    }
+
+    /**
+     * 删除所有实体
+     * 实体下标的代数照常增加，清空前的句柄在下标重新使用后也不会变得有效；
+     * 原型和已分配的容量保留
+     */
+    void clear()
+    {
+        freeIndices.clear();
+        for (size_t i = records.size(); i-- > 0;) {
+            Record& record = records[i];
+            if (record.alive) {
+                record.alive = false;
+                record.generation++;
+            }
+            freeIndices.push_back(static_cast<Uint32>(i));
+        }
+        for (EcsArchetype& archetype : archetypes) {
+            archetype.entities.clear();
+            archetype.alive.clear();
+            archetype.deadCount = 0;
+            for (EcsArchetype::Column& column : archetype.columns) {
+                column.data.clear();
+            }
+        }
+    }
+
+private:
+    struct Record {
+        Uint32 archetype = 0;
+        Uint32 row = 0;
+        Uint32 generation = 0;
+        bool alive = false;
+    };
+    std::vector<EcsArchetype> archetypes;
+    std::vector<Record> records;     // 按实体下标索引
+    std::vector<Uint32> freeIndices; // 可重新使用的实体下标
+
+    template <typename... Ts>
+    Uint32 findArchetype()
+    {
+        ComponentMask mask = ecs_detail::maskOf<Ts...>();
+        for (size_t i = 0; i < archetypes.size(); i++) {
+            if (archetypes[i].mask == mask) {
+                return static_cast<Uint32>(i);
+            }
+        }
+        EcsArchetype archetype;
+        archetype.mask = mask;
+        (addColumn<Ts>(archetype), ...);
+        archetypes.push_back(std::move(archetype));
+        return static_cast<Uint32>(archetypes.size() - 1);
+    }
+
+    template <typename T>
+    static void addColumn(EcsArchetype& archetype)
+    {
+        EcsArchetype::Column column;
+        column.component = ecs_detail::componentId<T>();
+        column.elementSize = sizeof(T);
+        archetype.columnOf[column.component] = static_cast<int>(archetype.columns.size());
+        archetype.columns.push_back(std::move(column));
+    }
+
+    template <typename T>
+    static void appendComponent(EcsArchetype& archetype, const T& component)
+    {
+        std::vector<unsigned char>& data = archetype.columns[archetype.columnOf[ecs_detail::componentId<T>()]].data;
+        size_t offset = data.size();
+        data.resize(offset + sizeof(T));
+        std::memcpy(data.data() + offset, &component, sizeof(T));
+    }
+};
+
+#endif // ECS_H
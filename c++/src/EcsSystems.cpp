@@ -0,0 +1,94 @@
+#include "EcsSystems.h"
+#include <algorithm>
+
+void accelerationSystem(EcsWorld& world, float deltaTime)
+{
+    world.each<Acceleration, Velocity>([deltaTime](Entity, Acceleration& acceleration, Velocity& velocity) {
+        if (acceleration.rate > 0) {
+            velocity.speed = std::min(velocity.speed + acceleration.rate * deltaTime, acceleration.limit);
+        } else if (acceleration.rate < 0) {
+            velocity.speed = std::max(velocity.speed + acceleration.rate * deltaTime, acceleration.limit);
+        }
+    });
+}
+
+void boundsSystem(EcsWorld& world, float fieldWidth, float fieldHeight)
+{
+    world.each<Transform, Bounds>([&](Entity entity, Transform& transform, Bounds& bounds) {
+        const SDL_FPoint& position = transform.position;
+        if (position.x < -bounds.margin || position.x > fieldWidth + bounds.margin ||
+            position.y < -bounds.margin || position.y > fieldHeight + bounds.margin) {
+            world.destroy(entity);
+        }
+    });
+}
+
+void animationSystem(EcsWorld& world, Uint64 now)
+{
+    world.each<SpriteAnimation>([&](Entity entity, SpriteAnimation& animation) {
+        animation.currentFrame = static_cast<int>((now - animation.startTime) * animation.fps / 1000);
+        if (animation.loop) {
+            animation.currentFrame %= animation.frameCount;
+        } else if (animation.currentFrame >= animation.frameCount) {
+            world.destroy(entity);
+        }
+    });
+}
+
+void renderSystem(EcsWorld& world, SDL_Renderer* renderer, RenderLayer layer)
+{
+    world.each<Transform, Sprite>([&](Entity entity, Transform& transform, Sprite& sprite) {
+        if (sprite.layer != layer) {
+            return;
+        }
+        SDL_FRect dst = {transform.position.x, transform.position.y, transform.width, transform.height};
+        SDL_FRect src;
+        const SDL_FRect* source = nullptr;
+        if (const SpriteAnimation* animation = world.get<SpriteAnimation>(entity)) {
+            src = {animation->currentFrame * animation->frameWidth, 0, animation->frameWidth, animation->frameHeight};
+            source = &src;
+        }
+        if (sprite.rotated) {
+            SDL_RenderTextureRotated(renderer, sprite.texture, source, &dst, sprite.rotation, NULL, SDL_FLIP_NONE);
+        } else {
+            SDL_RenderTexture(renderer, sprite.texture, source, &dst);
+        }
+    });
+}
+
+Entity spawnExplosion(EcsWorld& world, const Explosion& explosionTemplate, SDL_FPoint center, Uint32 startTime)
+{
+    Transform transform;
+    transform.position = {center.x - explosionTemplate.width / 2, center.y - explosionTemplate.height / 2};
+    transform.width = explosionTemplate.width;
+    transform.height = explosionTemplate.height;
+    Sprite sprite;
+    sprite.texture = explosionTemplate.texture;
+    sprite.layer = RenderLayer::Effects;
+    SpriteAnimation animation;
+    animation.frameWidth = explosionTemplate.frameSize;
+    animation.frameHeight = explosionTemplate.frameSize;
+    animation.startTime = startTime;
+    animation.fps = explosionTemplate.FPS;
+    animation.frameCount = explosionTemplate.totlaFrame;
+    return world.create(transform, sprite, animation, Effect{});
+}
+
+Entity spawnPlayerShot(EcsWorld& world, const ProjectilePlayer& shotTemplate, SDL_FPoint position, SDL_FPoint direction,
+                       int damage, int maxBounces)
+{
+    Transform transform;
+    transform.position = position;
+    transform.width = shotTemplate.width;
+    transform.height = shotTemplate.height;
+    Velocity velocity;
+    velocity.direction = direction;
+    velocity.speed = static_cast<float>(shotTemplate.speed);
+    Sprite sprite;
+    sprite.texture = shotTemplate.texture;
+    sprite.layer = RenderLayer::PlayerShots;
+    PlayerShot shot;
+    shot.damage = damage;
+    shot.maxBounces = maxBounces;
+    return world.create(transform, velocity, sprite, shot);
+}
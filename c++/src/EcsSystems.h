@@ -0,0 +1,271 @@
+#ifndef ECS_SYSTEMS_H
+#define ECS_SYSTEMS_H
+
+#include "Ecs.h"
+#include "HitSet.h"
+#include "Object.h"
+#include <SDL3/SDL.h>
+
+// 绘制顺序分层，场景在各自的位置绘制每一层
+enum class RenderLayer : Uint8 {
+    Boss,        // Boss机体
+    Enemies,     // 敌人机体
+    PlayerShots, // 玩家子弹
+    Shots,       // 敌人和Boss的子弹
+    Items,       // 道具
+    Effects      // 爆炸等特效
+};
+
+// 位置和显示尺寸（position为左上角）
+struct Transform {
+    SDL_FPoint position = {0, 0};
+    float width = 0, height = 0;
+};
+
+// 匀速直线运动
+struct Velocity {
+    SDL_FPoint direction = {0, 0}; // 单位方向
+    float speed = 0;               // 每秒移动的像素数
+};
+
+// 速度随时间变化，到limit后保持（rate为负时limit是下限）
+struct Acceleration {
+    float rate = 0;   // 每秒速度变化量
+    float limit = 0;
+};
+
+// 离开场地超过margin像素后销毁
+struct Bounds {
+    float margin = 32;
+};
+
+struct Sprite {
+    SDL_Texture* texture = nullptr;
+    float rotation = 0;            // 旋转角度（度）
+    bool rotated = false;          // 是否按rotation旋转绘制
+    RenderLayer layer = RenderLayer::Shots;
+};
+
+// 横排帧动画，不循环的播放完后销毁实体
+struct SpriteAnimation {
+    float frameWidth = 0, frameHeight = 0; // 纹理中单帧的大小
+    Uint32 startTime = 0;                  // 开始时间（模拟时间，毫秒）
+    Uint32 fps = 10;
+    int frameCount = 1;
+    int currentFrame = 0;
+    bool loop = false;                     // 循环播放（如金币）
+};
+
+// 碰撞框：贴图按scale缩小并保持居中
+struct Hitbox {
+    float scale = 1.0f;
+};
+
+// 击中玩家时的伤害
+struct Damage {
+    int amount = 1;
+};
+
+// 玩家子弹
+struct PlayerShot {
+    int damage = 1;
+    int bounceCount = 0;  // 已反弹次数
+    int maxBounces = 0;   // 最大反弹次数
+    HitSet hitEnemies;    // 已击中的敌人编号（防止穿透子弹帧伤）
+};
+
+// 可以拾取的道具
+struct Pickup {
+    ItemType type = ItemType::Life;
+    int bounceCount = 3;  // 剩余的屏幕边缘反弹次数
+};
+
+// 敌人的移动方式（EnemyMotion）各对应一种组件，移动方式相同的敌人在同一个原型中，
+// 每种移动只遍历自己的原型；除沿路径移动的敌人外都带Velocity，由moveSystem<Enemy>向左移动
+
+// 向左并上下摆动（EnemyMotion::Wave）
+struct EnemyDrift {
+    float moveTimer = 0; // 摆动计时
+};
+
+// 向左并旋转（EnemyMotion::Spin），角度存放在Sprite::rotation
+struct EnemySpin {};
+
+// 沿烘焙的曲线路径移动（EnemyMotion::Path），位置只由走过的距离决定
+struct EnemyPath {
+    float moveTimer = 0;        // 沿路径移动的时间
+    Uint8 path = 0;             // ENEMY_PATHS的下标
+    SDL_FPoint origin = {0, 0}; // 生成位置，路径的起点
+};
+
+// 标签
+struct EnemyShot {}; // 敌人或Boss发射的子弹
+struct Effect {};    // 不参与游戏逻辑的特效
+
+void accelerationSystem(EcsWorld& world, float deltaTime); // 按加速度改变速度
+void boundsSystem(EcsWorld& world, float fieldWidth, float fieldHeight); // 销毁离开场地的实体
+void animationSystem(EcsWorld& world, Uint64 now); // 推进帧动画，播放完的实体销毁
+void renderSystem(EcsWorld& world, SDL_Renderer* renderer, RenderLayer layer); // 绘制一层精灵
+
+/**
+ * 按速度移动同时拥有Filter...组件的实体
+ * 各类实体的移动在一帧中的不同时刻进行，例如moveSystem<EnemyShot>只移动敌人子弹
+ */
+template <typename... Filter>
+void moveSystem(EcsWorld& world, float deltaTime)
+{
+    world.each<Transform, Velocity, Filter...>([deltaTime](Entity, Transform& transform, Velocity& velocity, const Filter&...) {
+        transform.position.x += velocity.direction.x * velocity.speed * deltaTime;
+        transform.position.y += velocity.direction.y * velocity.speed * deltaTime;
+    });
+}
+
+inline SDL_FRect hitboxRect(const Transform& transform, const Hitbox& hitbox)
+{
+    float width = transform.width * hitbox.scale;
+    float height = transform.height * hitbox.scale;
+    return {transform.position.x + (transform.width - width) / 2,
+            transform.position.y + (transform.height - height) / 2, width, height};
+}
+
+/**
+ * 碰撞检测：对碰撞框与target相交的每个实体调用onHit(Entity, Transform&, Damage&)
+ * 按实体创建顺序检测，回调中可以销毁实体
+ */
+template <typename F>
+void collisionSystem(EcsWorld& world, const SDL_FRect& target, F&& onHit)
+{
+    world.each<Transform, Hitbox, Damage>([&](Entity entity, Transform& transform, Hitbox& hitbox, Damage& damage) {
+        SDL_FRect rect = hitboxRect(transform, hitbox);
+        if (SDL_HasRectIntersectionFloat(&rect, &target)) {
+            onHit(entity, transform, damage);
+        }
+    });
+}
+
+/**
+ * 一颗玩家子弹与所有敌人的碰撞检测，击中的敌人扣除子弹伤害
+ * Pierce为false时击中第一个敌人就返回，由调用者删除子弹；
+ * 为true时子弹穿透，记录击中过的敌人，同一颗子弹对每个敌人只造成一次伤害
+ * @param shotRect 子弹的矩形
+ * @return 本次击中的敌人数
+ */
+template <bool Pierce>
+int collidePlayerShot(EcsWorld& world, PlayerShot& shot, const SDL_FRect& shotRect)
+{
+    int hits = 0;
+    world.each<Enemy, Transform>([&](Entity, Enemy& enemy, Transform& transform) {
+        if (!Pierce && hits > 0) {
+            return;
+        }
+        SDL_FRect enemyRect = {transform.position.x, transform.position.y, transform.width, transform.height};
+        if (!SDL_HasRectIntersectionFloat(&enemyRect, &shotRect)) {
+            return;
+        }
+        if constexpr (Pierce) {
+            // 检查这颗子弹是否已经击中过这个敌人（防止穿透子弹帧伤）
+            if (shot.hitEnemies.contains(enemy.id)) {
+                return;
+            }
+            shot.hitEnemies.insert(enemy.id);
+        }
+        enemy.currentHealth -= shot.damage;
+        hits++;
+    });
+    return hits;
+}
+
+/**
+ * 玩家子弹的移动、边界处理和与敌人的碰撞，按武器特性在编译期特化，循环内不判断武器类型
+ * Bounce-子弹碰到场地边缘时反弹，超过最大反弹次数后删除；否则碰到边缘就删除
+ * Pierce-子弹穿透敌人；否则击中第一个敌人后删除
+ * @param bouncedTexture 反弹后换用的纹理，为空时保持原来的纹理
+ * @return 本帧击中敌人的次数
+ */
+template <bool Bounce, bool Pierce>
+int playerShotSystem(EcsWorld& world, float deltaTime, float fieldWidth, float fieldHeight, SDL_Texture* bouncedTexture)
+{
+    const float margin = 32; // 子弹超出屏幕外边界的距离
+    int hits = 0;
+    moveSystem<PlayerShot>(world, deltaTime);
+    world.each<PlayerShot, Transform, Velocity, Sprite>([&](Entity entity, PlayerShot& shot, Transform& transform,
+                                                            Velocity& velocity, Sprite& sprite) {
+        SDL_FPoint& position = transform.position;
+        SDL_FPoint& direction = velocity.direction;
+        bool shouldDelete = false;
+        if constexpr (Bounce) {
+            // 上下边界弹射
+            if (position.y <= 0 || position.y >= fieldHeight - transform.height) {
+                if (shot.bounceCount < shot.maxBounces) {
+                    direction.y = -direction.y; // 垂直方向反弹
+                    shot.bounceCount++;
+                    // 确保子弹不会卡在边界
+                    if (position.y <= 0) position.y = 0;
+                    if (position.y >= fieldHeight - transform.height) position.y = fieldHeight - transform.height;
+                    // 更改子弹材质为衰减子弹
+                    if (bouncedTexture != nullptr) {
+                        sprite.texture = bouncedTexture;
+                    }
+                } else {
+                    shouldDelete = true;
+                }
+            }
+
+            // 左右边界弹射
+            if (position.x <= 0 || position.x >= fieldWidth - transform.width) {
+                if (shot.bounceCount < shot.maxBounces) {
+                    direction.x = -direction.x; // 水平方向反弹
+                    shot.bounceCount++;
+                    if (position.x <= 0) position.x = 0;
+                    if (position.x >= fieldWidth - transform.width) position.x = fieldWidth - transform.width;
+                    if (bouncedTexture != nullptr) {
+                        sprite.texture = bouncedTexture;
+                    }
+                } else {
+                    shouldDelete = true;
+                }
+            }
+
+            // 检查子弹是否超出屏幕边界（用于删除）
+            shouldDelete |= position.x < -margin || position.x > fieldWidth + margin ||
+                            position.y < -margin || position.y > fieldHeight + margin;
+        } else {
+            // 不能反弹时碰到屏幕边缘就删除，超出外边界的情况也包含在内
+            shouldDelete = (position.x <= 0) | (position.x >= fieldWidth - transform.width) |
+                           (position.y <= 0) | (position.y >= fieldHeight - transform.height);
+        }
+
+        if (shouldDelete) {
+            world.destroy(entity);
+            return;
+        }
+
+        SDL_FRect shotRect = {position.x, position.y, transform.width, transform.height};
+        int shotHits = collidePlayerShot<Pierce>(world, shot, shotRect);
+        hits += shotHits;
+        // 不穿透的子弹击中第一个敌人后就删除，不需要记录击中过的敌人
+        if (!Pierce && shotHits > 0) {
+            world.destroy(entity);
+        }
+    });
+    return hits;
+}
+
+/**
+ * 用爆炸模板创建爆炸特效
+ * @param center 爆炸中心
+ * @param startTime 开始时间（模拟时间，毫秒）
+ */
+Entity spawnExplosion(EcsWorld& world, const Explosion& explosionTemplate, SDL_FPoint center, Uint32 startTime);
+
+/**
+ * 用玩家子弹模板创建子弹
+ * @param position 子弹左上角
+ * @param direction 单位方向
+ * @param damage 伤害
+ * @param maxBounces 最大反弹次数
+ */
+Entity spawnPlayerShot(EcsWorld& world, const ProjectilePlayer& shotTemplate, SDL_FPoint position, SDL_FPoint direction,
+                       int damage, int maxBounces);
+
+#endif // ECS_SYSTEMS_H
@@ -0,0 +1,56 @@
+#ifndef ENEMY_ARCHETYPE_H
+#define ENEMY_ARCHETYPE_H
+
+#include <SDL3/SDL.h>
+
+// 敌人的移动方式
+enum class EnemyMotion : Uint8 {
+    Straight, // 直线向左
+    Wave,     // 向左并上下摆动
+    Spin,     // 向左并旋转
+    Path      // 沿预先烘焙的曲线路径移动（EnemyPaths.h）
+};
+constexpr int ENEMY_MOTION_COUNT = 4;
+
+// 敌人的射击方式
+enum class EnemyFire {
+    None,   // 不射击
+    Aimed,  // 朝玩家发射一颗子弹
+    Radial  // 向四周发射多颗子弹
+};
+
+constexpr int ENEMY_MAX_TEXTURE_VARIANTS = 10; // 一种敌人最多的纹理数
+
+// 一种敌人的固定属性，编译期确定，所有敌人共用
+struct EnemyArchetypeDef {
+    const char* texturePath;    // 纹理路径；有多种纹理时为带%d的格式串
+    int textureVariants;        // 纹理数量，大于1时生成时随机选择
+    float sizeDivisor;          // 显示尺寸为图片尺寸除以该值
+    float speed;                // 移动速度
+    int health;                 // 初始血量
+    Uint32 coolDown[3];         // 各难度下的射击冷却时间（毫秒）
+    float spawnWeight;          // 生成概率
+    EnemyMotion motion;
+    EnemyFire fire;
+    int bulletCount;            // 每次射击的子弹数（Radial）
+};
+
+inline constexpr EnemyArchetypeDef ENEMY_ARCHETYPES[] = {
+    // 敌人0：血厚，不射击，10种随机外观
+    {"assets/image/随机敌人%d.png", 10, 4, 140, 7, {2000, 2000, 1200}, 0.1f, EnemyMotion::Straight, EnemyFire::None, 0},
+    // 敌人1：更快，血少，上下摆动并瞄准玩家射击
+    {"assets/image/敌人1.png", 1, 3, 200, 1, {1500, 1500, 900}, 0.7f, EnemyMotion::Wave, EnemyFire::Aimed, 1},
+    // 敌人2：更慢，血多，旋转并向四周射击
+    {"assets/image/敌人2.png", 1, 2, 100, 4, {3000, 3000, 1800}, 0.2f, EnemyMotion::Spin, EnemyFire::Radial, 5},
+};
+constexpr int ENEMY_ARCHETYPE_COUNT = static_cast<int>(sizeof(ENEMY_ARCHETYPES) / sizeof(ENEMY_ARCHETYPES[0]));
+
+// 一种敌人加载后的资源，每个场景一份，由Enemy::type索引
+struct EnemyArchetype {
+    const EnemyArchetypeDef* def = nullptr;
+    SDL_Texture* textures[ENEMY_MAX_TEXTURE_VARIANTS] = {nullptr};
+    float width = 0, height = 0; // 显示尺寸
+    Uint32 coolDown = 0;         // 当前难度的射击冷却时间
+};
+
+#endif // ENEMY_ARCHETYPE_H
@@ -0,0 +1,52 @@
+#ifndef ENEMY_PATHS_H
+#define ENEMY_PATHS_H
+
+#include "MotionPath.h"
+#include <cstddef>
+
+// 敌人的移动路径，控制点为相对生成位置的偏移（像素，y向下），都向左穿过整个屏幕
+
+// 俯冲：向下弯出一个弧后抬升离开
+inline constexpr SDL_FPoint PATH_SWOOP_POINTS[] = {
+    {0, 0}, {-300, 0}, {-500, 160}, {-700, 220}, {-900, 120}, {-1100, -40}, {-1500, -40},
+};
+
+// 下潜：斜向下冲到低处后水平离开
+inline constexpr SDL_FPoint PATH_DIVE_POINTS[] = {
+    {0, 0}, {-250, 0}, {-450, 140}, {-650, 300}, {-850, 340}, {-1500, 340},
+};
+
+// 蛇形：上下交替的大幅摆动
+inline constexpr SDL_FPoint PATH_SNAKE_POINTS[] = {
+    {0, 0}, {-200, -120}, {-400, 120}, {-600, -120}, {-800, 120}, {-1000, -120}, {-1200, 0}, {-1500, 0},
+};
+
+// 回环：直线进入，向上绕一个半径100的圆，再直线离开
+// 四分之一圆用控制点距离0.5523r的三次贝塞尔曲线近似
+inline constexpr SDL_FPoint PATH_LOOP_POINTS[] = {
+    {0, 0},
+    {-167, 0}, {-333, 0}, {-500, 0},
+    {-555.23f, 0}, {-600, -44.77f}, {-600, -100},
+    {-600, -155.23f}, {-555.23f, -200}, {-500, -200},
+    {-444.77f, -200}, {-400, -155.23f}, {-400, -100},
+    {-400, -44.77f}, {-444.77f, 0}, {-500, 0},
+    {-700, 0}, {-1100, 0}, {-1500, 0},
+};
+
+// 控制点数量由数组长度得出
+template <size_t N>
+constexpr MotionPathDef makeEnemyPath(const char* name, PathCurve curve, const SDL_FPoint (&points)[N])
+{
+    return {name, curve, points, static_cast<int>(N)};
+}
+
+// 波次时间表按名字引用，EnemyPath::path为下标
+inline constexpr MotionPathDef ENEMY_PATHS[] = {
+    makeEnemyPath("swoop", PathCurve::CatmullRom, PATH_SWOOP_POINTS),
+    makeEnemyPath("dive", PathCurve::CatmullRom, PATH_DIVE_POINTS),
+    makeEnemyPath("snake", PathCurve::CatmullRom, PATH_SNAKE_POINTS),
+    makeEnemyPath("loop", PathCurve::Bezier, PATH_LOOP_POINTS),
+};
+constexpr int ENEMY_PATH_COUNT = static_cast<int>(sizeof(ENEMY_PATHS) / sizeof(ENEMY_PATHS[0]));
+
+#endif // ENEMY_PATHS_H
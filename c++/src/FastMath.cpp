@@ -0,0 +1,96 @@
+#include "FastMath.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FAST_MATH_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#ifdef FAST_MATH_SSE2
+namespace
+{
+    // 4个角度在表中的下标和插值系数，与fastmath_detail::tableIndex逐项相同
+    inline __m128i tableIndex4(__m128 radians, __m128& frac)
+    {
+        __m128 t = _mm_mul_ps(radians, _mm_set1_ps(fastmath_detail::TABLE_PER_RADIAN));
+        __m128i index = _mm_cvttps_epi32(t);
+        // 截断后大于t的（负数）减1，比较结果为全1即-1
+        __m128 above = _mm_cmpgt_ps(_mm_cvtepi32_ps(index), t);
+        index = _mm_add_epi32(index, _mm_castps_si128(above));
+        frac = _mm_sub_ps(t, _mm_cvtepi32_ps(index));
+        return index;
+    }
+
+    // 查表部分逐个读取（SSE2没有gather），插值用向量运算
+    inline __m128 lookup4(const int* index, int offset, __m128 frac)
+    {
+        const float* table = fastmath_detail::SIN_TABLE.values;
+        constexpr int mask = FAST_SIN_TABLE_SIZE - 1;
+        alignas(16) float low[4];
+        alignas(16) float high[4];
+        for (int i = 0; i < 4; i++) {
+            const float* v = table + ((index[i] + offset) & mask);
+            low[i] = v[0];
+            high[i] = v[1];
+        }
+        __m128 v0 = _mm_load_ps(low);
+        __m128 v1 = _mm_load_ps(high);
+        return _mm_add_ps(v0, _mm_mul_ps(_mm_sub_ps(v1, v0), frac));
+    }
+}
+#endif
+
+void fastSinCosBatch(const float* radians, float* sines, float* cosines, size_t count)
+{
+    size_t i = 0;
+#ifdef FAST_MATH_SSE2
+    for (; i + 4 <= count; i += 4) {
+        __m128 frac;
+        alignas(16) int index[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(index), tableIndex4(_mm_loadu_ps(radians + i), frac));
+        _mm_storeu_ps(sines + i, lookup4(index, 0, frac));
+        _mm_storeu_ps(cosines + i, lookup4(index, FAST_SIN_TABLE_SIZE / 4, frac));
+    }
+#endif
+    for (; i < count; i++) {
+        fastSinCos(radians[i], sines[i], cosines[i]);
+    }
+}
+
+void fastSinBatch(const float* radians, float* sines, size_t count)
+{
+    size_t i = 0;
+#ifdef FAST_MATH_SSE2
+    for (; i + 4 <= count; i += 4) {
+        __m128 frac;
+        alignas(16) int index[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(index), tableIndex4(_mm_loadu_ps(radians + i), frac));
+        _mm_storeu_ps(sines + i, lookup4(index, 0, frac));
+    }
+#endif
+    for (; i < count; i++) {
+        sines[i] = fastSin(radians[i]);
+    }
+}
+
+void fastRsqrtBatch(const float* values, float* results, size_t count)
+{
+    size_t i = 0;
+#ifdef FAST_MATH_SSE2
+    const __m128i magic = _mm_set1_epi32(0x5F375A86);
+    const __m128 threeHalves = _mm_set1_ps(1.5f);
+    const __m128 halfScale = _mm_set1_ps(0.5f);
+    for (; i + 4 <= count; i += 4) {
+        __m128 x = _mm_loadu_ps(values + i);
+        __m128i bits = _mm_sub_epi32(magic, _mm_srli_epi32(_mm_castps_si128(x), 1));
+        __m128 y = _mm_castsi128_ps(bits);
+        __m128 half = _mm_mul_ps(halfScale, x);
+        // 与fastRsqrt相同的运算顺序：y * (1.5 - half * y * y)
+        y = _mm_mul_ps(y, _mm_sub_ps(threeHalves, _mm_mul_ps(_mm_mul_ps(half, y), y)));
+        y = _mm_mul_ps(y, _mm_sub_ps(threeHalves, _mm_mul_ps(_mm_mul_ps(half, y), y)));
+        _mm_storeu_ps(results + i, y);
+    }
+#endif
+    for (; i < count; i++) {
+        results[i] = fastRsqrt(values[i]);
+    }
+}
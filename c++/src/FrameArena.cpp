@@ -0,0 +1,91 @@
+#include "FrameArena.h"
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+
+FrameArena::FrameArena(size_t capacity)
+{
+    addBlock(std::max<size_t>(capacity, 1024));
+}
+
+void FrameArena::addBlock(size_t size)
+{
+    Block block;
+    block.data.reset(new char[size]);
+    block.size = size;
+    if (!blocks.empty()) {
+        usedBefore += offset;
+    }
+    blocks.push_back(std::move(block));
+    offset = 0;
+}
+
+void* FrameArena::allocate(size_t size, size_t alignment)
+{
+    Block* block = &blocks.back();
+    uintptr_t base = reinterpret_cast<uintptr_t>(block->data.get());
+    size_t start = ((base + offset + alignment - 1) & ~(alignment - 1)) - base;
+    if (start + size > block->size) {
+        // 当前块放不下，临时加一块，清空时再合并
+        addBlock(std::max(block->size, size + alignment));
+        block = &blocks.back();
+        base = reinterpret_cast<uintptr_t>(block->data.get());
+        start = ((base + alignment - 1) & ~(alignment - 1)) - base;
+    }
+    offset = start + size;
+    peak = std::max(peak, getUsed());
+    return block->data.get() + start;
+}
+
+const char* FrameArena::format(const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    va_list copyArgs;
+    va_copy(copyArgs, args);
+    int length = std::vsnprintf(nullptr, 0, fmt, copyArgs);
+    va_end(copyArgs);
+    if (length < 0) {
+        va_end(args);
+        return "";
+    }
+    char* text = static_cast<char*>(allocate(static_cast<size_t>(length) + 1, 1));
+    std::vsnprintf(text, static_cast<size_t>(length) + 1, fmt, args);
+    va_end(args);
+    return text;
+}
+
+std::string_view FrameArena::copy(std::string_view text)
+{
+    char* result = static_cast<char*>(allocate(text.size() + 1, 1));
+    std::memcpy(result, text.data(), text.size());
+    result[text.size()] = '\0';
+    return std::string_view(result, text.size());
+}
+
+void FrameArena::reset()
+{
+    if (blocks.size() > 1) {
+        size_t total = getCapacity();
+        blocks.clear();
+        addBlock(total);
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Frame arena grown to %zu bytes", total);
+    }
+#ifndef NDEBUG
+    // 调试版本填充无效数据，便于发现跨帧使用
+    std::memset(blocks.back().data.get(), 0xCD, offset);
+#endif
+    offset = 0;
+    usedBefore = 0;
+}
+
+size_t FrameArena::getCapacity() const
+{
+    size_t total = 0;
+    for (const Block& block : blocks) {
+        total += block.size;
+    }
+    return total;
+}
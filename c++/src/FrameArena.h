@@ -0,0 +1,95 @@
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include <SDL3/SDL.h>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/**
+ * 每帧的线性内存区
+ * 分配只是移动指针，不单独释放，Game::run每帧开始时整体清空。
+ * 用于HUD文字、临时列表等只在一帧内使用的数据；放在这里的对象不会执行析构函数，
+ * 容器可以正常析构（释放是空操作），但不能留到下一帧
+ * 一帧用量超过容量时临时申请新的块，下次清空时合并成一块，之后不再申请
+ */
+class FrameArena
+{
+public:
+    explicit FrameArena(size_t capacity = 64 * 1024);
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    /**
+     * 分配一段未初始化的内存，本帧内有效
+     * @param size 字节数
+     * @param alignment 对齐，必须是2的幂
+     */
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    // 分配count个默认初始化的T，T必须可以平凡析构
+    template <typename T>
+    T* allocateArray(size_t count)
+    {
+        static_assert(std::is_trivially_destructible<T>::value, "FrameArena does not run destructors");
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    /**
+     * 按printf格式生成字符串，结果以'\0'结尾，本帧内有效
+     * @return 格式化后的字符串，格式错误时为空字符串
+     */
+    const char* format(const char* fmt, ...);
+    std::string_view copy(std::string_view text); // 复制一段文字，结果以'\0'结尾
+
+    void reset(); // 清空，之前分配的内存全部失效
+    size_t getUsed() const { return usedBefore + offset; } // 本帧已用字节数
+    size_t getPeak() const { return peak; }                // 单帧最大用量
+    size_t getCapacity() const;                            // 当前容量
+
+private:
+    struct Block {
+        std::unique_ptr<char[]> data;
+        size_t size = 0;
+    };
+    std::vector<Block> blocks; // 最后一块是正在使用的块
+    size_t offset = 0;         // 当前块已用字节数
+    size_t usedBefore = 0;     // 之前的块已用字节数
+    size_t peak = 0;
+
+    void addBlock(size_t size);
+};
+
+// 从FrameArena分配的STL分配器，deallocate为空操作
+template <typename T>
+class ArenaAllocator
+{
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(FrameArena& arena) noexcept : arena(&arena) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena(other.getArena()) {}
+
+    T* allocate(size_t count) { return static_cast<T*>(arena->allocate(count * sizeof(T), alignof(T))); }
+    void deallocate(T*, size_t) noexcept {}
+    FrameArena* getArena() const noexcept { return arena; }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept { return arena == other.getArena(); }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const noexcept { return arena != other.getArena(); }
+
+private:
+    FrameArena* arena;
+};
+
+// 本帧内使用的容器，构造时传入 ArenaAllocator<T>(arena)
+template <typename T>
+using FrameVector = std::vector<T, ArenaAllocator<T>>;
+using FrameString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+
+#endif // FRAME_ARENA_H
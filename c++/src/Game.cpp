@@ -1,15 +1,19 @@
 #include "Game.h"
 #include "SceneMain.h"
+#include "SceneBoss.h"
 #include "SceneTitle.h"
+#include "SceneEnd.h"
 #include <SDL3/SDL.h>
 #include <SDL3_image/SDL_image.h>
 #include <SDL3_ttf/SDL_ttf.h>
 #include <SDL3_mixer/SDL_mixer.h>
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
 #include <fstream>
-#include <sstream>
 // 游戏主类构造函数
 Game::Game()
-    : deltaTime(0.0f), frameTime(0), textFont(nullptr), titleFont(nullptr) // 初始化成员变量
+    : deltaTime(0.0f), tickNs(0), textFont(nullptr), titleFont(nullptr) // 初始化成员变量
 {
     // 注意：构造函数中不应该调用虚函数或复杂操作
     // 实际的初始化工作在init()方法中完成
@@ -26,33 +30,372 @@ Game::~Game()
  */
 void Game::run()
 {
+    constexpr Uint64 MAX_FRAME_NS = 250 * SDL_NS_PER_MS; // 单帧最多补偿的时间，防止卡顿后连续追帧
+    constexpr int MAX_FAST_TICKS = 1000; // 快速运行时两次处理事件之间最多推进的逻辑帧
+
+    AllocTracker::setThreadTracking(true); // 只统计主线程
+    Uint64 startNs = SDL_GetTicksNS();
+    Uint64 previous = startNs;
+    Uint64 accumulator = 0;
     while (isRunning)
     {
-        auto frameStart = SDL_GetTicks(); // 记录帧开始时间
+        frameArena.reset();
+        AllocCounters allocsBefore = AllocTracker::current();
+        Uint64 ticksBefore = totalTicks;
+        sceneChanged = false;
         SDL_Event event;
-        
-        handleEvent(&event);      // 处理输入事件
+        {
+            ProfileScope zone(profiler, "events");
+            handleEvent(&event);      // 处理输入事件
+        }
+
+        Uint64 now = SDL_GetTicksNS();
+        if (isUnthrottled()) {
+            // 快速运行不等待真实时间；有窗口时每帧推进约一帧时长的逻辑后渲染一次
+            bool headless = playbackSpeed == PlaybackSpeed::Headless;
+            Uint64 deadline = now + tickNs;
+            for (int i = 0; i < MAX_FAST_TICKS && isRunning && isUnthrottled(); i++) {
+                tick();
+                if (!headless && SDL_GetTicksNS() >= deadline) {
+                    break;
+                }
+            }
+            accumulator = 0;
+        } else {
+            // 固定步长：按真实经过的时间推进整数个逻辑帧，不足一帧的时间留到下次
+            accumulator += std::min(now - previous, MAX_FRAME_NS);
+            while (accumulator >= tickNs && isRunning) {
+                tick();
+                accumulator -= tickNs;
+            }
+        }
+        previous = now;
+
+        if (playbackSpeed != PlaybackSpeed::Headless) {
+            ProfileScope zone(profiler, "render");
+            render();             // 渲染画面
+        }
+
+        // 等待到下一个逻辑帧
+        if (!isUnthrottled()) {
+            Uint64 spent = SDL_GetTicksNS() - now;
+            Uint64 wait = tickNs - accumulator;
+            if (spent < wait) {
+                SDL_DelayNS(wait - spent);
+            }
+        }
+        if (AllocTracker::isAvailable()) {
+            checkAllocBudget(allocsBefore, totalTicks - ticksBefore);
+        }
+    }
+
+    if (profiler.isEnabled()) {
+        reportBenchmark(SDL_GetTicksNS() - startNs);
+    }
+    if (AllocTracker::isAvailable() && (profiler.isEnabled() || allocBudget >= 0)) {
+        reportAllocs();
+    }
+    AllocTracker::setThreadTracking(false);
+}
+
+void Game::tick()
+{
+    {
+        ProfileScope zone(profiler, "input");
+        input = resolveInput(useBot ? sampleBotInput() : sampleLiveInput());
+    }
+    bool hashing = replayMode != ReplayMode::Off && (recordingHashes || checkingHashes);
+    ReplayMode modeBefore = replayMode;
+    {
+        ProfileScope zone(profiler, "update");
         update(deltaTime);        // 更新游戏逻辑
-        render();                 // 渲染画面
-        
-        auto frameEnd = SDL_GetTicks(); // 记录帧结束时间
-        auto diff = frameEnd - frameStart; // 计算实际帧时间
-        
-        // 帧率控制：如果帧时间小于目标时间，则延迟
-        if (diff < frameTime){
-            SDL_Delay(static_cast<Uint32>(frameTime - diff));
-            deltaTime = frameTime / 1000.0f; // 使用目标帧时间
+    }
+    if (hashing) {
+        ProfileScope zone(profiler, "state hash");
+        hashTick();
+    }
+    // 本局在这一帧结束录制，哈希日志和录像保存在一起
+    if (modeBefore == ReplayMode::Recording && replayMode != ReplayMode::Recording && recordingHashes) {
+        saveWriter.replaceFile(DesyncChecker::getPathForReplay(recordPath), hashLog.getData());
+        recordingHashes = false;
+    }
+    simTicks++;
+
+    // 基准测试中本局结束后直接重新开始，不停在结算画面
+    if (restartRun) {
+        restartRun = false;
+        changeScene(createStartScene());
+    }
+    totalTicks++;
+    if (maxTicks > 0 && totalTicks >= maxTicks) {
+        isRunning = false;
+    }
+}
+
+void Game::checkAllocBudget(const AllocCounters& before, Uint64 ticks)
+{
+    constexpr Uint64 MAX_REPORTS = 10; // 最多逐帧报告的次数
+    AllocCounters now = AllocTracker::current();
+    Uint64 count = now.count - before.count;
+    frameAllocs += count;
+    totalFrames++;
+    if (count > frameAllocMax) {
+        frameAllocMax = count;
+        frameAllocMaxAt = simTicks;
+    }
+    // 一帧推进多个逻辑帧时预算按逻辑帧数放宽，只处理事件和渲染的帧按一个逻辑帧计
+    Uint64 budget = static_cast<Uint64>(allocBudget) * std::max<Uint64>(ticks, 1);
+    if (allocBudget < 0 || count <= budget || sceneChanged) {
+        return;
+    }
+    framesOverBudget++;
+    if (framesOverBudget <= MAX_REPORTS) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Frame at tick %llu (%llu tick(s)) made %llu allocation(s) (%llu bytes), budget is %llu",
+                     static_cast<unsigned long long>(simTicks), static_cast<unsigned long long>(ticks),
+                     static_cast<unsigned long long>(count), static_cast<unsigned long long>(now.bytes - before.bytes),
+                     static_cast<unsigned long long>(budget));
+    }
+    if (framesOverBudget == 1) {
+        AllocTracker::reportSites(10);
+    }
+    SDL_assert(count <= budget);
+}
+
+void Game::reportAllocs() const
+{
+    double perFrame = totalFrames > 0 ? static_cast<double>(frameAllocs) / static_cast<double>(totalFrames) : 0.0;
+    double perTick = totalTicks > 0 ? static_cast<double>(frameAllocs) / static_cast<double>(totalTicks) : 0.0;
+    SDL_Log("Allocations: %.2f per frame (%.2f per tick), max %llu in one frame (tick %llu), %llu frame(s) over budget",
+            perFrame, perTick, static_cast<unsigned long long>(frameAllocMax), static_cast<unsigned long long>(frameAllocMaxAt),
+            static_cast<unsigned long long>(framesOverBudget));
+    AllocTracker::reportSites(20);
+}
+
+void Game::hashTick()
+{
+    stateHasher.beginTick(static_cast<Uint32>(simTicks));
+    currentScene->hashState(stateHasher);
+    const TickHash& hash = stateHasher.endTick();
+    if (recordingHashes) {
+        hashLog.record(hash);
+    }
+    if (checkingHashes) {
+        hashCheck.check(hash);
+    }
+}
+
+void Game::finishPlayback()
+{
+    if (checkingHashes) {
+        if (hashCheck.hasDiverged()) {
+            exitCode = 1;
+        } else {
+            SDL_Log("State hashes match for %u ticks", hashCheck.getCheckedTicks());
+        }
+        checkingHashes = false;
+    }
+    if (recordingHashes) {
+        saveWriter.replaceFile(hashRecordPath, hashLog.getData());
+        recordingHashes = false;
+    }
+}
+
+PlayerInput Game::sampleLiveInput()
+{
+    PlayerInput live = pendingInput;
+    pendingInput = PlayerInput();
+
+    const bool* keyboardState = SDL_GetKeyboardState(NULL);
+    if (keyboardState[SDL_SCANCODE_W]) live.keys |= INPUT_UP;
+    if (keyboardState[SDL_SCANCODE_S]) live.keys |= INPUT_DOWN;
+    if (keyboardState[SDL_SCANCODE_A]) live.keys |= INPUT_LEFT;
+    if (keyboardState[SDL_SCANCODE_D]) live.keys |= INPUT_RIGHT;
+    if (keyboardState[SDL_SCANCODE_J]) live.keys |= INPUT_BOOST;
+    if (keyboardState[SDL_SCANCODE_K]) live.keys |= INPUT_BOSS;
+    return live;
+}
+
+PlayerInput Game::sampleBotInput()
+{
+    botView.clear();
+    if (currentScene != nullptr) {
+        currentScene->fillBotView(botView);
+    }
+    return bot->decide(botView, simTicks);
+}
+
+Scene* Game::createStartScene()
+{
+    if (startScene == StartScene::Boss) {
+        // Boss战单独运行时没有主场景，由这里开始新的一局
+        beginRun();
+        Player player;
+        player.position.x = 100;
+        player.position.y = windowHeight / 2;
+        return new SceneBoss(0, player);
+    }
+    if (startScene == StartScene::Main) {
+        return new SceneMain();
+    }
+    return new SceneIntro();
+}
+
+void Game::reportBenchmark(Uint64 wallNs) const
+{
+    double seconds = static_cast<double>(wallNs) / 1e9;
+    double ticksPerSecond = seconds > 0 ? static_cast<double>(totalTicks) / seconds : 0.0;
+    SDL_Log("Benchmark: %llu ticks in %.3f s, %.0f ticks/s, %d run(s), seed %llu",
+            static_cast<unsigned long long>(totalTicks), seconds, ticksPerSecond, benchRuns,
+            static_cast<unsigned long long>(runSeed));
+    profiler.report(wallNs, totalTicks);
+    SDL_Log("Frame arena: peak %zu bytes, capacity %zu bytes", frameArena.getPeak(), frameArena.getCapacity());
+
+    if (benchJsonPath.empty() || totalTicks == 0) {
+        return;
+    }
+    // 每个逻辑帧的总耗时和各区段耗时，都按"每帧纳秒"记录，便于和基线比较
+    std::string label = !benchmark ? "replay" : startScene == StartScene::Boss ? "boss" : "main";
+    std::vector<BenchResult> results;
+    BenchResult total;
+    total.name = "sim/" + label + "/tick";
+    total.nsPerOp = static_cast<double>(wallNs) / static_cast<double>(totalTicks);
+    total.itemsPerSec = ticksPerSecond;
+    results.push_back(total);
+    for (const Profiler::Zone& zone : profiler.getZones()) {
+        BenchResult result;
+        result.name = "sim/" + label + "/" + zone.name;
+        std::replace(result.name.begin(), result.name.end(), ' ', '_');
+        result.nsPerOp = static_cast<double>(zone.totalNs) / static_cast<double>(totalTicks);
+        result.itemsPerSec = zone.totalNs > 0 ? static_cast<double>(totalTicks) * 1e9 / static_cast<double>(zone.totalNs) : 0.0;
+        results.push_back(result);
+    }
+    for (BenchResult& result : results) {
+        result.minNsPerOp = result.nsPerOp;
+        result.maxNsPerOp = result.nsPerOp;
+        result.iterations = totalTicks;
+        result.samples = 1;
+    }
+    if (BenchReport::writeJson(benchJsonPath, "sim", results)) {
+        SDL_Log("Results written to %s", benchJsonPath.c_str());
+    }
+}
+
+PlayerInput Game::resolveInput(const PlayerInput& live)
+{
+    if (replayMode == ReplayMode::Playback) {
+        PlayerInput recorded;
+        if (replay.next(recorded)) {
+            return recorded;
+        }
+        // 录像播放完毕，交还给玩家控制；快速回放直接退出
+        SDL_Log("Replay finished: %u ticks, final score %d", replay.getPlayedTicks(), finalScore);
+        finishPlayback();
+        replayMode = ReplayMode::Off;
+        useFixedSeed = false;
+        if (playbackSpeed != PlaybackSpeed::RealTime) {
+            isRunning = false;
+        }
+        return live;
+    }
+    if (replayMode == ReplayMode::Recording) {
+        replay.record(live);
+    }
+    return live;
+}
+
+void Game::parseArgs(int argc, char* argv[])
+{
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--replay" && hasValue) {
+            std::string path = argv[++i];
+            if (replay.load(path)) {
+                replayMode = ReplayMode::Playback;
+                setFixedSeed(replay.getSeed());
+                hashCheckPath = DesyncChecker::getPathForReplay(path);
+                SDL_Log("Playing replay %s (%u ticks)", path.c_str(), replay.getTickCount());
+            }
+        } else if (arg == "--record" && hasValue) {
+            recordPath = argv[++i];
+        } else if (arg == "--record-hashes" && hasValue) {
+            hashRecordPath = argv[++i];
+        } else if (arg == "--hash-detail") {
+            hashDetail = true;
+        } else if (arg == "--seed" && hasValue) {
+            setFixedSeed(std::strtoull(argv[++i], nullptr, 10));
+        } else if (arg == "--fast") {
+            playbackSpeed = PlaybackSpeed::Fast;
+        } else if (arg == "--headless") {
+            playbackSpeed = PlaybackSpeed::Headless;
+        } else if (arg == "--scene" && hasValue) {
+            std::string scene = argv[++i];
+            if (scene == "main") {
+                startScene = StartScene::Main;
+            } else if (scene == "boss") {
+                startScene = StartScene::Boss;
+            } else {
+                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Unknown scene: %s (expected main or boss)", scene.c_str());
+            }
+            benchmark = true;
+        } else if (arg == "--frames" && hasValue) {
+            maxTicks = std::strtoull(argv[++i], nullptr, 10);
+            benchmark = true;
+        } else if (arg == "--bench-json" && hasValue) {
+            benchJsonPath = argv[++i];
+        } else if (arg == "--difficulty" && hasValue) {
+            difficultyOverride = std::max(0, std::min(2, std::atoi(argv[++i])));
+        } else if (arg == "--bot") {
+            // 类型可省略
+            if (hasValue && argv[i + 1][0] != '-') {
+                botKind = argv[++i];
+            }
+            useBot = true;
+            benchmark = true;
+        } else if (arg == "--bot-upgrades" && hasValue) {
+            botUpgrades = argv[++i];
+        } else if (arg == "--alloc-budget" && hasValue) {
+            allocBudget = std::max(0, std::atoi(argv[++i]));
+            if (!AllocTracker::isAvailable()) {
+                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "--alloc-budget needs a build with ENABLE_ALLOC_TRACKING");
+            }
+        } else {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Unknown argument: %s", arg.c_str());
+        }
+    }
+
+    // 回放优先于基准测试；基准测试默认尽快运行并从主场景开始
+    if (replayMode == ReplayMode::Playback) {
+        benchmark = false;
+        useBot = false;
+    }
+    if (useBot) {
+        bot = BotController::create(botKind, botUpgrades);
+        useBot = bot != nullptr;
+    }
+    if (benchmark) {
+        if (playbackSpeed == PlaybackSpeed::RealTime) {
+            playbackSpeed = PlaybackSpeed::Fast;
         }
-        else{
-            deltaTime = diff / 1000.0f; // 使用实际帧时间
+        if (startScene == StartScene::Intro) {
+            startScene = StartScene::Main;
         }
     }
+    profiler.setEnabled(benchmark || (replayMode == ReplayMode::Playback && playbackSpeed != PlaybackSpeed::RealTime));
 }
 
 // 初始化游戏资源和SDL相关库
 void Game::init()
 {
-    frameTime = 1000 / FPS;
+    tickNs = SDL_NS_PER_SECOND / FPS;
+    deltaTime = 1.0f / FPS;
+    // SDL和各扩展库的分配也计入统计，需在SDL的第一次分配之前
+    AllocTracker::hookSdlAllocations();
+    // 无窗口回放使用dummy驱动，不创建可见窗口也不输出声音
+    if (playbackSpeed == PlaybackSpeed::Headless) {
+        SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "dummy");
+        SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");
+    }
     // SDL 初始化
     if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO)){
         SDL_LogError(SDL_LOG_CATEGORY_ERROR, "SDL could not initialize! SDL_Error: %s\n", SDL_GetError());
@@ -99,12 +442,13 @@ void Game::init()
         SDL_LogError(SDL_LOG_CATEGORY_ERROR, "SDL_mixer could not open audio! SDL_mixer Error: %s\n", SDL_GetError());
         isRunning = false;
     }
-    // 设置音效channel数量
-    Mix_AllocateChannels(32);
+    // 加载全局音效并启动音频线程，预先打开开场音乐
+    audio.init();
+    audio.preloadMusic(MusicId::Fantasy);
 
     // 设置音乐音量
-    Mix_VolumeMusic(bgmVolume * MIX_MAX_VOLUME / 100);
-    Mix_Volume(-1, sfxVolume * MIX_MAX_VOLUME / 100);
+    setBgmVolume(bgmVolume);
+    setSfxVolume(sfxVolume);
 
     // 初始化SDL_ttf
     if (!TTF_Init()) {
@@ -154,31 +498,38 @@ void Game::init()
         SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to load cursor image: %s\n", SDL_GetError());
     }
 
-    // 载入得分
+    // 启动存档写入线程并载入得分
+    saveWriter.init();
     loadData();
 
     // 载入设置
     loadSettings();
 
-    // 初始化场景为开场动画
-    currentScene = new SceneIntro();
+    if (difficultyOverride >= 0) {
+        difficulty = difficultyOverride;
+    }
+
+    // 回放录像时直接进入游戏场景，基准测试进入指定场景，否则从开场动画开始
+    if (replayMode == ReplayMode::Playback) {
+        difficulty = replay.getDifficulty();
+        currentScene = new SceneMain();
+    } else {
+        currentScene = createStartScene();
+    }
     currentScene->init();
-    
-    // 加载全局音效
-    globalSounds["button_click"] = Mix_LoadWAV("assets/sound/按钮声音.mp3");
-    globalSounds["player_death"] = Mix_LoadWAV("assets/sound/死亡音效.mp3");
+
 }
 void Game::setBgmVolume(int volume)
 {
     bgmVolume = std::max(0, std::min(100, volume));
-    Mix_VolumeMusic(bgmVolume * MIX_MAX_VOLUME / 100);
+    audio.setMusicVolume(bgmVolume * MIX_MAX_VOLUME / 100);
 }
 
 // 设置音效音量
 void Game::setSfxVolume(int volume)
 {
     sfxVolume = std::max(0, std::min(100, volume));
-    Mix_Volume(-1, sfxVolume * MIX_MAX_VOLUME / 100);
+    audio.setSfxVolume(sfxVolume * MIX_MAX_VOLUME / 100);
 }
 
 // 保存设置到文件
@@ -192,6 +543,7 @@ void Game::saveSettings() const
     file << "bgm_volume " << bgmVolume << std::endl;
     file << "sfx_volume " << sfxVolume << std::endl;
     file << "difficulty " << difficulty << std::endl;  // 添加难度保存
+    file << "bgm_crossfade " << audio.getCrossfadeTime() << std::endl;
     file.close();
 }
 
@@ -217,6 +569,8 @@ void Game::loadSettings()
             setSfxVolume(value);
         } else if (key == "difficulty") {  // 添加难度加载
             difficulty = value;
+        } else if (key == "bgm_crossfade") {
+            audio.setCrossfadeTime(value);
         }
     }
     file.close();
@@ -224,48 +578,60 @@ void Game::loadSettings()
 // 清理所有资源
 void Game::clean()
 {
+    // 释放后置空，基准测试主动调用后析构函数再次调用时不会重复释放
     if (currentScene != nullptr)
     {
         currentScene->clean();
         delete currentScene;
+        currentScene = nullptr;
     }
     if (nearStars.texture != nullptr){
         SDL_DestroyTexture(nearStars.texture);
+        nearStars.texture = nullptr;
     }
     if (farStars.texture != nullptr){
         SDL_DestroyTexture(farStars.texture);
+        farStars.texture = nullptr;
     }
     if (titleFont != nullptr){
         TTF_CloseFont(titleFont);
+        titleFont = nullptr;
     }
     if (textFont != nullptr){
         TTF_CloseFont(textFont);
+        textFont = nullptr;
     }
     
     // 清理自定义光标
     if (customCursor != nullptr) {
         SDL_DestroyCursor(customCursor);
+        customCursor = nullptr;
     }
-    for (auto& sound : globalSounds) {
-        if (sound.second != nullptr) {
-            Mix_FreeChunk(sound.second);
-        }
-    }
-    globalSounds.clear();
+    // 写完尚未落盘的存档
+    saveWriter.shutdown();
+    // 停止音频线程并释放音乐和音效
+    audio.clean();
     // 清理SDL_mixer
     Mix_CloseAudio();
     Mix_Quit();
     // 清理SDL_ttf
     TTF_Quit();
 
-    SDL_DestroyRenderer(renderer);
-    SDL_DestroyWindow(window);
+    if (renderer != nullptr) {
+        SDL_DestroyRenderer(renderer);
+        renderer = nullptr;
+    }
+    if (window != nullptr) {
+        SDL_DestroyWindow(window);
+        window = nullptr;
+    }
     SDL_Quit();
 }
 
 // 切换场景
 void Game::changeScene(Scene *scene)
 {
+     sceneChanged = true;
      // 先保存旧场景指针
      Scene* oldScene = currentScene;
     
@@ -285,6 +651,16 @@ void Game::changeScene(Scene *scene)
      }
  }
 
+void Game::showRunResult(bool victory)
+{
+    changeScene(new SceneEnd(victory));
+}
+
+void Game::returnToTitle()
+{
+    changeScene(new SceneTitle());
+}
+
 // 处理输入事件，包括退出、全屏切换等
 void Game::handleEvent(SDL_Event *event)
 {
@@ -318,6 +694,8 @@ void Game::update(float deltaTime)
     if (currentScene != nullptr) {
         currentScene->update(deltaTime);
     }
+    // 通知音频线程派发本帧提交的所有音效
+    audio.endFrame(SDL_GetTicks());
 }
 
 // 渲染背景和当前场景
@@ -338,14 +716,14 @@ void Game::render()
 }
 
 // 居中渲染文本，返回文本右下角坐标
-SDL_FPoint Game::renderTextCentered(std::string text, float posY, bool isTitle)
+SDL_FPoint Game::renderTextCentered(std::string_view text, float posY, bool isTitle)
 {
     SDL_Color color = textColor; // 使用设置的颜色
     SDL_Surface *surface;
     if (isTitle){
-        surface = TTF_RenderText_Solid(titleFont, text.c_str(), 0 , color);
+        surface = TTF_RenderText_Solid(titleFont, text.data(), text.size(), color);
     }else{
-        surface = TTF_RenderText_Solid(textFont, text.c_str(), 0 , color);
+        surface = TTF_RenderText_Solid(textFont, text.data(), text.size(), color);
     }
     
     SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
@@ -361,10 +739,10 @@ SDL_FPoint Game::renderTextCentered(std::string text, float posY, bool isTitle)
 }
 
 // 按指定位置渲染文本
-void Game::renderTextPos(std::string text, float posX, float posY, bool isLeft)
+void Game::renderTextPos(std::string_view text, float posX, float posY, bool isLeft)
 {
     SDL_Color color = textColor; // 使用设置的颜色
-    SDL_Surface *surface = TTF_RenderText_Solid(textFont, text.c_str(), 0 , color);
+    SDL_Surface *surface = TTF_RenderText_Solid(textFont, text.data(), text.size(), color);
     
     SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
     SDL_FRect rect;
@@ -378,6 +756,29 @@ void Game::renderTextPos(std::string text, float posX, float posY, bool isLeft)
     SDL_DestroySurface(surface);
 }
 
+SDL_Texture* Game::loadTexture(const char* path, float* width, float* height)
+{
+    SDL_Texture* texture = IMG_LoadTexture(renderer, path);
+    if (texture == nullptr) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load texture %s: %s", path, SDL_GetError());
+    }
+    // 失败时大小为0，与直接对空纹理调用SDL_GetTextureSize一致
+    float w = 0, h = 0;
+    SDL_GetTextureSize(texture, &w, &h);
+    if (width != nullptr) {
+        *width = w;
+    }
+    if (height != nullptr) {
+        *height = h;
+    }
+    return texture;
+}
+
+TTF_Font* Game::loadFont(const char* path, float size)
+{
+    return TTF_OpenFont(path, size);
+}
+
 // 更新背景星空的偏移量，实现卷轴效果
 void Game::backgroundUpdate(float deltaTime)
 {
@@ -415,67 +816,52 @@ void Game::renderBackground()
     }
 }
 
-// 保存排行榜数据到文件
+// 保存排行榜数据：主线程只做编码，磁盘写入交给后台线程
 void Game::saveData()
 {
-    std::ofstream file("assets/save.dat");
-    if (!file.is_open()) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to open save file for writing");
-        return;
-    }
-    
-    // 保存各难度得分榜的数据
-    file << "easy_scores" << std::endl;
-    for (const auto &entry : leaderBoardEasy){
-        file << entry.first << " " << entry.second << std::endl;
-    }
-    
-    file << "normal_scores" << std::endl;
-    for (const auto &entry : leaderBoardNormal){
-        file << entry.first << " " << entry.second << std::endl;
-    }
-    
-    file << "hard_scores" << std::endl;
-    for (const auto &entry : leaderBoardHard){
-        file << entry.first << " " << entry.second << std::endl;
-    }
-    
-    file.close();
+    const LeaderBoard* boards[SaveStore::BOARD_COUNT] = {&leaderBoardEasy, &leaderBoardNormal, &leaderBoardHard};
+    saveWriter.replaceFile(SaveStore::SAVE_PATH, SaveStore::encode(boards));
 }
 
 void Game::loadData()
 {
-    std::ifstream file("assets/save.dat");
-    if (!file.is_open()) {
-        SDL_Log("Save file not found, starting fresh");
-        return;
+    loadLeaderBoards();
+    runHistory.load(&saveWriter);
+
+    // 还没有游戏记录时用已有的排行榜作为初始记录
+    LeaderBoard* boards[SaveStore::BOARD_COUNT] = {&leaderBoardEasy, &leaderBoardNormal, &leaderBoardHard};
+    for (int diff = 0; diff < SaveStore::BOARD_COUNT; diff++) {
+        if (runHistory.getRunCount(diff) > 0) {
+            continue;
+        }
+        for (const auto& entry : *boards[diff]) {
+            RunRecord run;
+            run.score = entry.first;
+            run.name = entry.second;
+            runHistory.record(diff, run);
+        }
     }
-    
-    leaderBoardEasy.clear();
-    leaderBoardNormal.clear();
-    leaderBoardHard.clear();
-    
-    std::string line;
-    std::multimap<int, std::string, std::greater<int>>* currentBoard = nullptr;
-    
-    while (std::getline(file, line)) {
-        if (line == "easy_scores") {
-            currentBoard = &leaderBoardEasy;
-        } else if (line == "normal_scores") {
-            currentBoard = &leaderBoardNormal;
-        } else if (line == "hard_scores") {
-            currentBoard = &leaderBoardHard;
-        } else if (currentBoard != nullptr) {
-            std::istringstream iss(line);
-            int score;
-            std::string name;
-            if (iss >> score >> name) {
-                currentBoard->insert({score, name});
-            }
+}
+
+void Game::loadLeaderBoards()
+{
+    LeaderBoard* boards[SaveStore::BOARD_COUNT] = {&leaderBoardEasy, &leaderBoardNormal, &leaderBoardHard};
+
+    std::vector<Uint8> data;
+    if (SaveStore::readFile(SaveStore::SAVE_PATH, data)) {
+        if (SaveStore::decode(data, boards)) {
+            return;
         }
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Save file is corrupted, trying legacy save");
     }
-    
-    file.close();
+
+    // 首次运行新版本时迁移旧版文本存档
+    if (!SaveStore::loadLegacy(SaveStore::LEGACY_PATH, boards)) {
+        SDL_Log("Save file not found, starting fresh");
+        return;
+    }
+    SDL_Log("Migrated legacy save file to %s", SaveStore::SAVE_PATH);
+    saveData();
 }
 
 void Game::insertLeaderBoard(int score, std::string name)
@@ -486,6 +872,71 @@ void Game::insertLeaderBoard(int score, std::string name)
         currentLeaderBoard.erase(--currentLeaderBoard.end());
     }
     saveData();
+
+    // 完整的游戏记录追加到日志
+    RunRecord run;
+    run.score = score;
+    run.name = name;
+    run.timestamp = static_cast<Sint64>(std::time(nullptr));
+    run.durationMs = runDurationMs;
+    run.weaponLevel = static_cast<Uint8>(std::max(0, std::min(255, runWeapon.level)));
+    run.weaponDamage = static_cast<Uint8>(std::max(0, std::min(255, runWeapon.damage)));
+    run.bounceCount = static_cast<Uint8>(std::max(0, std::min(255, runWeapon.bounceCount)));
+    run.splitCount = static_cast<Uint8>(std::max(0, std::min(255, runWeapon.splitCount)));
+    run.fireRatePercent = static_cast<Uint16>(std::max(0, std::min(65535, static_cast<int>(runWeapon.fireRate * 100.0f + 0.5f))));
+    run.piercing = runWeapon.piercing;
+    run.bossProgress = runBossProgress;
+    runHistory.record(difficulty, run);
+}
+
+void Game::beginRun()
+{
+    simTicks = 0; // 模拟时间从每局开始计算，录制和回放的时间轴一致
+    benchRuns++;
+    runBossProgress = BossProgress::None;
+
+    // 未指定种子时用高精度计时器和系统时间混合出新种子
+    if (useFixedSeed) {
+        runSeed = fixedSeed;
+    } else {
+        Uint64 mix = SDL_GetPerformanceCounter() ^ (static_cast<Uint64>(std::time(nullptr)) << 32);
+        runSeed = splitMix64(mix);
+    }
+    SDL_Log("Run seed: %llu", static_cast<unsigned long long>(runSeed));
+
+    // 回放时从录像开头读取输入，基准测试不录制，否则录制本局
+    if (replayMode == ReplayMode::Playback) {
+        replay.rewind();
+        checkingHashes = hashCheck.load(hashCheckPath);
+        recordingHashes = !hashRecordPath.empty();
+    } else if (benchmark) {
+        checkingHashes = false;
+        recordingHashes = false;
+    } else {
+        replay.begin(runSeed, difficulty);
+        replayMode = ReplayMode::Recording;
+        checkingHashes = false;
+        recordingHashes = true;
+    }
+    // 比较时沿用日志的详细模式，才能定位到具体实体
+    stateHasher.setDetail(hashDetail || (checkingHashes && hashCheck.isDetail()));
+    if (recordingHashes) {
+        hashLog.beginRecording(stateHasher.isDetail());
+    }
+}
+
+void Game::endRun(const Weapon& weapon, BossProgress progress)
+{
+    runDurationMs = static_cast<Uint32>(getSimTicks());
+    runWeapon = weapon;
+    runBossProgress = progress;
+    restartRun = benchmark;
+
+    // 保存本局录像
+    if (replayMode == ReplayMode::Recording) {
+        saveWriter.replaceFile(recordPath, replay.encode());
+        replayMode = ReplayMode::Off;
+    }
 }
 
 // 设置自定义光标
@@ -503,53 +954,21 @@ void Game::setDefaultCursor()
         SDL_SetCursor(defaultCursor);
     }
 }
-void Game::playBgm(const std::string& musicPath, bool forceRestart)
+void Game::playBgm(MusicId music, bool forceRestart)
 {
-    // 如果正在播放相同的音乐且不强制重启，则不做任何操作
-    if (!forceRestart && currentBgmPath == musicPath && Mix_PlayingMusic()) {
-        return;
-    }
-    
-    // 停止当前音乐
-    if (currentBgm != nullptr) {
-        Mix_HaltMusic();
-        Mix_FreeMusic(currentBgm);
-        currentBgm = nullptr;
-    }
-    
-    // 加载新音乐
-    currentBgm = Mix_LoadMUS(musicPath.c_str());
-    if (currentBgm == nullptr) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load music: %s", SDL_GetError());
-        currentBgmPath = "";
-        return;
-    }
-    
-    // 播放音乐
-    Mix_PlayMusic(currentBgm, -1);
-    currentBgmPath = musicPath;
+    audio.playMusic(music, forceRestart);
 }
 
-void Game::stopBgm()
+void Game::preloadBgm(MusicId music)
 {
-    if (currentBgm != nullptr) {
-        Mix_HaltMusic();
-        Mix_FreeMusic(currentBgm);
-        currentBgm = nullptr;
-        currentBgmPath = "";
-    }
+    audio.preloadMusic(music);
 }
-void Game::playSfx(const std::string& soundPath)
+
+void Game::stopBgm()
 {
-    auto it = globalSounds.find(soundPath);
-    if (it != globalSounds.end() && it->second != nullptr) {
-        // 使用音效音量设置播放
-        Mix_PlayChannel(-1, it->second, 0);
-    } else {
-        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Sound effect not found: %s", soundPath.c_str());
-    }
+    audio.stopMusic();
 }
-bool Game::isPlayingBgm(const std::string& musicPath) const
+bool Game::isPlayingBgm(MusicId music) const
 {
-    return currentBgmPath == musicPath && Mix_PlayingMusic();
+    return audio.getRequestedMusic() == music;
 }
@@ -2,8 +2,21 @@
 #define GAME_H
 
 #include "Scene.h"
+#include "GameServices.h"
 #include "Object.h"
 #include "SceneIntro.h"
+#include "AudioSystem.h"
+#include "AsyncWriter.h"
+#include "SaveStore.h"
+#include "RunHistory.h"
+#include "Random.h"
+#include "Replay.h"
+#include "StateHasher.h"
+#include "DesyncChecker.h"
+#include "Profiler.h"
+#include "AllocTracker.h"
+#include "BenchReport.h"
+#include "BotController.h"
 #include <SDL3/SDL.h>
 #include <SDL3_image/SDL_image.h>
 #include <SDL3_ttf/SDL_ttf.h>
@@ -11,11 +24,18 @@
 #include <string>
 #include <map>
 
+// 启动后进入的场景
+enum class StartScene {
+    Intro, // 开场动画（正常游戏）
+    Main,  // 直接进入主场景
+    Boss   // 直接进入Boss战
+};
+
 /**
  * 游戏主控类，采用单例模式管理整个游戏的生命周期
- * 负责SDL初始化、场景管理、资源管理、事件处理等核心功能
+ * 负责SDL初始化、场景管理、资源管理、事件处理等核心功能，并为游戏场景提供服务
  */
-class Game
+class Game : public GameServices
 {
 private:
     Game(); // 构造函数私有化，保证单例模式
@@ -45,9 +65,10 @@ private:
     // 窗口和帧率设置
     float windowWidth = 1200;     // 窗口宽度
     float windowHeight = 750;    // 窗口高度
-    int FPS = 60;                // 目标帧率
-    Uint32 frameTime;            // 每帧目标时间（毫秒）
-    float deltaTime;             // 实际每帧耗时（秒）
+    int FPS = 60;                // 逻辑帧率
+    Uint64 tickNs;               // 每个逻辑帧的时长（纳秒）
+    float deltaTime;             // 每个逻辑帧的时长（秒），固定不变
+    Uint64 simTicks = 0;         // 本局已模拟的逻辑帧数
     
     // 游戏数据
     int finalScore = 0;          // 最终得分
@@ -62,14 +83,79 @@ private:
     Background farStars;  // 远景星空背景
 
     // 分难度排行榜系统
-    std::multimap<int, std::string, std::greater<int>> leaderBoardEasy;    // 简单难度排行榜
-    std::multimap<int, std::string, std::greater<int>> leaderBoardNormal;  // 普通难度排行榜
-    std::multimap<int, std::string, std::greater<int>> leaderBoardHard;    // 困难难度排行榜
+    LeaderBoard leaderBoardEasy;    // 简单难度排行榜
+    LeaderBoard leaderBoardNormal;  // 普通难度排行榜
+    LeaderBoard leaderBoardHard;    // 困难难度排行榜
+    AsyncWriter saveWriter;         // 存档写入线程
+    RunHistory runHistory;          // 全部游戏记录（排行榜和百分位查询）
+
+    // 当前这局的统计
+    Uint32 runDurationMs = 0;       // 游戏时长（模拟时间）
+    Weapon runWeapon;               // 结束时的武器
+    BossProgress runBossProgress = BossProgress::None; // Boss战进度
+    Uint64 runSeed = 0;             // 本局随机种子
+    Uint64 fixedSeed = 0;           // 指定的随机种子
+    bool useFixedSeed = false;      // 是否每局都使用指定种子（用于复现）
     
+    // 输入与录像
+    PlayerInput input;              // 当前逻辑帧的输入
+    PlayerInput pendingInput;       // 事件中产生、还未被逻辑帧读取的输入
+    Replay replay;                  // 录制或回放中的录像
+    ReplayMode replayMode = ReplayMode::Off;
+    PlaybackSpeed playbackSpeed = PlaybackSpeed::RealTime;
+    std::string recordPath = "assets/replay_last.dqr"; // 每局结束后录像保存的位置
+
+    // 状态哈希（录制时随录像保存，回放时逐帧比较）
+    StateHasher stateHasher;        // 每个逻辑帧的状态哈希
+    DesyncChecker hashLog;          // 本局录制的哈希日志
+    DesyncChecker hashCheck;        // 回放时用于比较的哈希日志
+    std::string hashCheckPath;      // 回放录像对应的哈希日志
+    std::string hashRecordPath;     // 回放时另存哈希日志的位置（为空时不保存）
+    bool recordingHashes = false;   // 是否在录制哈希日志
+    bool checkingHashes = false;    // 是否在与哈希日志比较
+    bool hashDetail = false;        // 哈希日志是否保存每个实体的哈希
+    int exitCode = 0;               // 进程退出码，回放出现不一致时非零
+    FrameArena frameArena;          // 每帧的临时内存，run()中每帧开始时清空
+
+    // 基准测试（无需操作即可反复运行同一场景）
+    Profiler profiler;              // 分阶段计时
+    StartScene startScene = StartScene::Intro; // 启动后进入的场景
+    bool benchmark = false;         // 是否为基准测试运行
+    bool useBot = false;            // 是否由机器人代替键盘操作
+    std::string botKind = "dodge";  // 机器人类型
+    std::string botUpgrades = "cycle"; // 机器人的升级选择策略
+    std::unique_ptr<BotController> bot; // 机器人
+    BotView botView;                // 每帧交给机器人的场景信息
+    int difficultyOverride = -1;    // 命令行指定的难度（-1表示使用设置中的难度）
+    Uint64 maxTicks = 0;            // 最多运行的逻辑帧数（0表示不限）
+    Uint64 totalTicks = 0;          // 启动以来运行的逻辑帧数
+    int benchRuns = 0;              // 启动以来开始的局数
+    bool restartRun = false;        // 本局已结束，下一帧重新开始
+    std::string benchJsonPath;      // 基准测试结果JSON的保存位置（为空时不保存）
+
+    // 堆分配统计（需用ENABLE_ALLOC_TRACKING编译）
+    int allocBudget = -1;           // 每个逻辑帧允许的堆分配次数（-1表示不检查）
+    Uint64 frameAllocs = 0;         // 所有帧（事件、逻辑帧和渲染）中的堆分配总次数
+    Uint64 totalFrames = 0;         // 统计过的帧数
+    Uint64 frameAllocMax = 0;       // 单帧最多的分配次数
+    Uint64 frameAllocMaxAt = 0;     // 分配最多的一帧结束于本局第几个逻辑帧
+    Uint64 framesOverBudget = 0;    // 超出预算的帧数
+    bool sceneChanged = false;      // 本帧切换了场景（加载资源，不检查预算）
+
+    void tick(); // 推进一个逻辑帧
+    void hashTick(); // 计算本逻辑帧的状态哈希，录制或比较
+    void finishPlayback(); // 录像播放完毕，汇报哈希比较结果
+    PlayerInput sampleLiveInput(); // 读取键盘状态和待处理的输入
+    PlayerInput sampleBotInput(); // 由当前场景填写视图，交给机器人决定输入
+    Scene* createStartScene(); // 创建启动后进入的场景
+    void reportBenchmark(Uint64 wallNs) const; // 输出每秒逻辑帧数和分阶段耗时
+    void checkAllocBudget(const AllocCounters& before, Uint64 ticks); // 统计本帧的堆分配，超出预算时报错
+    void reportAllocs() const; // 输出每帧堆分配的统计
+    // 是否不等待真实时间（快速回放和基准测试）
+    bool isUnthrottled() const { return playbackSpeed != PlaybackSpeed::RealTime && (replayMode == ReplayMode::Playback || benchmark); }
+
     // 全局音频管理
-    Mix_Music* currentBgm = nullptr;     // 当前播放的背景音乐
-    std::string currentBgmPath = "";     // 当前音乐文件路径
-    std::map<std::string, Mix_Chunk*> globalSounds; // 全局音效资源池
+    AudioSystem audio;                   // 音频系统（命令经无锁队列交给音频线程执行）
 
 public:
     /**
@@ -81,13 +167,29 @@ public:
         return instance;
     }
 
-    ~Game(); // 析构函数，负责资源释放
+    ~Game() override; // 析构函数，负责资源释放
     
     // 核心游戏循环方法
     void run(); // 游戏主循环
     void init(); // 初始化游戏资源和SDL
+
+    /**
+     * 解析命令行参数（需在init之前调用）
+     * --replay <文件> 回放录像，--fast 快速回放，--headless 无窗口快速回放，
+     * --record <文件> 指定录像保存位置，--seed <数字> 每局使用固定种子，
+     * --record-hashes <文件> 回放时另存状态哈希日志，--hash-detail 哈希日志保存每个实体的哈希；
+     * 基准测试：--scene main|boss 直接进入场景，--frames <N> 运行N个逻辑帧后退出，
+     * --difficulty <0-2> 指定难度，--bot [dodge|sweep] 由机器人操作（死亡后自动重新开始），
+     * --bot-upgrades <first|cycle|damage|rate|bounce|split|pierce> 机器人的升级选择策略，
+     * --bench-json <文件> 把每帧耗时和分阶段耗时写成JSON（基准测试和快速回放）；
+     * --alloc-budget <N> 每个逻辑帧最多允许N次堆分配，按整帧（事件、逻辑帧和渲染）检查，
+     * 一帧的预算为N乘以本帧推进的逻辑帧数（至少为N），超出时报错并断言（需开启分配统计）
+     */
+    void parseArgs(int argc, char* argv[]);
     void clean(); // 清理所有资源
-    void changeScene(Scene* scene); // 切换场景
+    void changeScene(Scene* scene) override; // 切换场景
+    void showRunResult(bool victory) override; // 进入结算场景
+    void returnToTitle() override; // 返回标题场景
 
     // 游戏循环的三个核心步骤
     void handleEvent(SDL_Event *event); // 处理输入事件
@@ -95,35 +197,56 @@ public:
     void render(); // 渲染画面
 
     // 文本渲染方法
-    SDL_FPoint renderTextCentered(std::string text, float posY, bool isTitle); // 居中渲染文本
-    void renderTextPos(std::string text, float posX, float posY, bool isLeft = true); // 指定位置渲染文本
+    SDL_FPoint renderTextCentered(std::string_view text, float posY, bool isTitle) override; // 居中渲染文本
+    void renderTextPos(std::string_view text, float posX, float posY, bool isLeft = true) override; // 指定位置渲染文本
+    SDL_Texture* loadTexture(const char* path, float* width = nullptr, float* height = nullptr) override; // 加载纹理并取得大小
+    TTF_Font* loadFont(const char* path, float size) override; // 加载字体
     
     // 背景系统方法
     void backgroundUpdate(float deltaTime); // 更新背景滚动
-    void renderBackground(); // 渲染星空背景
+    void renderBackground() override; // 渲染星空背景
 
     // Setter方法
-    void setFinalScore(int score) { finalScore = score; } // 设置最终得分
-    void insertLeaderBoard(int score, std::string name); // 插入排行榜记录
+    void setFinalScore(int score) override { finalScore = score; } // 设置最终得分
+    void insertLeaderBoard(int score, std::string name); // 插入排行榜记录并写入游戏记录
+    void beginRun() override; // 开始新的一局并选定随机种子
+    void endRun(const Weapon& weapon, BossProgress progress) override; // 记录本局结束时的状态
     void setIsFullscreen(bool fullscreen) { isFullscreen = fullscreen; } // 设置全屏状态
     void setTextColor(SDL_Color color) { textColor = color; } // 设置文本颜色
     void setDifficulty(int diff) { difficulty = diff; } // 设置游戏难度
 
     // Getter方法
     SDL_Window* getWindow() { return window; } // 获取SDL窗口
-    SDL_Renderer* getRenderer() { return renderer; } // 获取SDL渲染器
-    float getWindowWidth() { return windowWidth; } // 获取窗口宽度
-    float getWindowHeight() { return windowHeight; } // 获取窗口高度
+    SDL_Renderer* getRenderer() const override { return renderer; } // 获取SDL渲染器
+    float getWindowWidth() const override { return windowWidth; } // 获取窗口宽度
+    float getWindowHeight() const override { return windowHeight; } // 获取窗口高度
     int getFinalScore() { return finalScore; } // 获取最终得分
     bool getIsFullscreen() const { return isFullscreen; } // 获取全屏状态
     SDL_Color getTextColor() const { return textColor; } // 获取文本颜色
-    int getDifficulty() const { return difficulty; } // 获取当前难度
+    int getDifficulty() const override { return difficulty; } // 获取当前难度
+    const RunHistory& getRunHistory() const { return runHistory; } // 获取游戏记录
+    Uint64 getRunSeed() const override { return runSeed; } // 获取本局随机种子
+    int getExitCode() const { return exitCode; } // 获取进程退出码
+    Profiler& getProfiler() override { return profiler; } // 获取分阶段计时
+    FrameArena& getFrameArena() override { return frameArena; } // 本帧的临时内存
+    Uint64 getSimTicks() const override { return simTicks * 1000 / FPS; } // 本局模拟时间（毫秒），代替SDL_GetTicks用于游戏逻辑
+    const PlayerInput& getInput() const override { return input; } // 获取当前逻辑帧的输入
+    void requestPauseToggle() override { pendingInput.pauseToggle = true; } // 下一个逻辑帧切换暂停
+    void requestUpgradeChoice(int choice) override { pendingInput.upgradeChoice = static_cast<Sint8>(choice); } // 下一个逻辑帧选择武器升级
+
+    /**
+     * 决定本逻辑帧实际使用的输入：回放时取录像中的输入，录制时记录实时输入
+     * @param live 实时输入
+     * @return 本逻辑帧使用的输入
+     */
+    PlayerInput resolveInput(const PlayerInput& live);
+    void setFixedSeed(Uint64 seed) { fixedSeed = seed; useFixedSeed = true; } // 之后每局都使用指定种子
     
     /**
      * 根据当前难度返回对应的排行榜
      * @return 当前难度的排行榜引用
      */
-    std::multimap<int, std::string, std::greater<int>>& getLeaderBoard() {
+    LeaderBoard& getLeaderBoard() {
         switch(difficulty) {
             case 0: return leaderBoardEasy;
             case 1: return leaderBoardNormal;
@@ -137,7 +260,7 @@ public:
      * @param diff 难度等级
      * @return 指定难度的排行榜引用
      */
-    std::multimap<int, std::string, std::greater<int>>& getLeaderBoard(int diff) {
+    LeaderBoard& getLeaderBoard(int diff) {
         switch(diff) {
             case 0: return leaderBoardEasy;
             case 1: return leaderBoardNormal;
@@ -161,21 +284,25 @@ public:
     void setDefaultCursor();  // 恢复默认光标
 
     // 音乐管理方法
-    void playBgm(const std::string& musicPath, bool forceRestart = false); // 播放背景音乐
+    void playBgm(MusicId music, bool forceRestart = false) override; // 播放背景音乐（淡出当前音乐后淡入）
+    void preloadBgm(MusicId music) override; // 在后台预先打开背景音乐
     void stopBgm(); // 停止背景音乐
-    bool isPlayingBgm(const std::string& musicPath) const; // 检查是否正在播放指定音乐
-    void playSfx(const std::string& soundPath); // 播放音效
+    bool isPlayingBgm(MusicId music) const; // 检查最近请求播放的是否为指定音乐
+    void setBgmCrossfade(int ms) { audio.setCrossfadeTime(ms); } // 设置音乐切换时长（毫秒）
+    int getBgmCrossfade() const { return audio.getCrossfadeTime(); } // 获取音乐切换时长（毫秒）
+    void playSfx(SoundId sound) override { audio.playSfx(sound); } // 播放音效（本帧结束时统一派发）
     
     // 数据持久化方法
-    void saveData(); // 保存排行榜数据
-    void loadData(); // 加载排行榜数据
+    void saveData(); // 保存排行榜数据（交给后台线程写入）
+    void loadData(); // 加载排行榜和游戏记录
+    void loadLeaderBoards(); // 加载排行榜，必要时迁移旧版存档
     
     /**
      * 设置背景滚动速度
      * @param nearSpeed 近景滚动速度
      * @param farSpeed 远景滚动速度
      */
-    void setBackgroundSpeed(int nearSpeed, int farSpeed) {
+    void setBackgroundSpeed(int nearSpeed, int farSpeed) override {
         nearStars.speed = nearSpeed;
         farStars.speed = farSpeed;
     }
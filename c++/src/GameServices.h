@@ -0,0 +1,71 @@
+#ifndef GAME_SERVICES_H
+#define GAME_SERVICES_H
+
+#include "Object.h"
+#include "Input.h"
+#include "RunHistory.h"
+#include "SfxManager.h"
+#include "MusicManager.h"
+#include "FrameArena.h"
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+#include <string_view>
+
+class Scene;
+class Profiler;
+
+/**
+ * 游戏场景用到的外部服务：时钟、输入、随机种子、音频、渲染和场景流程
+ * 正常游戏由Game单例提供；SimWorld提供无窗口、无声音的实现，
+ * 同一进程中可以同时存在多个互不影响的模拟
+ */
+class GameServices
+{
+public:
+    virtual ~GameServices() = default;
+
+    // 时钟与输入
+    virtual Uint64 getSimTicks() const = 0; // 本局模拟时间（毫秒）
+    virtual const PlayerInput& getInput() const = 0; // 当前逻辑帧的输入
+    virtual void requestPauseToggle() = 0; // 下一个逻辑帧切换暂停
+    virtual void requestUpgradeChoice(int choice) = 0; // 下一个逻辑帧选择武器升级
+
+    // 本局设置
+    virtual float getWindowWidth() const = 0;  // 场地宽度
+    virtual float getWindowHeight() const = 0; // 场地高度
+    virtual int getDifficulty() const = 0;     // 游戏难度
+    virtual Uint64 getRunSeed() const = 0;     // 本局随机种子，场景的随机数流由它派生
+    virtual Profiler& getProfiler() = 0;       // 分阶段计时
+    virtual FrameArena& getFrameArena() = 0;   // 本帧的临时内存，下一帧开始时清空
+
+    // 音频
+    virtual void playSfx(SoundId sound) = 0; // 播放音效
+    virtual void playBgm(MusicId music, bool forceRestart = false) = 0; // 播放背景音乐
+    virtual void preloadBgm(MusicId music) = 0; // 预先打开背景音乐
+
+    /**
+     * 加载纹理并取得图片大小
+     * 没有渲染器时返回空指针，但仍会填写图片原始大小，游戏逻辑中的碰撞框依赖它
+     * @param path 图片路径
+     * @param width 输出图片宽度（可为空）
+     * @param height 输出图片高度（可为空）
+     * @return 纹理，失败或没有渲染器时为空
+     */
+    virtual SDL_Texture* loadTexture(const char* path, float* width = nullptr, float* height = nullptr) = 0;
+    virtual TTF_Font* loadFont(const char* path, float size) = 0; // 加载字体，没有渲染器时为空
+    virtual SDL_Renderer* getRenderer() const = 0; // 渲染器，无窗口模拟时为空
+    virtual SDL_FPoint renderTextCentered(std::string_view text, float posY, bool isTitle) = 0; // 居中渲染文本
+    virtual void renderTextPos(std::string_view text, float posX, float posY, bool isLeft = true) = 0; // 指定位置渲染文本
+    virtual void renderBackground() = 0; // 渲染星空背景
+    virtual void setBackgroundSpeed(int nearSpeed, int farSpeed) = 0; // 设置背景滚动速度
+
+    // 场景流程
+    virtual void changeScene(Scene* scene) = 0; // 切换场景（主场景进入Boss战）
+    virtual void beginRun() = 0; // 开始新的一局
+    virtual void endRun(const Weapon& weapon, BossProgress progress) = 0; // 记录本局结束时的状态
+    virtual void setFinalScore(int score) = 0; // 设置最终得分
+    virtual void showRunResult(bool victory) = 0; // 本局结束，进入结算
+    virtual void returnToTitle() = 0; // 中途返回标题
+};
+
+#endif // GAME_SERVICES_H
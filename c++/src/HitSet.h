@@ -0,0 +1,65 @@
+#ifndef HIT_SET_H
+#define HIT_SET_H
+
+#include <SDL3/SDL.h>
+#include <type_traits>
+
+/**
+ * 子弹已击中的敌人集合（防止穿透子弹在连续几帧中重复造成伤害）
+ * 按敌人编号记录，编号在一局中不会重复使用，敌人被删除后实体下标重新使用也不会误判。
+ * 前8个编号直接存放，之后的写入256位的布隆过滤器：不会漏掉已击中的敌人，
+ * 极少数情况下把没击中过的敌人当作已击中（只在一颗子弹穿透8个以上敌人后才可能出现）
+ * 没有堆内存，可以直接按字节复制，能作为ECS组件存放（组件必须可以平凡复制）
+ */
+struct HitSet {
+    static constexpr int INLINE_CAPACITY = 8;
+
+    Uint32 ids[INLINE_CAPACITY] = {0}; // 前几个击中的敌人编号
+    Uint32 count = 0;                  // 击中的敌人总数
+    Uint64 bloom[4] = {0, 0, 0, 0};    // 超出部分的布隆过滤器
+
+    bool contains(Uint32 id) const
+    {
+        Uint32 stored = count < INLINE_CAPACITY ? count : INLINE_CAPACITY;
+        for (Uint32 i = 0; i < stored; i++) {
+            if (ids[i] == id) {
+                return true;
+            }
+        }
+        if (count <= INLINE_CAPACITY) {
+            return false;
+        }
+        Uint32 hash = mix(id);
+        return testBit(hash & 255) && testBit((hash >> 8) & 255);
+    }
+
+    void insert(Uint32 id)
+    {
+        if (count < INLINE_CAPACITY) {
+            ids[count] = id;
+        } else {
+            Uint32 hash = mix(id);
+            setBit(hash & 255);
+            setBit((hash >> 8) & 255);
+        }
+        count++;
+    }
+
+    void clear() { *this = HitSet(); }
+
+private:
+    // 连续的编号散列到不同的位
+    static Uint32 mix(Uint32 id)
+    {
+        id ^= id >> 16;
+        id *= 0x7FEB352Du;
+        id ^= id >> 15;
+        return id;
+    }
+    bool testBit(Uint32 bit) const { return (bloom[bit >> 6] >> (bit & 63)) & 1; }
+    void setBit(Uint32 bit) { bloom[bit >> 6] |= Uint64(1) << (bit & 63); }
+};
+
+static_assert(std::is_trivially_copyable<HitSet>::value, "HitSet must stay trivially copyable");
+
+#endif // HIT_SET_H
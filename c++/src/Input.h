@@ -0,0 +1,40 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <SDL3/SDL.h>
+
+// 按键位掩码
+enum InputKey : Uint8 {
+    INPUT_UP = 1 << 0,    // W 上移
+    INPUT_DOWN = 1 << 1,  // S 下移
+    INPUT_LEFT = 1 << 2,  // A 左移
+    INPUT_RIGHT = 1 << 3, // D 右移
+    INPUT_BOOST = 1 << 4, // J 加速
+    INPUT_BOSS = 1 << 5   // K 直接进入Boss战
+};
+
+// 一个逻辑帧的玩家输入，场景只通过它读取影响游戏逻辑的输入
+struct PlayerInput {
+    Uint8 keys = 0;            // 按住的按键（InputKey组合）
+    bool pauseToggle = false;  // 本帧切换暂停
+    Sint8 upgradeChoice = -1;  // 本帧选择的武器升级选项（-1表示未选择）
+
+    bool isDown(InputKey key) const { return (keys & key) != 0; }
+
+    // 打包为16位整数：低6位按键，第6位暂停，第7-9位升级选项+1
+    Uint16 pack() const
+    {
+        return static_cast<Uint16>((keys & 0x3F) | (pauseToggle ? 0x40 : 0) | (((upgradeChoice + 1) & 0x7) << 7));
+    }
+
+    static PlayerInput unpack(Uint16 value)
+    {
+        PlayerInput input;
+        input.keys = static_cast<Uint8>(value & 0x3F);
+        input.pauseToggle = (value & 0x40) != 0;
+        input.upgradeChoice = static_cast<Sint8>(((value >> 7) & 0x7) - 1);
+        return input;
+    }
+};
+
+#endif // INPUT_H
@@ -0,0 +1,147 @@
+#include "MotionPath.h"
+#include <cmath>
+
+namespace
+{
+    constexpr int STEPS_PER_SEGMENT = 32; // 计算弧长时每段曲线细分成的直线数
+
+    SDL_FPoint catmullRom(SDL_FPoint p0, SDL_FPoint p1, SDL_FPoint p2, SDL_FPoint p3, float t)
+    {
+        float t2 = t * t;
+        float t3 = t2 * t;
+        auto axis = [&](float a, float b, float c, float d) {
+            return 0.5f * (2 * b + (c - a) * t + (2 * a - 5 * b + 4 * c - d) * t2 + (3 * b - a - 3 * c + d) * t3);
+        };
+        return {axis(p0.x, p1.x, p2.x, p3.x), axis(p0.y, p1.y, p2.y, p3.y)};
+    }
+
+    SDL_FPoint bezier(SDL_FPoint p0, SDL_FPoint p1, SDL_FPoint p2, SDL_FPoint p3, float t)
+    {
+        float u = 1 - t;
+        float w0 = u * u * u;
+        float w1 = 3 * u * u * t;
+        float w2 = 3 * u * t * t;
+        float w3 = t * t * t;
+        return {w0 * p0.x + w1 * p1.x + w2 * p2.x + w3 * p3.x, w0 * p0.y + w1 * p1.y + w2 * p2.y + w3 * p3.y};
+    }
+
+    // 把曲线细分成折线，第一个点为第一个控制点
+    bool tessellate(const MotionPathDef& def, std::vector<SDL_FPoint>& polyline)
+    {
+        const SDL_FPoint* p = def.points;
+        int n = def.pointCount;
+        if (def.curve == PathCurve::CatmullRom) {
+            if (n < 2) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Path %s needs at least 2 points", def.name);
+                return false;
+            }
+            polyline.push_back(p[0]);
+            for (int i = 0; i + 1 < n; i++) {
+                // 首尾各延长一个点，曲线在端点处沿首尾两点的方向
+                SDL_FPoint before = i > 0 ? p[i - 1] : SDL_FPoint{2 * p[0].x - p[1].x, 2 * p[0].y - p[1].y};
+                SDL_FPoint after = i + 2 < n ? p[i + 2] : SDL_FPoint{2 * p[n - 1].x - p[n - 2].x, 2 * p[n - 1].y - p[n - 2].y};
+                for (int step = 1; step <= STEPS_PER_SEGMENT; step++) {
+                    polyline.push_back(catmullRom(before, p[i], p[i + 1], after, static_cast<float>(step) / STEPS_PER_SEGMENT));
+                }
+            }
+        } else {
+            if (n < 4 || (n - 1) % 3 != 0) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Path %s needs 3n+1 Bezier points, got %d", def.name, n);
+                return false;
+            }
+            polyline.push_back(p[0]);
+            for (int i = 0; i + 3 < n; i += 3) {
+                for (int step = 1; step <= STEPS_PER_SEGMENT; step++) {
+                    polyline.push_back(bezier(p[i], p[i + 1], p[i + 2], p[i + 3], static_cast<float>(step) / STEPS_PER_SEGMENT));
+                }
+            }
+        }
+        return true;
+    }
+}
+
+bool MotionPath::bake(const MotionPathDef& def)
+{
+    std::vector<SDL_FPoint> polyline;
+    if (!tessellate(def, polyline)) {
+        return false;
+    }
+
+    // 折线上每个点的累计弧长
+    std::vector<float> distances(polyline.size(), 0.0f);
+    for (size_t i = 1; i < polyline.size(); i++) {
+        float dx = polyline[i].x - polyline[i - 1].x;
+        float dy = polyline[i].y - polyline[i - 1].y;
+        distances[i] = distances[i - 1] + std::sqrt(dx * dx + dy * dy);
+    }
+    float total = distances.back();
+    if (total <= 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Path %s has zero length", def.name);
+        return false;
+    }
+
+    // 按弧长等距重新采样，间距取不超过SAMPLE_SPACING且能整除总长度的值
+    int intervals = static_cast<int>(std::ceil(total / SAMPLE_SPACING));
+    float step = total / intervals;
+    std::vector<SDL_FPoint> resampled;
+    resampled.reserve(intervals + 1);
+    size_t segment = 0;
+    for (int i = 0; i < intervals; i++) {
+        float target = i * step;
+        while (segment + 2 < polyline.size() && distances[segment + 1] < target) {
+            segment++;
+        }
+        float segmentLength = distances[segment + 1] - distances[segment];
+        float t = segmentLength > 0 ? (target - distances[segment]) / segmentLength : 0.0f;
+        const SDL_FPoint& a = polyline[segment];
+        const SDL_FPoint& b = polyline[segment + 1];
+        resampled.push_back({a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t});
+    }
+    resampled.push_back(polyline.back());
+
+    samples = std::move(resampled);
+    inverseSpacing = 1.0f / step;
+    length = total;
+    return true;
+}
+
+int MotionPath::segmentIndex(float distance, float& frac) const
+{
+    float t = distance * inverseSpacing;
+    int last = static_cast<int>(samples.size()) - 2;
+    int index = static_cast<int>(t);
+    if (index < 0) {
+        index = 0;
+    } else if (index > last) {
+        index = last;
+    }
+    frac = t - static_cast<float>(index);
+    return index;
+}
+
+SDL_FPoint MotionPath::sample(float distance) const
+{
+    if (distance <= 0) {
+        return samples.front();
+    }
+    if (distance >= length) {
+        // 走完后沿最后一段的方向继续
+        SDL_FPoint exit = direction(length);
+        float extra = distance - length;
+        return {samples.back().x + exit.x * extra, samples.back().y + exit.y * extra};
+    }
+    float frac;
+    int index = segmentIndex(distance, frac);
+    const SDL_FPoint& a = samples[index];
+    const SDL_FPoint& b = samples[index + 1];
+    return {a.x + (b.x - a.x) * frac, a.y + (b.y - a.y) * frac};
+}
+
+SDL_FPoint MotionPath::direction(float distance) const
+{
+    float frac;
+    int index = segmentIndex(distance, frac);
+    const SDL_FPoint& a = samples[index];
+    const SDL_FPoint& b = samples[index + 1];
+    return {(b.x - a.x) * inverseSpacing, (b.y - a.y) * inverseSpacing};
+}
@@ -0,0 +1,61 @@
+#ifndef MOTION_PATH_H
+#define MOTION_PATH_H
+
+#include <SDL3/SDL.h>
+#include <vector>
+
+// 控制点的插值方式
+enum class PathCurve : Uint8 {
+    CatmullRom, // 经过每个控制点的平滑曲线，至少2个点
+    Bezier      // 首尾相接的三次贝塞尔曲线：端点、控制点、控制点、端点……，共3n+1个点
+};
+
+/**
+ * 一条敌人移动路径的定义
+ * 控制点是相对生成位置的偏移（像素），路径应向左延伸到屏幕外；
+ * 走完后沿最后的方向继续直线移动
+ */
+struct MotionPathDef {
+    const char* name;          // 波次时间表中使用的名字
+    PathCurve curve;
+    const SDL_FPoint* points;
+    int pointCount;
+};
+
+/**
+ * 烘焙后的路径
+ * 加载时把曲线按弧长等距采样成一张表，敌人只需推进走过的距离，
+ * 每帧一次查表和一次线性插值就能得到位置，速度沿路径保持均匀
+ */
+class MotionPath
+{
+public:
+    static constexpr float SAMPLE_SPACING = 4.0f; // 采样间距（像素）
+
+    /**
+     * 按定义烘焙路径
+     * @param def 路径定义
+     * @return 控制点数量不符合曲线类型或路径长度为0时返回false，原内容不变
+     */
+    bool bake(const MotionPathDef& def);
+
+    /**
+     * 沿路径走过distance像素后相对起点的偏移
+     * @param distance 走过的距离，小于0时返回起点，超过长度后沿最后的方向延伸
+     */
+    SDL_FPoint sample(float distance) const;
+
+    // 走过distance像素时的前进方向（近似单位向量）
+    SDL_FPoint direction(float distance) const;
+
+    float getLength() const { return length; }
+
+private:
+    std::vector<SDL_FPoint> samples = {{0, 0}, {-1, 0}}; // 按弧长等距的采样点，至少两个
+    float inverseSpacing = 1.0f;                         // 相邻采样点弧长的倒数
+    float length = 1.0f;                                 // 路径总长度（像素）
+
+    int segmentIndex(float distance, float& frac) const;
+};
+
+#endif // MOTION_PATH_H
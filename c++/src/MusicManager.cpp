@@ -0,0 +1,191 @@
+#include "MusicManager.h"
+
+MusicManager::~MusicManager()
+{
+    clean();
+}
+
+const char* MusicManager::getPath(MusicId id)
+{
+    switch (id) {
+        case MusicId::Fantasy:   return "assets/music/幻想.mp3";
+        case MusicId::Classroom: return "assets/music/音乐教室.mp3";
+        case MusicId::Mouse:     return "assets/music/老鼠.mp3";
+        default:                 return "";
+    }
+}
+
+void MusicManager::init()
+{
+    if (initialized) {
+        return;
+    }
+    stopLoader = false;
+    loaderThread = std::thread(&MusicManager::loaderLoop, this);
+    initialized = true;
+}
+
+void MusicManager::clean()
+{
+    if (!initialized) {
+        return;
+    }
+
+    // 通知加载线程退出，等待正在进行的加载完成
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopLoader = true;
+        loadQueue.clear();
+    }
+    queueCondition.notify_one();
+    if (loaderThread.joinable()) {
+        loaderThread.join();
+    }
+
+    Mix_HaltMusic();
+    for (auto& track : tracks) {
+        if (track.music != nullptr) {
+            Mix_FreeMusic(track.music);
+            track.music = nullptr;
+        }
+        track.state = LoadState::Unloaded;
+    }
+    currentTrack = MusicId::None;
+    nextTrack = MusicId::None;
+    switchState = SwitchState::Idle;
+    initialized = false;
+}
+
+void MusicManager::preload(MusicId id)
+{
+    if (id == MusicId::None || !initialized) {
+        return;
+    }
+
+    // 只有未加载的曲目才进入加载队列
+    auto& track = tracks[static_cast<int>(id)];
+    LoadState expected = LoadState::Unloaded;
+    if (!track.state.compare_exchange_strong(expected, LoadState::Loading)) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        loadQueue.push_back(id);
+    }
+    queueCondition.notify_one();
+}
+
+void MusicManager::loaderLoop()
+{
+    while (true) {
+        MusicId id;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueCondition.wait(lock, [this] { return stopLoader || !loadQueue.empty(); });
+            if (stopLoader) {
+                return;
+            }
+            id = loadQueue.front();
+            loadQueue.pop_front();
+        }
+
+        // 打开和解析文件头在后台进行，不阻塞主线程
+        auto& track = tracks[static_cast<int>(id)];
+        track.music = Mix_LoadMUS(getPath(id));
+        if (track.music == nullptr) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load music %s: %s", getPath(id), SDL_GetError());
+            track.state.store(LoadState::Failed, std::memory_order_release);
+        } else {
+            track.state.store(LoadState::Ready, std::memory_order_release);
+        }
+    }
+}
+
+void MusicManager::play(MusicId id, bool forceRestart)
+{
+    if (id == MusicId::None) {
+        stop();
+        return;
+    }
+
+    // 如果正在播放（或即将播放）相同的音乐且不强制重启，则不做任何操作
+    if (!forceRestart && isPlaying(id)) {
+        return;
+    }
+
+    preload(id);
+    nextTrack = id;
+
+    if (Mix_PlayingMusic()) {
+        // 先淡出当前音乐，淡出完成后在update中淡入下一首
+        if (switchState != SwitchState::FadingOut) {
+            Mix_FadeOutMusic(crossfadeMs / 2);
+        }
+        switchState = SwitchState::FadingOut;
+    } else {
+        switchState = SwitchState::WaitingLoad;
+        startNext();
+    }
+}
+
+void MusicManager::stop()
+{
+    Mix_HaltMusic();
+    currentTrack = MusicId::None;
+    nextTrack = MusicId::None;
+    switchState = SwitchState::Idle;
+}
+
+void MusicManager::update()
+{
+    switch (switchState) {
+        case SwitchState::FadingOut:
+            if (!Mix_PlayingMusic()) {
+                currentTrack = MusicId::None;
+                switchState = SwitchState::WaitingLoad;
+                startNext();
+            }
+            break;
+        case SwitchState::WaitingLoad:
+            startNext();
+            break;
+        default:
+            break;
+    }
+}
+
+void MusicManager::startNext()
+{
+    auto& track = tracks[static_cast<int>(nextTrack)];
+    switch (track.state.load(std::memory_order_acquire)) {
+        case LoadState::Ready:
+            if (!Mix_FadeInMusic(track.music, -1, crossfadeMs / 2)) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to play music: %s", SDL_GetError());
+                currentTrack = MusicId::None;
+            } else {
+                currentTrack = nextTrack;
+            }
+            nextTrack = MusicId::None;
+            switchState = SwitchState::Idle;
+            break;
+        case LoadState::Failed:
+            // 加载失败时放弃切换，允许以后重新尝试
+            track.state = LoadState::Unloaded;
+            currentTrack = MusicId::None;
+            nextTrack = MusicId::None;
+            switchState = SwitchState::Idle;
+            break;
+        default:
+            // 仍在加载，下一帧再检查
+            break;
+    }
+}
+
+bool MusicManager::isPlaying(MusicId id) const
+{
+    if (switchState != SwitchState::Idle) {
+        return nextTrack == id;
+    }
+    return currentTrack == id && Mix_PlayingMusic();
+}
@@ -0,0 +1,93 @@
+#ifndef MUSIC_MANAGER_H
+#define MUSIC_MANAGER_H
+
+#include <SDL3/SDL.h>
+#include <SDL3_mixer/SDL_mixer.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+// 背景音乐曲目枚举，对应assets/music下的音乐文件
+enum class MusicId {
+    Fantasy,    // 幻想.mp3 - 开场、标题、设置、结算
+    Classroom,  // 音乐教室.mp3 - 主游戏场景
+    Mouse,      // 老鼠.mp3 - Boss战
+    Count,      // 曲目数量
+    None = Count // 无音乐
+};
+
+/**
+ * 背景音乐管理器
+ * 在后台线程中预先打开音乐文件，调用线程只负责启动播放，
+ * 切换曲目时先淡出当前音乐，再淡入下一首（SDL_mixer只有一条音乐通道）
+ */
+class MusicManager
+{
+public:
+    MusicManager() = default;
+    ~MusicManager();
+    MusicManager(const MusicManager&) = delete;
+    MusicManager& operator=(const MusicManager&) = delete;
+
+    void init();  // 启动后台加载线程
+    void clean(); // 停止线程并释放所有音乐
+
+    /**
+     * 在后台线程中预先打开曲目，已打开或正在打开时不做任何操作
+     * @param id 曲目
+     */
+    void preload(MusicId id);
+
+    /**
+     * 切换到指定曲目，当前音乐淡出后淡入新曲目
+     * @param id 曲目
+     * @param forceRestart 正在播放同一曲目时是否重新开始
+     */
+    void play(MusicId id, bool forceRestart = false);
+    void stop(); // 立即停止背景音乐
+    void update(); // 每帧调用，推进淡入淡出状态
+    bool isSwitching() const { return switchState != SwitchState::Idle; } // 是否有未完成的切换（需要继续调用update）
+
+    bool isPlaying(MusicId id) const; // 检查是否正在播放（或即将播放）指定曲目
+    void setCrossfadeTime(int ms) { crossfadeMs = ms < 0 ? 0 : ms; } // 设置切换总时长（毫秒）
+    int getCrossfadeTime() const { return crossfadeMs; } // 获取切换总时长（毫秒）
+
+    static const char* getPath(MusicId id); // 获取曲目文件路径
+
+private:
+    // 曲目加载状态
+    enum class LoadState { Unloaded, Loading, Ready, Failed };
+
+    // 切换状态
+    enum class SwitchState {
+        Idle,       // 无切换
+        FadingOut,  // 正在淡出当前曲目
+        WaitingLoad // 等待下一首曲目打开完成
+    };
+
+    struct Track {
+        Mix_Music* music = nullptr;                        // 由加载线程写入，Ready后只读
+        std::atomic<LoadState> state{LoadState::Unloaded}; // 加载状态
+    };
+
+    Track tracks[static_cast<int>(MusicId::Count)];
+    MusicId currentTrack = MusicId::None; // 当前播放的曲目
+    MusicId nextTrack = MusicId::None;    // 等待播放的曲目
+    SwitchState switchState = SwitchState::Idle;
+    int crossfadeMs = 1000;               // 淡出+淡入总时长
+
+    // 后台加载线程
+    std::thread loaderThread;
+    std::mutex queueMutex;
+    std::condition_variable queueCondition;
+    std::deque<MusicId> loadQueue;
+    bool stopLoader = false;
+    bool initialized = false;
+
+    void loaderLoop(); // 加载线程主循环
+    void startNext();  // 下一首已就绪时淡入播放
+};
+
+#endif // MUSIC_MANAGER_H
@@ -60,70 +60,48 @@ struct Player{
     Uint64 lastShootTime = 0;               // 上次射击的时间戳
     SDL_FlipMode flip = SDL_FLIP_NONE;      // 纹理翻转模式
     Weapon weapon;                          // 玩家武器
-    Player* next = nullptr;                 // 对象池链表的下一个节点指针
 };
 
-// 敌人结构体，存储敌人的状态和行为属性
+// 敌人的状态组件，只存放每个敌人不同的状态
+// 位置和尺寸在Transform中，外观和旋转角度在Sprite中，移动方式见EcsSystems.h中的敌人组件；
+// 纹理、尺寸、速度、射击方式等按类型共用，见EnemyArchetype.h
 struct Enemy{
-    SDL_Texture* texture = nullptr;         // 敌人的主要纹理
-    SDL_Texture* randomTextures[10] = {nullptr}; // 随机敌人的10种不同纹理
-    SDL_FPoint position = {0, 0};           // 敌人在屏幕上的位置
-    float width = 0, height = 0;            // 敌人的显示尺寸
-    float speed = 0;                        // 敌人移动速度
     int currentHealth = 0;                  // 敌人当前血量
     Uint32 lastShootTime = 0;               // 敌人上次射击时间
-    Uint32 coolDown = 0;                    // 敌人射击冷却时间
-    int type = 0;                           // 敌人类型：0-基础敌人，1-敌人1，2-敌人2
-    float rotationAngle = 0.0f;             // 敌人旋转角度（用于旋转类敌人）
-    float moveTimer = 0.0f;                 // 移动计时器（用于控制移动模式）
-    int currentTextureIndex = 0;            // 当前使用的纹理索引（随机敌人）
-    Enemy* next = nullptr;                  // 对象池链表指针
+    int type = 0;                           // 敌人类型（ENEMY_ARCHETYPES的下标）：0-基础敌人，1-敌人1，2-敌人2
+    Uint32 id = 0;                          // 本局内唯一的编号（生成时分配，不重复使用）
 };
 
 // 玩家子弹结构体
 struct ProjectilePlayer{
     SDL_Texture* texture = nullptr;         // 子弹纹理
-    SDL_FRect position = {0, 0, 0, 0};      // 子弹位置和尺寸
     float width = 0, height = 0;            // 子弹尺寸
     int speed = 800;                        // 子弹移动速度
     int damage = 1;                         // 子弹伤害值
-    SDL_FPoint direction = {1, 0};          // 子弹移动方向
-    int bounceCount = 0;                    // 反弹次数
-    int maxBounces = 3;                     // 最大反弹次数
-    std::vector<Enemy*> hitEnemies;         // 已击中的敌人列表（防止穿透子弹帧伤）
-    ProjectilePlayer* next = nullptr;       // 对象池链表指针
 };
 
 // 敌人子弹结构体
 struct ProjectileEnemy{
     SDL_Texture* texture = nullptr;         // 敌人子弹纹理
-    SDL_FPoint position = {0, 0};           // 子弹位置
-    SDL_FPoint direction = {0, 0};          // 子弹移动方向
     float width = 0;                        // 子弹宽度
     float height = 0;                       // 子弹高度
     int speed = 400;                        // 子弹速度
     int damage = 1;                         // 子弹伤害
-    ProjectileEnemy* next = nullptr;        // 对象池链表指针
 };
 
 // 爆炸特效结构体
 struct Explosion{
     SDL_Texture* texture = nullptr;         // 爆炸动画纹理
-    SDL_FPoint position = {0, 0};           // 爆炸发生位置
     float width = 0;                        // 爆炸效果宽度
     float height = 0;                       // 爆炸效果高度
-    int currentFrame = 0;                   // 当前播放帧
     int totlaFrame = 0;                     // 总帧数
-    Uint32 startTime = 0;                   // 爆炸开始时间
     Uint32 FPS = 10;                        // 动画播放帧率
-    Explosion* next = nullptr;              // 对象池链表指针
+    float frameSize = 0;                    // 纹理中单帧的边长
 };
 
 // 道具结构体
 struct Item{
     SDL_Texture* texture = nullptr;         // 道具纹理图像
-    SDL_FPoint position = {0, 0};           // 道具位置
-    SDL_FPoint direction = {0, 0};          // 道具移动方向
     float width = 0;                        // 道具宽度
     float height = 0;                       // 道具高度
     int speed = 200;                        // 道具移动速度
@@ -131,11 +109,8 @@ struct Item{
     ItemType type = ItemType::Life;         // 道具类型
     
     // 动画相关属性（用于有动画效果的道具如金币）
-    int currentFrame = 0;                   // 当前动画帧
     int totlaFrame = 1;                     // 总动画帧数
-    Uint32 startTime = 0;                   // 动画开始时间
     Uint32 FPS = 8;                         // 动画播放帧率
-    Item* next = nullptr;                   // 对象池链表指针
 };
 
 // 背景结构体，用于滚动背景效果
@@ -173,33 +148,24 @@ struct Slider {
     SDL_Color activeColor = {255, 255, 255, 255};   // 激活状态颜色
 };
 
-// Boss结构体，存储Boss敌人的属性
+// Boss结构体，存储Boss敌人的属性（位置、尺寸和纹理在ECS的Transform和Sprite组件中）
 struct Boss{
-    SDL_Texture* texture = nullptr;         // Boss纹理
-    SDL_FPoint position = {0, 0};           // Boss位置
-    float width = 0;                        // Boss宽度
-    float height = 0;                       // Boss高度
     int currentHealth = 1000;               // Boss当前血量
     int maxHealth = 1000;                   // Boss最大血量
     Uint32 lastShootTime = 0;               // Boss上次射击时间
     Uint32 coolDown = 100;                  // Boss射击冷却时间
     float shootAngle = 0.0f;                // Boss射击角度
-    int shootPattern = 0;                   // Boss弹幕模式
+    int shootPattern = 0;                   // 当前攻击阶段（BOSS_PHASES的下标）
     Uint32 patternChangeTime = 0;           // 弹幕模式切换时间
-    Boss* next = nullptr;                   // 对象池链表指针
 };
 
 // Boss子弹结构体
 struct ProjectileBoss{
     SDL_Texture* texture = nullptr;         // Boss子弹纹理
-    SDL_FPoint position = {0, 0};           // 子弹位置
-    SDL_FPoint direction = {0, 0};          // 子弹移动方向
     float width = 0;                        // 子弹宽度
     float height = 0;                       // 子弹高度
     int speed = 200;                        // 子弹速度
     int damage = 1;                         // 子弹伤害
-    float rotationAngle = 0.0f;             // 子弹旋转角度
-    ProjectileBoss* next = nullptr;         // 对象池链表指针
 };
 
 #endif // OBJECT_H  // 头文件结束标记
\ No newline at end of file
@@ -0,0 +1,66 @@
+#include "Profiler.h"
+#include <cstring>
+
+int Profiler::getZone(const char* name)
+{
+    // 区段很少，线性查找即可；同一个字符串常量先比较指针
+    for (size_t i = 0; i < zones.size(); i++) {
+        if (zones[i].name == name || std::strcmp(zones[i].name, name) == 0) {
+            return static_cast<int>(i);
+        }
+    }
+    Zone zone;
+    zone.name = name;
+    zones.push_back(zone);
+    return static_cast<int>(zones.size() - 1);
+}
+
+void Profiler::addSample(int zone, Uint64 ns)
+{
+    Zone& target = zones[zone];
+    target.totalNs += ns;
+    target.calls++;
+    if (ns > target.maxNs) {
+        target.maxNs = ns;
+    }
+}
+
+void Profiler::addAllocs(int zone, Uint64 count, Uint64 bytes)
+{
+    zones[zone].allocs += count;
+    zones[zone].allocBytes += bytes;
+}
+
+void Profiler::reset()
+{
+    zones.clear();
+}
+
+void Profiler::report(Uint64 wallNs, Uint64 ticks) const
+{
+    if (AllocTracker::isAvailable()) {
+        reportAllocs(ticks);
+    }
+    SDL_Log("%-20s %10s %10s %10s %10s %7s", "zone", "total ms", "calls", "us/tick", "max us", "share");
+    for (const Zone& zone : zones) {
+        double share = wallNs > 0 ? 100.0 * static_cast<double>(zone.totalNs) / static_cast<double>(wallNs) : 0.0;
+        double perTick = ticks > 0 ? static_cast<double>(zone.totalNs) / 1000.0 / static_cast<double>(ticks) : 0.0;
+        SDL_Log("%-20s %10.2f %10llu %10.2f %10.2f %6.1f%%",
+                zone.name,
+                static_cast<double>(zone.totalNs) / 1e6,
+                static_cast<unsigned long long>(zone.calls),
+                perTick,
+                static_cast<double>(zone.maxNs) / 1000.0,
+                share);
+    }
+}
+
+void Profiler::reportAllocs(Uint64 ticks) const
+{
+    SDL_Log("%-20s %12s %12s %12s", "zone", "allocs", "allocs/tick", "bytes/tick");
+    for (const Zone& zone : zones) {
+        double perTick = ticks > 0 ? static_cast<double>(zone.allocs) / static_cast<double>(ticks) : 0.0;
+        double bytesPerTick = ticks > 0 ? static_cast<double>(zone.allocBytes) / static_cast<double>(ticks) : 0.0;
+        SDL_Log("%-20s %12llu %12.2f %12.1f", zone.name, static_cast<unsigned long long>(zone.allocs), perTick, bytesPerTick);
+    }
+}
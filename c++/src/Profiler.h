@@ -0,0 +1,92 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "AllocTracker.h"
+#include <SDL3/SDL.h>
+#include <vector>
+
+/**
+ * 分阶段计时
+ * 每个区段按名字累计总耗时、调用次数和单次最长耗时，
+ * 未启用时ProfileScope不读取时钟，正常游戏几乎没有额外开销
+ */
+class Profiler
+{
+public:
+    // 一个计时区段的统计
+    struct Zone {
+        const char* name = nullptr; // 区段名（字符串常量）
+        Uint64 totalNs = 0;         // 累计耗时（纳秒）
+        Uint64 maxNs = 0;           // 单次最长耗时（纳秒）
+        Uint64 calls = 0;           // 调用次数
+        Uint64 allocs = 0;          // 堆分配次数（需开启分配统计，包含内层区段）
+        Uint64 allocBytes = 0;      // 堆分配字节数
+    };
+
+    void setEnabled(bool enabled) { this->enabled = enabled; }
+    bool isEnabled() const { return enabled; }
+
+    /**
+     * 按名字查找区段，不存在时新建
+     * @param name 区段名，必须是字符串常量
+     * @return 区段序号
+     */
+    int getZone(const char* name);
+    void addSample(int zone, Uint64 ns); // 记录一次耗时
+    void addAllocs(int zone, Uint64 count, Uint64 bytes); // 记录区段内的堆分配
+    void reset();                        // 清空统计
+    const std::vector<Zone>& getZones() const { return zones; }
+
+    /**
+     * 输出各区段的统计表
+     * @param wallNs 总耗时，用于计算占比
+     * @param ticks 逻辑帧数，用于计算每帧平均耗时
+     */
+    void report(Uint64 wallNs, Uint64 ticks) const;
+    void reportAllocs(Uint64 ticks) const; // 输出各区段的堆分配（需开启分配统计）
+
+private:
+    std::vector<Zone> zones;
+    bool enabled = false;
+};
+
+// 作用域计时：构造时开始，析构时把耗时记入区段
+class ProfileScope
+{
+public:
+    ProfileScope(Profiler& profiler, const char* name) : profiler(profiler)
+    {
+        if (profiler.isEnabled()) {
+            zone = profiler.getZone(name);
+#ifdef ALLOC_TRACKING
+            previousZone = AllocTracker::enterZone(name);
+            allocStart = AllocTracker::current();
+#endif
+            start = SDL_GetTicksNS();
+        }
+    }
+    ~ProfileScope()
+    {
+        if (zone >= 0) {
+            profiler.addSample(zone, SDL_GetTicksNS() - start);
+#ifdef ALLOC_TRACKING
+            AllocCounters now = AllocTracker::current();
+            profiler.addAllocs(zone, now.count - allocStart.count, now.bytes - allocStart.bytes);
+            AllocTracker::leaveZone(previousZone);
+#endif
+        }
+    }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    Profiler& profiler;
+    int zone = -1;
+    Uint64 start = 0;
+#ifdef ALLOC_TRACKING
+    const char* previousZone = nullptr;
+    AllocCounters allocStart;
+#endif
+};
+
+#endif // PROFILER_H
@@ -0,0 +1,125 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <SDL3/SDL.h>
+#include <utility>
+#include <vector>
+
+/**
+ * splitmix64，用于把一个64位种子展开成多个互不相关的状态
+ * @param state 计数器状态，每次调用后前进
+ */
+inline Uint64 splitMix64(Uint64& state)
+{
+    Uint64 z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+/**
+ * xoshiro256** 伪随机数生成器
+ * 状态只有32字节，生成一个数只需几次移位和乘法，
+ * 同一种子在所有平台上产生相同的序列（不依赖标准库分布的实现）
+ */
+class Rng
+{
+public:
+    explicit Rng(Uint64 seed = 0) { reseed(seed); }
+
+    // 用种子重置状态
+    void reseed(Uint64 seed)
+    {
+        Uint64 mix = seed;
+        for (auto& word : state) {
+            word = splitMix64(mix);
+        }
+    }
+
+    // 64位随机数
+    Uint64 next()
+    {
+        Uint64 result = rotl(state[1] * 5, 7) * 9;
+        Uint64 t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+    // [0, 1) 区间的浮点数，取高24位保证精度均匀
+    float nextFloat()
+    {
+        return static_cast<float>(next() >> 40) * (1.0f / 16777216.0f);
+    }
+
+    // [0, bound) 区间的整数（bound <= 0 时返回0）
+    int nextInt(int bound)
+    {
+        if (bound <= 0) {
+            return 0;
+        }
+        // 乘法映射代替取模，避免除法
+        return static_cast<int>(((next() >> 32) * static_cast<Uint64>(bound)) >> 32);
+    }
+
+    // [minValue, maxValue) 区间的浮点数
+    float range(float minValue, float maxValue)
+    {
+        return minValue + (maxValue - minValue) * nextFloat();
+    }
+
+    // 以probability的概率返回true
+    bool chance(float probability)
+    {
+        return nextFloat() < probability;
+    }
+
+    // Fisher-Yates洗牌，结果只取决于种子
+    template<typename T>
+    void shuffle(std::vector<T>& values)
+    {
+        for (size_t i = values.size(); i > 1; i--) {
+            size_t j = static_cast<size_t>(nextInt(static_cast<int>(i)));
+            std::swap(values[i - 1], values[j]);
+        }
+    }
+
+    // 内部状态（用于状态哈希）
+    Uint64 getState(int index) const { return state[index & 3]; }
+
+private:
+    Uint64 state[4] = {};
+
+    static Uint64 rotl(Uint64 x, int k)
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+};
+
+/**
+ * 一局游戏使用的随机数流
+ * 每个子系统一条独立的流，某个子系统多取或少取随机数不会影响其他子系统，
+ * 同一个种子完全决定一局游戏
+ */
+struct RngStreams {
+    Rng spawn;    // 敌人生成
+    Rng drops;    // 道具、金币掉落和武器升级选项
+    Rng boss;     // Boss行为
+    Rng cosmetic; // 纯视觉效果（敌人外观、爆炸位置），不影响游戏逻辑
+
+    // 从一局的种子派生所有流
+    void reseed(Uint64 runSeed)
+    {
+        Uint64 mix = runSeed;
+        spawn.reseed(splitMix64(mix));
+        drops.reseed(splitMix64(mix));
+        boss.reseed(splitMix64(mix));
+        cosmetic.reseed(splitMix64(mix));
+    }
+};
+
+#endif // RANDOM_H
@@ -0,0 +1,196 @@
+#include "Replay.h"
+#include "SaveStore.h"
+#include <cstring>
+
+namespace
+{
+    constexpr Uint8 MAGIC[4] = {'D', 'Q', 'R', 'P'};
+    constexpr Uint32 VERSION = 6; // 2: 游戏逻辑改用FastMath；3: 敌人按类型分组处理；4: 敌人摆动按时间积分；5: 玩家子弹和道具改用ECS存储；6: 敌人改用ECS按移动方式分原型存储，旧录像无法复现
+
+    void writeU32(std::vector<Uint8>& out, Uint32 value)
+    {
+        for (int i = 0; i < 4; i++) {
+            out.push_back(static_cast<Uint8>(value >> (i * 8)));
+        }
+    }
+
+    void writeU64(std::vector<Uint8>& out, Uint64 value)
+    {
+        for (int i = 0; i < 8; i++) {
+            out.push_back(static_cast<Uint8>(value >> (i * 8)));
+        }
+    }
+
+    // 变长整数：每字节7位数据，最高位表示后面还有字节
+    void writeVarint(std::vector<Uint8>& out, Uint32 value)
+    {
+        while (value >= 0x80) {
+            out.push_back(static_cast<Uint8>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<Uint8>(value));
+    }
+
+    struct Reader {
+        const Uint8* data;
+        size_t size;
+        size_t pos = 0;
+
+        bool readU8(Uint8& value)
+        {
+            if (pos + 1 > size) return false;
+            value = data[pos++];
+            return true;
+        }
+
+        bool readU32(Uint32& value)
+        {
+            if (pos + 4 > size) return false;
+            value = 0;
+            for (int i = 0; i < 4; i++) {
+                value |= static_cast<Uint32>(data[pos + i]) << (i * 8);
+            }
+            pos += 4;
+            return true;
+        }
+
+        bool readU64(Uint64& value)
+        {
+            if (pos + 8 > size) return false;
+            value = 0;
+            for (int i = 0; i < 8; i++) {
+                value |= static_cast<Uint64>(data[pos + i]) << (i * 8);
+            }
+            pos += 8;
+            return true;
+        }
+
+        bool readVarint(Uint32& value)
+        {
+            value = 0;
+            for (int shift = 0; shift < 35; shift += 7) {
+                Uint8 byte = 0;
+                if (!readU8(byte)) return false;
+                value |= static_cast<Uint32>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0) return true;
+            }
+            return false;
+        }
+    };
+}
+
+void Replay::begin(Uint64 runSeed, int runDifficulty)
+{
+    segments.clear();
+    seed = runSeed;
+    difficulty = runDifficulty;
+    tickCount = 0;
+    rewind();
+}
+
+void Replay::record(const PlayerInput& input)
+{
+    Uint16 packed = input.pack();
+    if (segments.empty() || segments.back().input != packed) {
+        segments.push_back({packed, 0});
+    }
+    segments.back().length++;
+    tickCount++;
+}
+
+std::vector<Uint8> Replay::encode() const
+{
+    std::vector<Uint8> out(MAGIC, MAGIC + 4);
+    writeU32(out, VERSION);
+    writeU64(out, seed);
+    out.push_back(static_cast<Uint8>(difficulty));
+    writeU32(out, tickCount);
+    writeU32(out, static_cast<Uint32>(segments.size()));
+    for (const auto& segment : segments) {
+        writeVarint(out, segment.length);
+        writeVarint(out, segment.input);
+    }
+    writeU32(out, SaveStore::crc32(out.data(), out.size()));
+    return out;
+}
+
+bool Replay::load(const std::string& path)
+{
+    std::vector<Uint8> data;
+    if (!SaveStore::readFile(path, data)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to open replay %s", path.c_str());
+        return false;
+    }
+    if (data.size() < 29 || std::memcmp(data.data(), MAGIC, 4) != 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Replay %s has an invalid header", path.c_str());
+        return false;
+    }
+
+    Reader tail{data.data(), data.size(), data.size() - 4};
+    Uint32 storedCrc = 0;
+    tail.readU32(storedCrc);
+    if (SaveStore::crc32(data.data(), data.size() - 4) != storedCrc) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Replay %s checksum mismatch", path.c_str());
+        return false;
+    }
+
+    Reader reader{data.data(), data.size() - 4, 4};
+    Uint32 version = 0;
+    Uint8 storedDifficulty = 0;
+    Uint32 storedTicks = 0;
+    Uint32 segmentCount = 0;
+    reader.readU32(version);
+    if (version != VERSION) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unsupported replay version %u", version);
+        return false;
+    }
+    reader.readU64(seed);
+    reader.readU8(storedDifficulty);
+    reader.readU32(storedTicks);
+    reader.readU32(segmentCount);
+
+    segments.clear();
+    Uint32 total = 0;
+    for (Uint32 i = 0; i < segmentCount; i++) {
+        Uint32 length = 0;
+        Uint32 input = 0;
+        if (!reader.readVarint(length) || !reader.readVarint(input) || length == 0 || input > 0xFFFF) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Replay %s has a malformed input stream", path.c_str());
+            segments.clear();
+            return false;
+        }
+        segments.push_back({static_cast<Uint16>(input), length});
+        total += length;
+    }
+    if (total != storedTicks) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Replay %s tick count mismatch", path.c_str());
+        segments.clear();
+        return false;
+    }
+
+    difficulty = storedDifficulty;
+    tickCount = storedTicks;
+    rewind();
+    return true;
+}
+
+bool Replay::next(PlayerInput& input)
+{
+    if (cursor >= segments.size()) {
+        return false;
+    }
+    input = PlayerInput::unpack(segments[cursor].input);
+    if (++cursorOffset >= segments[cursor].length) {
+        cursor++;
+        cursorOffset = 0;
+    }
+    playedTicks++;
+    return true;
+}
+
+void Replay::rewind()
+{
+    cursor = 0;
+    cursorOffset = 0;
+    playedTicks = 0;
+}
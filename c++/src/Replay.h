@@ -0,0 +1,80 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "Input.h"
+#include <SDL3/SDL.h>
+#include <string>
+#include <vector>
+
+// 录像状态
+enum class ReplayMode {
+    Off,       // 不录制也不回放
+    Recording, // 正在录制本局
+    Playback   // 正在回放录像
+};
+
+// 回放速度
+enum class PlaybackSpeed {
+    RealTime, // 与真实时间同步
+    Fast,     // 不等待真实时间，尽可能快
+    Headless  // 不创建可见窗口、不渲染，尽可能快
+};
+
+/**
+ * 录像：一局游戏的随机种子、难度和每个逻辑帧的输入
+ * 输入按游程编码，只在输入变化时新增一段（变长整数记录持续帧数），
+ * 一局几分钟的游戏通常只有几KB。文件格式（小端序）：
+ * "DQRP" | u32 版本 | u64 种子 | u8 难度 | u32 总帧数 | u32 段数 | 段数据 | u32 CRC32
+ * 每段: varint 持续帧数 | varint 打包后的输入
+ */
+class Replay
+{
+public:
+    /**
+     * 开始录制新的一局
+     * @param seed 本局随机种子
+     * @param difficulty 难度等级
+     */
+    void begin(Uint64 seed, int difficulty);
+
+    void record(const PlayerInput& input); // 追加一帧输入
+    std::vector<Uint8> encode() const;     // 编码为文件内容
+
+    /**
+     * 读取录像文件并回到开头
+     * @return 文件完整且校验通过时返回true
+     */
+    bool load(const std::string& path);
+
+    /**
+     * 回放下一帧输入
+     * @param input 输出的输入状态
+     * @return 录像已播放完时返回false
+     */
+    bool next(PlayerInput& input);
+    void rewind(); // 回到录像开头
+
+    Uint64 getSeed() const { return seed; }
+    int getDifficulty() const { return difficulty; }
+    Uint32 getTickCount() const { return tickCount; }
+    Uint32 getPlayedTicks() const { return playedTicks; }
+
+private:
+    // 一段连续相同的输入
+    struct Segment {
+        Uint16 input = 0; // 打包后的输入
+        Uint32 length = 0; // 持续帧数
+    };
+
+    std::vector<Segment> segments;
+    Uint64 seed = 0;
+    int difficulty = 1;
+    Uint32 tickCount = 0;
+
+    // 回放位置
+    size_t cursor = 0;
+    Uint32 cursorOffset = 0;
+    Uint32 playedTicks = 0;
+};
+
+#endif // REPLAY_H
@@ -0,0 +1,284 @@
+#include "RunHistory.h"
+#include "AsyncWriter.h"
+#include "SaveStore.h"
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    constexpr Uint8 MAGIC[4] = {'D', 'Q', 'R', 'H'};
+    constexpr Uint32 VERSION = 1;
+    constexpr size_t HEADER_SIZE = 12;  // 魔数 + 版本 + 记录长度
+    constexpr size_t RECORD_SIZE = 64;  // 单条记录长度（含CRC32）
+    constexpr size_t NAME_OFFSET = 25;
+    constexpr size_t CRC_OFFSET = 60;
+    static_assert(NAME_OFFSET + RunHistory::NAME_SIZE == CRC_OFFSET, "record layout mismatch");
+
+    void putU16(Uint8* out, Uint16 value)
+    {
+        out[0] = static_cast<Uint8>(value);
+        out[1] = static_cast<Uint8>(value >> 8);
+    }
+
+    void putU32(Uint8* out, Uint32 value)
+    {
+        for (int i = 0; i < 4; i++) {
+            out[i] = static_cast<Uint8>(value >> (i * 8));
+        }
+    }
+
+    void putU64(Uint8* out, Uint64 value)
+    {
+        for (int i = 0; i < 8; i++) {
+            out[i] = static_cast<Uint8>(value >> (i * 8));
+        }
+    }
+
+    Uint16 getU16(const Uint8* in)
+    {
+        return static_cast<Uint16>(in[0] | (in[1] << 8));
+    }
+
+    Uint32 getU32(const Uint8* in)
+    {
+        Uint32 value = 0;
+        for (int i = 0; i < 4; i++) {
+            value |= static_cast<Uint32>(in[i]) << (i * 8);
+        }
+        return value;
+    }
+
+    Uint64 getU64(const Uint8* in)
+    {
+        Uint64 value = 0;
+        for (int i = 0; i < 8; i++) {
+            value |= static_cast<Uint64>(in[i]) << (i * 8);
+        }
+        return value;
+    }
+
+    void appendHeader(std::vector<Uint8>& out)
+    {
+        Uint8 header[HEADER_SIZE];
+        std::memcpy(header, MAGIC, 4);
+        putU32(header + 4, VERSION);
+        putU32(header + 8, static_cast<Uint32>(RECORD_SIZE));
+        out.insert(out.end(), header, header + HEADER_SIZE);
+    }
+
+    // 截断名字时不拆开UTF-8多字节字符
+    size_t clampNameLength(const std::string& name)
+    {
+        size_t length = std::min(name.size(), RunHistory::NAME_SIZE);
+        while (length > 0 && length < name.size() && (static_cast<Uint8>(name[length]) & 0xC0) == 0x80) {
+            length--;
+        }
+        return length;
+    }
+
+    void encodeRecord(const RunRecord& run, std::vector<Uint8>& out)
+    {
+        Uint8 bytes[RECORD_SIZE] = {};
+        putU32(bytes, static_cast<Uint32>(run.score));
+        putU32(bytes + 4, run.durationMs);
+        putU64(bytes + 8, static_cast<Uint64>(run.timestamp));
+        bytes[16] = run.weaponLevel;
+        bytes[17] = run.weaponDamage;
+        bytes[18] = run.bounceCount;
+        bytes[19] = run.splitCount;
+        putU16(bytes + 20, run.fireRatePercent);
+        bytes[22] = run.piercing ? 1 : 0;
+        bytes[23] = static_cast<Uint8>(run.bossProgress);
+        size_t length = clampNameLength(run.name);
+        bytes[24] = static_cast<Uint8>(length);
+        std::memcpy(bytes + NAME_OFFSET, run.name.data(), length);
+        putU32(bytes + CRC_OFFSET, SaveStore::crc32(bytes, CRC_OFFSET));
+        out.insert(out.end(), bytes, bytes + RECORD_SIZE);
+    }
+
+    bool decodeRecord(const Uint8* bytes, RunRecord& run)
+    {
+        if (SaveStore::crc32(bytes, CRC_OFFSET) != getU32(bytes + CRC_OFFSET)) {
+            return false;
+        }
+        size_t length = bytes[24];
+        if (length > RunHistory::NAME_SIZE || bytes[23] > static_cast<Uint8>(BossProgress::Defeated)) {
+            return false;
+        }
+        run.score = static_cast<int>(getU32(bytes));
+        run.durationMs = getU32(bytes + 4);
+        run.timestamp = static_cast<Sint64>(getU64(bytes + 8));
+        run.weaponLevel = bytes[16];
+        run.weaponDamage = bytes[17];
+        run.bounceCount = bytes[18];
+        run.splitCount = bytes[19];
+        run.fireRatePercent = getU16(bytes + 20);
+        run.piercing = bytes[22] != 0;
+        run.bossProgress = static_cast<BossProgress>(bytes[23]);
+        run.name.assign(reinterpret_cast<const char*>(bytes + NAME_OFFSET), length);
+        return true;
+    }
+}
+
+std::string RunHistory::getPath(int difficulty)
+{
+    switch (difficulty) {
+        case 0: return "assets/history_easy.bin";
+        case 2: return "assets/history_hard.bin";
+        default: return "assets/history_normal.bin";
+    }
+}
+
+RunHistory::Board& RunHistory::getBoard(int difficulty)
+{
+    return boards[(difficulty >= 0 && difficulty < BOARD_COUNT) ? difficulty : 1];
+}
+
+const RunHistory::Board& RunHistory::getBoard(int difficulty) const
+{
+    return boards[(difficulty >= 0 && difficulty < BOARD_COUNT) ? difficulty : 1];
+}
+
+void RunHistory::load(AsyncWriter* asyncWriter)
+{
+    writer = asyncWriter;
+
+    for (int difficulty = 0; difficulty < BOARD_COUNT; difficulty++) {
+        Board& board = boards[difficulty];
+        board.runs.clear();
+        board.hasFile = false;
+
+        std::string path = getPath(difficulty);
+        std::vector<Uint8> data;
+        if (!SaveStore::readFile(path, data)) {
+            rebuildIndex(board);
+            continue;
+        }
+
+        bool valid = data.size() >= HEADER_SIZE && std::memcmp(data.data(), MAGIC, 4) == 0 &&
+                     getU32(data.data() + 4) == VERSION && getU32(data.data() + 8) == RECORD_SIZE;
+        size_t badRecords = 0;
+        if (valid) {
+            size_t count = (data.size() - HEADER_SIZE) / RECORD_SIZE;
+            board.runs.reserve(count);
+            for (size_t i = 0; i < count; i++) {
+                RunRecord run;
+                if (decodeRecord(data.data() + HEADER_SIZE + i * RECORD_SIZE, run)) {
+                    board.runs.push_back(std::move(run));
+                } else {
+                    badRecords++;
+                }
+            }
+        } else {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Run history %s has an invalid header", path.c_str());
+        }
+        rebuildIndex(board);
+
+        // 有损坏记录或末尾有残缺记录时重写日志，保证后续追加的记录对齐
+        bool torn = valid && (data.size() - HEADER_SIZE) % RECORD_SIZE != 0;
+        if (!valid || badRecords > 0 || torn) {
+            if (badRecords > 0 || torn) {
+                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Run history %s: dropped %zu damaged records",
+                            path.c_str(), badRecords + (torn ? 1 : 0));
+            }
+            std::vector<Uint8> rewritten;
+            rewritten.reserve(HEADER_SIZE + board.runs.size() * RECORD_SIZE);
+            appendHeader(rewritten);
+            for (const auto& run : board.runs) {
+                encodeRecord(run, rewritten);
+            }
+            if (writer != nullptr) {
+                writer->replaceFile(path, std::move(rewritten));
+            } else {
+                AsyncWriter::writeFileAtomic(path, rewritten);
+            }
+        }
+        board.hasFile = true;
+    }
+}
+
+void RunHistory::record(int difficulty, const RunRecord& run)
+{
+    Board& board = getBoard(difficulty);
+    Uint32 index = static_cast<Uint32>(board.runs.size());
+    board.runs.push_back(run);
+    board.sortedScores.insert(std::upper_bound(board.sortedScores.begin(), board.sortedScores.end(), run.score), run.score);
+    insertTop(board, index);
+
+    // 新文件需要先写入文件头
+    std::vector<Uint8> bytes;
+    if (!board.hasFile) {
+        appendHeader(bytes);
+        board.hasFile = true;
+    }
+    encodeRecord(run, bytes);
+    if (writer != nullptr) {
+        writer->appendFile(getPath(difficulty), std::move(bytes));
+    }
+}
+
+std::vector<const RunRecord*> RunHistory::topRuns(int difficulty, size_t count) const
+{
+    const Board& board = getBoard(difficulty);
+    std::vector<const RunRecord*> result;
+    count = std::min(count, board.topIndex.size());
+    result.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        result.push_back(&board.runs[board.topIndex[i]]);
+    }
+    return result;
+}
+
+float RunHistory::percentile(int difficulty, int score) const
+{
+    const Board& board = getBoard(difficulty);
+    if (board.sortedScores.empty()) {
+        return 1.0f;
+    }
+    auto below = std::lower_bound(board.sortedScores.begin(), board.sortedScores.end(), score) - board.sortedScores.begin();
+    return static_cast<float>(below) / static_cast<float>(board.sortedScores.size());
+}
+
+size_t RunHistory::getRunCount(int difficulty) const
+{
+    return getBoard(difficulty).runs.size();
+}
+
+void RunHistory::rebuildIndex(Board& board)
+{
+    board.sortedScores.clear();
+    board.sortedScores.reserve(board.runs.size());
+    for (const auto& run : board.runs) {
+        board.sortedScores.push_back(run.score);
+    }
+    std::sort(board.sortedScores.begin(), board.sortedScores.end());
+
+    // 得分相同时先完成的记录排在前面
+    std::vector<Uint32> order(board.runs.size());
+    for (Uint32 i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    size_t count = std::min(order.size(), TOP_K);
+    std::partial_sort(order.begin(), order.begin() + count, order.end(), [&board](Uint32 a, Uint32 b) {
+        if (board.runs[a].score != board.runs[b].score) {
+            return board.runs[a].score > board.runs[b].score;
+        }
+        return a < b;
+    });
+    board.topIndex.assign(order.begin(), order.begin() + count);
+}
+
+void RunHistory::insertTop(Board& board, Uint32 index)
+{
+    int score = board.runs[index].score;
+    auto it = std::find_if(board.topIndex.begin(), board.topIndex.end(), [&board, score](Uint32 other) {
+        return board.runs[other].score < score;
+    });
+    if (it == board.topIndex.end() && board.topIndex.size() >= TOP_K) {
+        return;
+    }
+    board.topIndex.insert(it, index);
+    if (board.topIndex.size() > TOP_K) {
+        board.topIndex.pop_back();
+    }
+}
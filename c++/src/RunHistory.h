@@ -0,0 +1,94 @@
+#ifndef RUN_HISTORY_H
+#define RUN_HISTORY_H
+
+#include <SDL3/SDL.h>
+#include <string>
+#include <vector>
+
+class AsyncWriter;
+
+// Boss战进度
+enum class BossProgress : Uint8 {
+    None,     // 未进入Boss战
+    Reached,  // 进入Boss战后失败
+    Defeated  // 击败Boss
+};
+
+// 一局游戏的记录
+struct RunRecord {
+    int score = 0;                  // 得分
+    Sint64 timestamp = 0;           // 结束时间（Unix秒）
+    Uint32 durationMs = 0;          // 游戏时长（毫秒）
+    Uint8 weaponLevel = 1;          // 武器等级
+    Uint8 weaponDamage = 1;         // 武器伤害
+    Uint8 bounceCount = 0;          // 反弹次数
+    Uint8 splitCount = 1;           // 分裂数量
+    Uint16 fireRatePercent = 100;   // 射速倍率（百分比）
+    bool piercing = false;          // 是否穿透
+    BossProgress bossProgress = BossProgress::None; // Boss战进度
+    std::string name;               // 玩家名字
+};
+
+/**
+ * 游戏记录库
+ * 每个难度一个只追加的二进制日志（assets/history_*.bin），每条记录定长并带CRC32，
+ * 写入中途崩溃最多丢失最后一条记录。内存中维护排序后的得分表（百分位查询O(log n)）
+ * 和前TOP_K名的索引，十万条以上的记录也能即时查询
+ */
+class RunHistory
+{
+public:
+    static constexpr int BOARD_COUNT = 3;      // 难度数量
+    static constexpr size_t TOP_K = 100;       // 排名索引保留的记录数
+    static constexpr size_t NAME_SIZE = 35;    // 名字最大字节数（UTF-8）
+
+    /**
+     * 读取所有难度的记录，损坏的记录会被跳过并重写日志
+     * @param writer 后续追加记录使用的写入线程
+     */
+    void load(AsyncWriter* writer);
+
+    /**
+     * 追加一条记录（内存索引立即更新，磁盘写入交给写入线程）
+     * @param difficulty 难度等级
+     * @param run 游戏记录
+     */
+    void record(int difficulty, const RunRecord& run);
+
+    /**
+     * 获取得分最高的若干条记录
+     * @param difficulty 难度等级
+     * @param count 数量（不超过TOP_K）
+     * @return 按得分从高到低排列的记录
+     */
+    std::vector<const RunRecord*> topRuns(int difficulty, size_t count) const;
+
+    /**
+     * 查询得分超过了多少比例的记录
+     * @param difficulty 难度等级
+     * @param score 得分
+     * @return 0-1之间的比例，无记录时返回1
+     */
+    float percentile(int difficulty, int score) const;
+
+    size_t getRunCount(int difficulty) const; // 获取记录数量
+    static std::string getPath(int difficulty); // 获取日志文件路径
+
+private:
+    struct Board {
+        std::vector<RunRecord> runs;   // 按写入顺序保存的全部记录
+        std::vector<int> sortedScores; // 升序得分表
+        std::vector<Uint32> topIndex;  // 得分最高的TOP_K条记录下标
+        bool hasFile = false;          // 日志文件是否已写入文件头
+    };
+
+    Board boards[BOARD_COUNT];
+    AsyncWriter* writer = nullptr;
+
+    Board& getBoard(int difficulty);
+    const Board& getBoard(int difficulty) const;
+    void rebuildIndex(Board& board); // 读取完成后重建索引
+    void insertTop(Board& board, Uint32 index); // 把新记录插入排名索引
+};
+
+#endif // RUN_HISTORY_H
@@ -0,0 +1,216 @@
+#include "SaveStore.h"
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+namespace
+{
+    constexpr Uint8 MAGIC[4] = {'D', 'Q', 'W', 'S'};
+    constexpr size_t HEADER_SIZE = 12; // 魔数 + 版本 + 数据长度
+    constexpr size_t MAX_NAME_LENGTH = 255;
+
+    // 编译期生成CRC32查找表
+    constexpr std::array<Uint32, 256> makeCrcTable()
+    {
+        std::array<Uint32, 256> table{};
+        for (Uint32 i = 0; i < 256; i++) {
+            Uint32 value = i;
+            for (int bit = 0; bit < 8; bit++) {
+                value = (value & 1) ? (0xEDB88320u ^ (value >> 1)) : (value >> 1);
+            }
+            table[i] = value;
+        }
+        return table;
+    }
+
+    constexpr std::array<Uint32, 256> CRC_TABLE = makeCrcTable();
+
+    void writeU16(std::vector<Uint8>& out, Uint16 value)
+    {
+        out.push_back(static_cast<Uint8>(value));
+        out.push_back(static_cast<Uint8>(value >> 8));
+    }
+
+    void writeU32(std::vector<Uint8>& out, Uint32 value)
+    {
+        for (int i = 0; i < 4; i++) {
+            out.push_back(static_cast<Uint8>(value >> (i * 8)));
+        }
+    }
+
+    void putU32(std::vector<Uint8>& out, size_t offset, Uint32 value)
+    {
+        for (int i = 0; i < 4; i++) {
+            out[offset + i] = static_cast<Uint8>(value >> (i * 8));
+        }
+    }
+
+    // 带边界检查的顺序读取
+    struct Reader {
+        const Uint8* data;
+        size_t size;
+        size_t pos = 0;
+
+        bool readU8(Uint8& value)
+        {
+            if (pos + 1 > size) return false;
+            value = data[pos++];
+            return true;
+        }
+
+        bool readU16(Uint16& value)
+        {
+            if (pos + 2 > size) return false;
+            value = static_cast<Uint16>(data[pos] | (data[pos + 1] << 8));
+            pos += 2;
+            return true;
+        }
+
+        bool readU32(Uint32& value)
+        {
+            if (pos + 4 > size) return false;
+            value = 0;
+            for (int i = 0; i < 4; i++) {
+                value |= static_cast<Uint32>(data[pos + i]) << (i * 8);
+            }
+            pos += 4;
+            return true;
+        }
+    };
+}
+
+Uint32 SaveStore::crc32(const Uint8* data, size_t size)
+{
+    Uint32 crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; i++) {
+        crc = CRC_TABLE[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+std::vector<Uint8> SaveStore::encode(const LeaderBoard* const boards[BOARD_COUNT])
+{
+    std::vector<Uint8> out(MAGIC, MAGIC + 4);
+    writeU32(out, VERSION);
+    writeU32(out, 0); // 数据长度，编码完成后回填
+
+    for (int i = 0; i < BOARD_COUNT; i++) {
+        const LeaderBoard& board = *boards[i];
+        size_t count = board.size() > 0xFFFF ? 0xFFFF : board.size();
+        writeU16(out, static_cast<Uint16>(count));
+        for (const auto& entry : board) {
+            if (count-- == 0) {
+                break;
+            }
+            size_t length = entry.second.size() > MAX_NAME_LENGTH ? MAX_NAME_LENGTH : entry.second.size();
+            writeU32(out, static_cast<Uint32>(entry.first));
+            out.push_back(static_cast<Uint8>(length));
+            out.insert(out.end(), entry.second.begin(), entry.second.begin() + length);
+        }
+    }
+
+    size_t payloadSize = out.size() - HEADER_SIZE;
+    putU32(out, 8, static_cast<Uint32>(payloadSize));
+    writeU32(out, crc32(out.data() + HEADER_SIZE, payloadSize));
+    return out;
+}
+
+bool SaveStore::decode(const std::vector<Uint8>& data, LeaderBoard* const boards[BOARD_COUNT])
+{
+    if (data.size() < HEADER_SIZE + 4 || std::memcmp(data.data(), MAGIC, 4) != 0) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Save file has an invalid header");
+        return false;
+    }
+
+    Reader header{data.data(), data.size(), 4};
+    Uint32 version = 0;
+    Uint32 payloadSize = 0;
+    header.readU32(version);
+    header.readU32(payloadSize);
+    if (version != VERSION) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Unsupported save file version %u", version);
+        return false;
+    }
+    if (payloadSize != data.size() - HEADER_SIZE - 4) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Save file is truncated");
+        return false;
+    }
+
+    Reader tail{data.data(), data.size(), HEADER_SIZE + payloadSize};
+    Uint32 storedCrc = 0;
+    tail.readU32(storedCrc);
+    if (crc32(data.data() + HEADER_SIZE, payloadSize) != storedCrc) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Save file checksum mismatch");
+        return false;
+    }
+
+    // 先解码到临时排行榜，全部成功后再替换
+    LeaderBoard decoded[BOARD_COUNT];
+    Reader reader{data.data() + HEADER_SIZE, payloadSize};
+    for (int i = 0; i < BOARD_COUNT; i++) {
+        Uint16 count = 0;
+        if (!reader.readU16(count)) {
+            return false;
+        }
+        for (Uint16 n = 0; n < count; n++) {
+            Uint32 score = 0;
+            Uint8 length = 0;
+            if (!reader.readU32(score) || !reader.readU8(length) || reader.pos + length > reader.size) {
+                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Save file entry is malformed");
+                return false;
+            }
+            std::string name(reinterpret_cast<const char*>(reader.data + reader.pos), length);
+            reader.pos += length;
+            decoded[i].insert({static_cast<int>(score), name});
+        }
+    }
+
+    for (int i = 0; i < BOARD_COUNT; i++) {
+        *boards[i] = std::move(decoded[i]);
+    }
+    return true;
+}
+
+bool SaveStore::loadLegacy(const std::string& path, LeaderBoard* const boards[BOARD_COUNT])
+{
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    for (int i = 0; i < BOARD_COUNT; i++) {
+        boards[i]->clear();
+    }
+
+    std::string line;
+    LeaderBoard* currentBoard = nullptr;
+    while (std::getline(file, line)) {
+        if (line == "easy_scores") {
+            currentBoard = boards[0];
+        } else if (line == "normal_scores") {
+            currentBoard = boards[1];
+        } else if (line == "hard_scores") {
+            currentBoard = boards[2];
+        } else if (currentBoard != nullptr) {
+            std::istringstream iss(line);
+            int score;
+            std::string name;
+            if (iss >> score >> name) {
+                currentBoard->insert({score, name});
+            }
+        }
+    }
+    return true;
+}
+
+bool SaveStore::readFile(const std::string& path, std::vector<Uint8>& data)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
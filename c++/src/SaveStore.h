@@ -0,0 +1,51 @@
+#ifndef SAVE_STORE_H
+#define SAVE_STORE_H
+
+#include <SDL3/SDL.h>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+// 排行榜：得分从高到低排列
+using LeaderBoard = std::multimap<int, std::string, std::greater<int>>;
+
+/**
+ * 排行榜存档的二进制编码（小端序）
+ * 文件头: "DQWS" | u32 版本 | u32 数据长度
+ * 数据:   每个难度 u16 条目数，每条 i32 得分 | u8 名字长度 | 名字
+ * 文件尾: u32 数据部分的CRC32
+ */
+namespace SaveStore
+{
+    constexpr int BOARD_COUNT = 3;    // 难度数量（简单、普通、困难）
+    constexpr Uint32 VERSION = 1;     // 当前存档版本
+    constexpr const char* SAVE_PATH = "assets/save.bin";   // 二进制存档
+    constexpr const char* LEGACY_PATH = "assets/save.dat"; // 旧版文本存档
+
+    /**
+     * 把各难度排行榜编码为二进制存档
+     * @param boards 按难度排列的排行榜
+     * @return 完整的文件内容
+     */
+    std::vector<Uint8> encode(const LeaderBoard* const boards[BOARD_COUNT]);
+
+    /**
+     * 校验并解码二进制存档，失败时不修改排行榜
+     * @param data 文件内容
+     * @param boards 按难度排列的排行榜
+     * @return 格式和校验和都正确时返回true
+     */
+    bool decode(const std::vector<Uint8>& data, LeaderBoard* const boards[BOARD_COUNT]);
+
+    /**
+     * 读取旧版文本存档（easy_scores/normal_scores/hard_scores分段）
+     * @return 文件存在时返回true
+     */
+    bool loadLegacy(const std::string& path, LeaderBoard* const boards[BOARD_COUNT]);
+
+    bool readFile(const std::string& path, std::vector<Uint8>& data); // 读取整个文件
+    Uint32 crc32(const Uint8* data, size_t size); // 计算CRC32（IEEE多项式）
+}
+
+#endif // SAVE_STORE_H
@@ -4,4 +4,8 @@
 // 场景基类构造函数实现
 Scene::Scene() : game(Game::getInstance()) // 初始化列表：将game引用绑定到Game单例对象
 {
-}
\ No newline at end of file
+}
+
+Scene::Scene(GameServices& services) : game(services)
+{
+}
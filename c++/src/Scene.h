@@ -3,12 +3,15 @@
 
 #include <SDL3/SDL.h>  // SDL3核心库头文件
 
-class Game;  // 前向声明Game类，避免循环包含
+class GameServices;  // 前向声明场景用到的服务，避免循环包含
+class StateHasher; // 前向声明状态哈希
+struct BotView;    // 前向声明机器人视图
 
 // 场景基类，所有游戏场景都需要继承此抽象类
 class Scene{
 public:
-    Scene(); // 构造函数，初始化场景基本状态
+    Scene(); // 构造函数，使用Game单例提供的服务
+    explicit Scene(GameServices& services); // 使用指定的服务（无窗口模拟）
     virtual ~Scene() = default; // 虚析构函数，确保派生类正确析构
 
     virtual void init() = 0; // 纯虚函数：初始化场景资源和状态
@@ -16,8 +19,10 @@ public:
     virtual void render() = 0; // 纯虚函数：渲染场景内容到屏幕
     virtual void clean() = 0; // 纯虚函数：清理场景资源，释放内存
     virtual void handleEvent(SDL_Event* event) = 0; // 纯虚函数：处理用户输入事件
+    virtual void hashState(StateHasher& hasher) const {} // 把影响游戏逻辑的状态写入哈希（菜单等场景无需实现）
+    virtual void fillBotView(BotView& view) const {} // 填写机器人需要的场景信息（菜单等场景无需实现）
 protected:
-    Game& game; // 引用Game单例对象，用于访问全局游戏状态
+    GameServices& game; // 场景用到的服务（正常游戏中为Game单例）
 };
 
 #endif // SCENE_H  // 防止头文件重复包含的宏定义结束
\ No newline at end of file
@@ -1,116 +1,123 @@
-#include "SceneTitle.h"
 #include "SceneBoss.h"
-#include "SceneEnd.h"
-#include "SceneTitle.h"
 #include "Game.h"
+#include "StateHasher.h"
+#include "BotController.h"
+#include "FastMath.h"
 #include <SDL3/SDL.h>
 #include <SDL3_image/SDL_image.h>
 #include <cmath>
 
-constexpr double M_PI = 3.14159265358979323846;
-
 SceneBoss::SceneBoss(int playerScore) : Scene(), score(playerScore)
 {
     
 }
 
 // 添加新的构造函数重载，接受玩家状态
-SceneBoss::SceneBoss(int playerScore, const Player& mainPlayer) : Scene(), score(playerScore)
+SceneBoss::SceneBoss(int playerScore, const Player& mainPlayer) : SceneBoss(Game::getInstance(), playerScore, mainPlayer)
+{
+}
+
+SceneBoss::SceneBoss(GameServices& services, int playerScore, const Player& mainPlayer) : Scene(services), score(playerScore)
 {
     // 完全保留玩家的位置、血量、护盾状态
     player = mainPlayer;
     // 只在玩家位置过于靠右时进行微调
-    if (player.position.x > Game::getInstance().getWindowWidth() - 200) {
-        player.position.x = Game::getInstance().getWindowWidth() - 200;
+    if (player.position.x > game.getWindowWidth() - 200) {
+        player.position.x = game.getWindowWidth() - 200;
     }
     
     // 根据玩家血量正确设置死亡状态
     isDead = (player.currentHealth <= 0);
 }
 
+SceneBoss::SceneBoss(GameServices& services, int playerScore, const Player& mainPlayer, const RngStreams& streams)
+    : SceneBoss(services, playerScore, mainPlayer)
+{
+    rng = streams;
+    hasRng = true;
+}
+
 void SceneBoss::init()
 {
     // 播放Boss战音乐
-    Game::getInstance().playBgm("assets/music/老鼠.mp3");
+    game.playBgm(MusicId::Mouse);
     
     // 设置Boss场景背景滚动速度与主场景过渡时相同
-    Game::getInstance().setBackgroundSpeed(60, 40);
-    
-    auto& game = Game::getInstance();
-    uiHealth = IMG_LoadTexture(game.getRenderer(), "assets/image/Health UI Black.png");
-    uiShield = IMG_LoadTexture(game.getRenderer(), "assets/image/护盾.png");
-    scoreFont = TTF_OpenFont("assets/font/VonwaonBitmap-12px.ttf", 24);
+    game.setBackgroundSpeed(60, 40);
     
-    // 加载音效
-    sounds["player_shoot"] = Mix_LoadWAV("assets/sound/laser_shoot4.mp3");
-    sounds["boss_shoot"] = Mix_LoadWAV("assets/sound/xs_laser.mp3");
-    sounds["player_explode"] = Mix_LoadWAV("assets/sound/角色死亡音效.mp3");
-    sounds["boss_explode"] = Mix_LoadWAV("assets/sound/explosion3.mp3");
-    sounds["hit"] = Mix_LoadWAV("assets/sound/eff11.mp3");
+    uiHealth = game.loadTexture("assets/image/Health UI Black.png");
+    uiShield = game.loadTexture("assets/image/护盾.png");
+    scoreFont = game.loadFont("assets/font/VonwaonBitmap-12px.ttf", 24);
     
-    std::random_device rd;
-    gen = std::mt19937(rd());
-    dis = std::uniform_real_distribution<float>(0.0f, 1.0f);
+    // 直接进入Boss战时从本局种子派生随机数流
+    if (!hasRng) {
+        rng.reseed(game.getRunSeed());
+    }
     
     // 移除条件判断，确保每次都重新加载玩家纹理
-    player.texture = IMG_LoadTexture(game.getRenderer(), "assets/image/SpaceShip.png");
-    if (player.texture == nullptr) {
-        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to load player texture: %s", SDL_GetError());
-    }
-    SDL_GetTextureSize(player.texture, &player.width, &player.height);
+    player.texture = game.loadTexture("assets/image/SpaceShip.png", &player.width, &player.height);
     player.width /= 5;
     player.height /= 5;
     player.coolDown = 300;
     
     // 初始化Boss - 修改位置和动画设置
-    boss.texture = IMG_LoadTexture(game.getRenderer(), "assets/image/大青蛙.png");
-    SDL_GetTextureSize(boss.texture, &boss.width, &boss.height);
-    boss.width /= 2;
-    boss.height /= 2;
+    Transform body;
+    Sprite sprite;
+    sprite.texture = game.loadTexture("assets/image/大青蛙.png", &body.width, &body.height);
+    sprite.layer = RenderLayer::Boss;
+    body.width /= 2;
+    body.height /= 2;
     
     // Boss目标位置向右移动更多
-    bossTargetX = game.getWindowWidth() - boss.width +1; // Boss位置更靠右
-    boss.position.x = game.getWindowWidth() + 50; // 从屏幕右侧外开始
-    boss.position.y = game.getWindowHeight() / 2 - boss.height / 2;
+    bossTargetX = game.getWindowWidth() - body.width +1; // Boss位置更靠右
+    body.position.x = game.getWindowWidth() + 50; // 从屏幕右侧外开始
+    body.position.y = game.getWindowHeight() / 2 - body.height / 2;
     
+    Boss boss;
     boss.currentHealth = 1000;
     boss.maxHealth = 1000;
     boss.coolDown = 100;
     boss.shootAngle = 0.0f;
     boss.shootPattern = 0;
-    boss.patternChangeTime = static_cast<Uint32>(SDL_GetTicks());
+    boss.patternChangeTime = static_cast<Uint32>(game.getSimTicks());
+    bossEntity = world.create(body, sprite, boss);
     
     // 初始化Boss动画状态
     bossEntering = true;
     
     // 初始化子弹模板
-    projectilePlayerTemplate.texture = IMG_LoadTexture(game.getRenderer(), "assets/image/子弹.png");
-    SDL_GetTextureSize(projectilePlayerTemplate.texture, &projectilePlayerTemplate.width, &projectilePlayerTemplate.height);
+    projectilePlayerTemplate.texture = game.loadTexture("assets/image/子弹.png", &projectilePlayerTemplate.width, &projectilePlayerTemplate.height);
     projectilePlayerTemplate.width /= 4;
     projectilePlayerTemplate.height /= 4;
     
     // 加载Boss子弹纹理
-    projectileBossTemplate.texture = IMG_LoadTexture(game.getRenderer(), "assets/image/boss子弹.png");
-    SDL_GetTextureSize(projectileBossTemplate.texture, &projectileBossTemplate.width, &projectileBossTemplate.height);
+    projectileBossTemplate.texture = game.loadTexture("assets/image/boss子弹.png", &projectileBossTemplate.width, &projectileBossTemplate.height);
     projectileBossTemplate.width /= 3;
     projectileBossTemplate.height /= 3;
     
     // 初始化爆炸模板
-    explosionTemplate.texture = IMG_LoadTexture(game.getRenderer(), "assets/effect/explosion.png");
-    SDL_GetTextureSize(explosionTemplate.texture, &explosionTemplate.width, &explosionTemplate.height);
+    explosionTemplate.texture = game.loadTexture("assets/effect/explosion.png", &explosionTemplate.width, &explosionTemplate.height);
     explosionTemplate.totlaFrame = static_cast<int>(explosionTemplate.width / explosionTemplate.height);
+    explosionTemplate.frameSize = explosionTemplate.height;
     explosionTemplate.height *= 2.0f;
     explosionTemplate.width = explosionTemplate.height;
     
-    // 初始化对象池
-    playerBulletPool.initialize(projectilePlayerTemplate, 50);
-    bossBulletPool.initialize(projectileBossTemplate, 300);
-    explosionPool.initialize(explosionTemplate, 30);
+    // 展开Boss弹幕的方向表
+    for (int i = 0; i < BOSS_PATTERN_COUNT; i++) {
+        if (!compileBulletPattern(BOSS_PATTERNS[i], BOSS_EMITTERS, BOSS_EMITTER_COUNT, bossPrograms[i])) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to compile boss pattern %d", i);
+        }
+    }
 }
 
 void SceneBoss::update(float deltaTime)
 {
-    auto& game = Game::getInstance();
+    world.flush(); // 回收上一帧销毁的子弹和特效
+    
+    // 暂停切换来自逻辑帧输入，回放时才能复现
+    if (game.getInput().pauseToggle) {
+        isPaused = !isPaused;
+    }
     
     // 如果游戏暂停，跳过所有更新逻辑
     if (isPaused) {
@@ -149,13 +156,11 @@ void SceneBoss::update(float deltaTime)
 
 void SceneBoss::render()
 {   
-    auto& game = Game::getInstance();
-    
     // 添加背景渲染
     game.renderBackground();
     
-    renderPlayerProjectiles();
-    renderBossProjectiles();
+    renderSystem(world, game.getRenderer(), RenderLayer::PlayerShots); // 玩家子弹
+    renderSystem(world, game.getRenderer(), RenderLayer::Shots); // Boss子弹
     
     if (!isDead) {
         SDL_FRect playerRect = {player.position.x, player.position.y, player.width, player.height};
@@ -164,7 +169,7 @@ void SceneBoss::render()
     }
     
     renderBoss();
-    renderExplosions();
+    renderSystem(world, game.getRenderer(), RenderLayer::Effects); // 爆炸
     renderUI();
     
     if (isPaused) {
@@ -177,42 +182,40 @@ void SceneBoss::handleEvent(SDL_Event* event)
     if (event->type == SDL_EVENT_KEY_DOWN) {
         if (event->key.scancode == SDL_SCANCODE_ESCAPE) {
             // 返回主菜单而不是暂停
-            auto& game = Game::getInstance();
-            game.changeScene(new SceneTitle());
+            game.returnToTitle();
         }
         // 可以用其他键（如回车）来暂停
         else if (event->key.scancode == SDL_SCANCODE_RETURN) {
-            isPaused = !isPaused;
+            game.requestPauseToggle();
         }
     }
 }
 
 void SceneBoss::keyboardControl(float deltaTime)
 {
-    auto& game = Game::getInstance();
     if (isDead) {
         return;
     }
     
-    const bool* keyboardState = SDL_GetKeyboardState(NULL);
+    const PlayerInput& input = game.getInput();
     float currentSpeed = static_cast<float>(player.speed);
     
-    if (keyboardState[SDL_SCANCODE_J]) {
+    if (input.isDown(INPUT_BOOST)) {
         currentSpeed *= 1.3f;
     }
     
-    if (keyboardState[SDL_SCANCODE_W]) {
+    if (input.isDown(INPUT_UP)) {
         player.position.y -= deltaTime * currentSpeed;
     }
-    if (keyboardState[SDL_SCANCODE_S]) {
+    if (input.isDown(INPUT_DOWN)) {
         player.position.y += deltaTime * currentSpeed;
     }
-    if (keyboardState[SDL_SCANCODE_A]) {
+    if (input.isDown(INPUT_LEFT)) {
         player.position.x -= deltaTime * currentSpeed;
         // 移除翻转效果 - 注释掉这行
         // player.flip = SDL_FLIP_HORIZONTAL;
     }
-    if (keyboardState[SDL_SCANCODE_D]) {
+    if (input.isDown(INPUT_RIGHT)) {
         player.position.x += deltaTime * currentSpeed;
         // 移除翻转效果 - 注释掉这行
         // player.flip = SDL_FLIP_NONE;
@@ -225,7 +228,7 @@ void SceneBoss::keyboardControl(float deltaTime)
     if (player.position.y > game.getWindowHeight() - player.height) player.position.y = game.getWindowHeight() - player.height;
     
     // 自动射击
-    Uint32 currentTime = static_cast<Uint32>(SDL_GetTicks());
+    Uint32 currentTime = static_cast<Uint32>(game.getSimTicks());
     if (currentTime - player.lastShootTime > player.coolDown) {
         shootPlayer();
         player.lastShootTime = currentTime;
@@ -234,33 +237,30 @@ void SceneBoss::keyboardControl(float deltaTime)
 
 void SceneBoss::shootPlayer()
 {
-    auto* projectile = playerBulletPool.create();
-    if (projectile == nullptr) {
+    if (world.count<PlayerShot>() >= MAX_PLAYER_SHOTS) {
         return;
     }
     
-    *projectile = projectilePlayerTemplate;
-    
     // 始终向右发射，移除翻转判断
-    projectile->position.x = player.position.x + player.width;
-    projectile->direction = {1, 0}; // 始终向右
-    
-    projectile->position.y = player.position.y + player.height / 2 - projectile->height / 2;
-    projectile->bounceCount = 0;
-    projectilesPlayer.push_back(projectile);
-    Mix_PlayChannel(0, sounds["player_shoot"], 0);
+    SDL_FPoint position;
+    position.x = player.position.x + player.width;
+    position.y = player.position.y + player.height / 2 - projectilePlayerTemplate.height / 2;
+    spawnPlayerShot(world, projectilePlayerTemplate, position, {1, 0}, projectilePlayerTemplate.damage, 0);
+    game.playSfx(SoundId::PlayerShoot);
 }
 
 void SceneBoss::updateBoss(float deltaTime)
 {
-    auto& game = Game::getInstance();
+    ProfileScope zone(game.getProfiler(), "boss");
+    Boss& boss = bossState();
+    Transform& body = bossTransform();
     
     // 处理Boss出场动画
     if (bossEntering) {
-        if (boss.position.x > bossTargetX) {
-            boss.position.x -= bossEnterSpeed * deltaTime;
-            if (boss.position.x <= bossTargetX) {
-                boss.position.x = bossTargetX;
+        if (body.position.x > bossTargetX) {
+            body.position.x -= bossEnterSpeed * deltaTime;
+            if (body.position.x <= bossTargetX) {
+                body.position.x = bossTargetX;
                 bossEntering = false; // 出场动画完成
             }
         }
@@ -276,248 +276,137 @@ void SceneBoss::updateBoss(float deltaTime)
         return; // Boss死亡后直接返回，不执行后续射击逻辑
     }
     
-    Uint32 currentTime = static_cast<Uint32>(SDL_GetTicks());
+    Uint32 currentTime = static_cast<Uint32>(game.getSimTicks());
     
-    // 切换弹幕模式
-    if (currentTime - boss.patternChangeTime > 5000) {
-        boss.shootPattern = (boss.shootPattern + 1) % 3;
+    // 按阶段表切换弹幕，跳过当前难度不启用的阶段
+    if (currentTime - boss.patternChangeTime > BOSS_PHASES[boss.shootPattern].duration) {
+        do {
+            boss.shootPattern = (boss.shootPattern + 1) % BOSS_PHASE_COUNT;
+        } while (BOSS_PHASES[boss.shootPattern].minDifficulty > game.getDifficulty());
         boss.patternChangeTime = currentTime;
     }
     
     // Boss射击
     if (currentTime - boss.lastShootTime > boss.coolDown) {
-        switch (boss.shootPattern) {
-            case 0:
-                shootBossPattern1();
-                break;
-            case 1:
-                shootBossPattern2();
-                break;
-            case 2:
-                shootBossPattern3();
-                break;
-        }
+        fireBossPattern(BOSS_PHASES[boss.shootPattern].pattern);
         boss.lastShootTime = currentTime;
     }
     
     boss.shootAngle += 2.0f * deltaTime;
 }
 
-void SceneBoss::shootBossPattern1()
-{
-    int bulletCount = 16;
-    for (int i = 0; i < bulletCount; i++) {
-        auto* projectile = bossBulletPool.create();
-        if (projectile == nullptr) continue;
-        
-        *projectile = projectileBossTemplate;
-        projectile->position.x = boss.position.x + boss.width / 2 - projectile->width / 2;
-        projectile->position.y = boss.position.y + boss.height / 2 - projectile->height / 2;
-        
-        float angle = (2.0f * static_cast<float>(M_PI) * i / bulletCount) + boss.shootAngle;
-        projectile->direction.x = static_cast<float>(cos(angle));
-        projectile->direction.y = static_cast<float>(sin(angle));
-        projectile->rotationAngle = angle * 180.0f / static_cast<float>(M_PI);
-        
-        projectilesBoss.push_back(projectile);
-    }
-    Mix_PlayChannel(-1, sounds["boss_shoot"], 0);
-}
-
-void SceneBoss::shootBossPattern2()
+void SceneBoss::fireBossPattern(int pattern)
 {
-    int bulletCount = 8;
-    for (int i = 0; i < bulletCount; i++) {
-        auto* projectile = bossBulletPool.create();
-        if (projectile == nullptr) continue;
-        
-        *projectile = projectileBossTemplate;
-        projectile->position.x = boss.position.x + boss.width / 2 - projectile->width / 2;
-        projectile->position.y = boss.position.y + boss.height / 2 - projectile->height / 2;
-        
-        float angle = (2.0f * static_cast<float>(M_PI) * i / bulletCount) + boss.shootAngle * 3.0f;
-        projectile->direction.x = static_cast<float>(cos(angle));
-        projectile->direction.y = static_cast<float>(sin(angle));
-        projectile->rotationAngle = angle * 180.0f / static_cast<float>(M_PI);
-        
-        projectilesBoss.push_back(projectile);
-    }
-}
-
-void SceneBoss::shootBossPattern3()
-{
-    int bulletCount = 12;
-    float spreadAngle = static_cast<float>(M_PI) / 3.0f;
-    float playerAngle = static_cast<float>(atan2(player.position.y - boss.position.y, player.position.x - boss.position.x));
-    
-    for (int i = 0; i < bulletCount; i++) {
-        auto* projectile = bossBulletPool.create();
-        if (projectile == nullptr) continue;
-        
-        *projectile = projectileBossTemplate;
-        projectile->position.x = boss.position.x + boss.width / 2 - projectile->width / 2;
-        projectile->position.y = boss.position.y + boss.height / 2 - projectile->height / 2;
-        
-        float angle = playerAngle - spreadAngle / 2 + (spreadAngle * i / (bulletCount - 1));
-        projectile->direction.x = static_cast<float>(cos(angle));
-        projectile->direction.y = static_cast<float>(sin(angle));
-        projectile->rotationAngle = angle * 180.0f / static_cast<float>(M_PI);
-        
-        projectilesBoss.push_back(projectile);
+    const BulletProgram& program = bossPrograms[pattern];
+    const Transform& body = bossTransform();
+    BulletVolley volley;
+    volley.center = {body.position.x + body.width / 2, body.position.y + body.height / 2};
+    if (program.aimed) {
+        volley.aimAngle = fastAtan2(player.position.y - body.position.y, player.position.x - body.position.x);
+    }
+    volley.time = bossState().shootAngle;
+    volley.texture = projectileBossTemplate.texture;
+    volley.width = projectileBossTemplate.width;
+    volley.height = projectileBossTemplate.height;
+    volley.hitboxScale = 1.0f - 0.3f; // Boss子弹的碰撞体积只有贴图的70%
+    volley.damage = projectileBossTemplate.damage;
+    size_t active = world.count<EnemyShot>();
+    volley.capacity = active < MAX_BOSS_SHOTS ? MAX_BOSS_SHOTS - active : 0; // 超出上限的子弹不发射
+    fireBulletProgram(world, program, volley);
+    if (program.sound) {
+        game.playSfx(SoundId::BossShoot);
     }
 }
 
 void SceneBoss::updatePlayerProjectiles(float deltaTime)
 {
-    auto& game = Game::getInstance();
-    auto it = projectilesPlayer.begin();
-    while (it != projectilesPlayer.end()) {
-        auto projectile = *it;
-        
-        projectile->position.x += projectile->direction.x * projectile->speed * deltaTime;
-        projectile->position.y += projectile->direction.y * projectile->speed * deltaTime;
+    ProfileScope zone(game.getProfiler(), "player projectiles");
+    Boss& boss = bossState();
+    const Transform& body = bossTransform();
+    moveSystem<PlayerShot>(world, deltaTime);
+    world.each<PlayerShot, Transform>([&](Entity projectile, PlayerShot&, Transform& transform) {
+        const SDL_FPoint& position = transform.position;
         
         // 检查边界
-        if (projectile->position.x < -32 || projectile->position.x > game.getWindowWidth() + 32 ||
-            projectile->position.y < -32 || projectile->position.y > game.getWindowHeight() + 32) {
-            playerBulletPool.release(projectile);
-            it = projectilesPlayer.erase(it);
-            continue;
+        if (position.x < -32 || position.x > game.getWindowWidth() + 32 ||
+            position.y < -32 || position.y > game.getWindowHeight() + 32) {
+            world.destroy(projectile);
+            return;
         }
         
         // 检查与Boss的碰撞
         if (boss.currentHealth > 0 &&
-            projectile->position.x < boss.position.x + boss.width &&
-            projectile->position.x + projectile->width > boss.position.x &&
-            projectile->position.y < boss.position.y + boss.height &&
-            projectile->position.y + projectile->height > boss.position.y) {
+            position.x < body.position.x + body.width &&
+            position.x + transform.width > body.position.x &&
+            position.y < body.position.y + body.height &&
+            position.y + transform.height > body.position.y) {
             
             boss.currentHealth -= 10;
-            Mix_PlayChannel(-1, sounds["hit"], 0);
-            
-            playerBulletPool.release(projectile);
-            it = projectilesPlayer.erase(it);
-            continue;
+            game.playSfx(SoundId::Hit);
+            world.destroy(projectile);
         }
-        
-        ++it;
-    }
+    });
 }
 
 void SceneBoss::updateBossProjectiles(float deltaTime)
 {
-    auto& game = Game::getInstance();
-    auto it = projectilesBoss.begin();
-    while (it != projectilesBoss.end()) {
-        auto projectile = *it;
-        
-        projectile->position.x += projectile->direction.x * projectile->speed * deltaTime;
-        projectile->position.y += projectile->direction.y * projectile->speed * deltaTime;
-        
-        // 检查边界
-        if (projectile->position.x < -32 || projectile->position.x > game.getWindowWidth() + 32 ||
-            projectile->position.y < -32 || projectile->position.y > game.getWindowHeight() + 32) {
-            bossBulletPool.release(projectile);
-            it = projectilesBoss.erase(it);
-            continue;
+    ProfileScope zone(game.getProfiler(), "boss projectiles");
+    accelerationSystem(world, deltaTime);
+    moveSystem<EnemyShot>(world, deltaTime);
+    boundsSystem(world, game.getWindowWidth(), game.getWindowHeight());
+    
+    // 检查与玩家的碰撞 - 玩家碰撞体积减少到20%
+    float playerCollisionReduction = 0.8f; // 玩家碰撞体积减少80%，只保留20%
+    float playerCollisionWidth = player.width * (1.0f - playerCollisionReduction);
+    float playerCollisionHeight = player.height * (1.0f - playerCollisionReduction);
+    SDL_FRect playerRect = {
+        player.position.x + (player.width - playerCollisionWidth) / 2,
+        player.position.y + (player.height - playerCollisionHeight) / 2,
+        playerCollisionWidth,
+        playerCollisionHeight
+    };
+    collisionSystem(world, playerRect, [&](Entity shot, Transform&, Damage&) {
+        if (isDead) {
+            return;
         }
-        
-        // 检查与玩家的碰撞 - 玩家碰撞体积减少到20%
-        float playerCollisionReduction = 0.8f; // 玩家碰撞体积减少80%，只保留20%
-        float playerCollisionWidth = player.width * (1.0f - playerCollisionReduction);
-        float playerCollisionHeight = player.height * (1.0f - playerCollisionReduction);
-        float playerCollisionX = player.position.x + (player.width - playerCollisionWidth) / 2;
-        float playerCollisionY = player.position.y + (player.height - playerCollisionHeight) / 2;
-    
-        
-        // Boss子弹的碰撞体积
-        float bulletCollisionReduction = 0.3f;
-        float bulletCollisionWidth = projectile->width * (1.0f - bulletCollisionReduction);
-        float bulletCollisionHeight = projectile->height * (1.0f - bulletCollisionReduction);
-        float bulletCollisionX = projectile->position.x + (projectile->width - bulletCollisionWidth) / 2;
-        float bulletCollisionY = projectile->position.y + (projectile->height - bulletCollisionHeight) / 2;
-        
-        if (!isDead &&
-            bulletCollisionX < playerCollisionX + playerCollisionWidth &&
-            bulletCollisionX + bulletCollisionWidth > playerCollisionX &&
-            bulletCollisionY < playerCollisionY + playerCollisionHeight &&
-            bulletCollisionY + bulletCollisionHeight > playerCollisionY) {
-            
-            if (player.currentShield > 0) {
-                player.currentShield--;
-            } else {
-                player.currentHealth--;
-                if (player.currentHealth <= 0) {
-                    isDead = true;
-                    Mix_PlayChannel(-1, sounds["player_explode"], 0);
-                }
+        if (player.currentShield > 0) {
+            player.currentShield--;
+        } else {
+            player.currentHealth--;
+            if (player.currentHealth <= 0) {
+                isDead = true;
+                game.playSfx(SoundId::PlayerExplode);
             }
-            
-            bossBulletPool.release(projectile);
-            it = projectilesBoss.erase(it);
-            continue;
         }
-        
-        ++it;
-    }
+        world.destroy(shot);
+    });
 }
 
 void SceneBoss::updatePlayer(float deltaTime)
 {
-    auto& game = Game::getInstance();
+    ProfileScope zone(game.getProfiler(), "player");
     if (isDead && !bossDefeated) {
         game.setFinalScore(score);
     }
 }
 
-void SceneBoss::updateExplosions(float deltaTime)
-{
-    Uint32 currentTime = static_cast<Uint32>(SDL_GetTicks());
-    auto it = explosions.begin();
-    while (it != explosions.end()) {
-        auto explosion = *it;
-        
-        Uint32 frameTime = 1000 / explosion->FPS;
-        explosion->currentFrame = (currentTime - explosion->startTime) / frameTime;
-        
-        if (explosion->currentFrame >= explosion->totlaFrame) {
-            explosionPool.release(*it);
-            it = explosions.erase(it);
-        } else {
-            ++it;
-        }
-    }
-}
-
-void SceneBoss::renderPlayerProjectiles()
+void SceneBoss::updateExplosions(float)
 {
-    auto& game = Game::getInstance();
-    for (auto projectile : projectilesPlayer) {
-        SDL_FRect projectileRect = {projectile->position.x, projectile->position.y, projectile->width, projectile->height};
-        SDL_RenderTexture(game.getRenderer(), projectile->texture, NULL, &projectileRect);
-    }
-}
-
-void SceneBoss::renderBossProjectiles()
-{
-    auto& game = Game::getInstance();
-    for (auto projectile : projectilesBoss) {
-        SDL_FRect projectileRect = {projectile->position.x, projectile->position.y, projectile->width, projectile->height};
-        SDL_RenderTextureRotated(game.getRenderer(), projectile->texture, NULL, &projectileRect, projectile->rotationAngle, NULL, SDL_FLIP_NONE);
-    }
+    ProfileScope zone(game.getProfiler(), "explosions");
+    animationSystem(world, game.getSimTicks());
 }
 
 void SceneBoss::renderBoss()
 {
-    auto& game = Game::getInstance();
+    const Boss& boss = bossState();
+    const Transform& body = bossTransform();
     if (boss.currentHealth > 0) {
-        SDL_FRect bossRect = {boss.position.x, boss.position.y, boss.width, boss.height};
-        SDL_RenderTexture(game.getRenderer(), boss.texture, NULL, &bossRect);
+        renderSystem(world, game.getRenderer(), RenderLayer::Boss);
         
         // 渲染Boss血条
         float healthRatio = static_cast<float>(boss.currentHealth) / boss.maxHealth;
-        SDL_FRect healthBarBg = {boss.position.x, boss.position.y - 20, boss.width, 10};
-        SDL_FRect healthBar = {boss.position.x, boss.position.y - 20, boss.width * healthRatio, 10};
+        SDL_FRect healthBarBg = {body.position.x, body.position.y - 20, body.width, 10};
+        SDL_FRect healthBar = {body.position.x, body.position.y - 20, body.width * healthRatio, 10};
         
         SDL_SetRenderDrawColor(game.getRenderer(), 255, 0, 0, 255);
         SDL_RenderFillRect(game.getRenderer(), &healthBarBg);
@@ -526,24 +415,8 @@ void SceneBoss::renderBoss()
     }
 }
 
-void SceneBoss::renderExplosions()
-{
-    auto& game = Game::getInstance();
-    for (auto explosion : explosions) {
-        SDL_FRect srcRect = {
-            static_cast<float>(explosion->currentFrame * explosion->height),
-            0,
-            explosion->height,
-            explosion->height
-        };
-        SDL_FRect destRect = {explosion->position.x, explosion->position.y, explosion->width, explosion->height};
-        SDL_RenderTexture(game.getRenderer(), explosion->texture, &srcRect, &destRect);
-    }
-}
-
 void SceneBoss::renderUI()
 {
-    auto& game = Game::getInstance();
     // 渲染玩家血量（与SceneMain完全一致）
     float x = 10;
     float y = 10;
@@ -567,9 +440,9 @@ void SceneBoss::renderUI()
         SDL_RenderTexture(game.getRenderer(), uiShield, NULL, &shieldRect);
         
         // 渲染护盾数量文字
-        auto shieldText = "x" + std::to_string(player.currentShield);
+        const char* shieldText = game.getFrameArena().format("x%d", player.currentShield);
         SDL_Color color = {255, 255, 255, 255};
-        SDL_Surface* surface = TTF_RenderText_Solid(scoreFont, shieldText.c_str(), 0, color);
+        SDL_Surface* surface = TTF_RenderText_Solid(scoreFont, shieldText, 0, color);
         SDL_Texture* texture = SDL_CreateTextureFromSurface(game.getRenderer(), surface);
         SDL_FRect textRect = {x + size - 15, shieldY + 30, static_cast<float>(surface->w), static_cast<float>(surface->h)};
         SDL_RenderTexture(game.getRenderer(), texture, NULL, &textRect);
@@ -580,15 +453,15 @@ void SceneBoss::renderUI()
 
     
     // 渲染Boss血量文字
+    const Boss& boss = bossState();
     if (boss.currentHealth > 0) {
-        game.renderTextPos("Boss HP: " + std::to_string(boss.currentHealth) + "/" + std::to_string(boss.maxHealth), 
+        game.renderTextPos(game.getFrameArena().format("Boss HP: %d/%d", boss.currentHealth, boss.maxHealth), 
                           game.getWindowWidth() - 350, 10, true);
     }
 }
 
 void SceneBoss::renderPauseOverlay()
 {
-    auto& game = Game::getInstance();
     
     // 设置半透明黑色覆盖层
     SDL_SetRenderDrawBlendMode(game.getRenderer(), SDL_BLENDMODE_BLEND);
@@ -631,36 +504,33 @@ void SceneBoss::bossExplode()
 
 void SceneBoss::createSingleExplosion()
 {
-    auto explosion = explosionPool.create();
-    if (explosion != nullptr) {
+    if (world.count<Effect>() < MAX_EXPLOSIONS) {
         // 在Boss周围随机位置创建爆炸
-        float randomX = boss.position.x + (dis(gen) - 0.5f) * boss.width * 1.5f;
-        float randomY = boss.position.y + (dis(gen) - 0.5f) * boss.height * 1.5f;
-        
-        explosion->position.x = randomX - explosion->width / 2;
-        explosion->position.y = randomY - explosion->height / 2;
-        explosion->startTime = static_cast<Uint32>(SDL_GetTicks());
-        explosions.push_back(explosion);
+        const Transform& body = bossTransform();
+        float randomX = body.position.x + (rng.cosmetic.nextFloat() - 0.5f) * body.width * 1.5f;
+        float randomY = body.position.y + (rng.cosmetic.nextFloat() - 0.5f) * body.height * 1.5f;
+        spawnExplosion(world, explosionTemplate, {randomX, randomY}, static_cast<Uint32>(game.getSimTicks()));
     }
     
     // 播放爆炸音效
-    Mix_PlayChannel(-1, sounds["boss_explode"], 0);
+    game.playSfx(SoundId::BossExplode);
     explosionCount++;
 }
 
 void SceneBoss::changeSceneDelayed(float deltaTime, float delay)
 {
-    auto& game = Game::getInstance();
     timerEnd += deltaTime;
     if (timerEnd >= delay) {
         if (bossDefeated) {
             // Boss被击败，设置分数为9999并进入胜利场景
             game.setFinalScore(9999);
-            game.changeScene(new SceneEnd(true));  // 传递胜利状态
+            game.endRun(player.weapon, BossProgress::Defeated);
+            game.showRunResult(true);  // 传递胜利状态
         } else {
             // 玩家死亡，设置当前分数并进入失败场景
             game.setFinalScore(score);
-            game.changeScene(new SceneEnd(false)); // 传递失败状态
+            game.endRun(player.weapon, BossProgress::Reached);
+            game.showRunResult(false); // 传递失败状态
         }
     }
 }
@@ -685,8 +555,8 @@ void SceneBoss::clean()
     if (player.texture != nullptr) {
         SDL_DestroyTexture(player.texture);
     }
-    if (boss.texture != nullptr) {
-        SDL_DestroyTexture(boss.texture);
+    if (const Sprite* sprite = world.get<Sprite>(bossEntity)) {
+        SDL_DestroyTexture(sprite->texture);
     }
     if (projectilePlayerTemplate.texture != nullptr) {
         SDL_DestroyTexture(projectilePlayerTemplate.texture);
@@ -698,27 +568,99 @@ void SceneBoss::clean()
         SDL_DestroyTexture(explosionTemplate.texture);
     }
     
-    // 清理音效
-    for (auto& sound : sounds) {
-        if (sound.second != nullptr) {
-            Mix_FreeChunk(sound.second);
-        }
-    }
-    sounds.clear();
-    
-    // 清理对象列表
-    for (auto projectile : projectilesPlayer) {
-        playerBulletPool.release(projectile);
-    }
-    for (auto projectile : projectilesBoss) {
-        bossBulletPool.release(projectile);
-    }
-    for (auto explosion : explosions) {
-        explosionPool.release(explosion);
-    }
-    
-    projectilesPlayer.clear();
-    projectilesBoss.clear();
-    explosions.clear();
+    // 清理对象
+    world.clear(); // Boss、子弹和爆炸
 }
 
+
+// 按固定顺序把影响游戏逻辑的状态写入哈希，纹理、字体等只影响画面的字段不参与
+void SceneBoss::hashState(StateHasher& hasher) const
+{
+    hasher.beginEntity(HashCategory::Player);
+    hasher.add(player.position);
+    hasher.add(player.currentHealth);
+    hasher.add(player.currentShield);
+    hasher.add(player.lastShootTime);
+    hasher.add(player.weapon.damage);
+    hasher.add(player.weapon.fireRate);
+    hasher.add(player.weapon.bounceCount);
+    hasher.add(player.weapon.splitCount);
+    hasher.add(player.weapon.piercing);
+    hasher.add(player.weapon.level);
+    hasher.add(isDead);
+
+    const Boss& boss = bossState();
+    hasher.beginEntity(HashCategory::Boss);
+    hasher.add(bossTransform().position);
+    hasher.add(boss.currentHealth);
+    hasher.add(boss.lastShootTime);
+    hasher.add(boss.shootAngle);
+    hasher.add(boss.shootPattern);
+    hasher.add(boss.patternChangeTime);
+    hasher.add(bossEntering);
+    hasher.add(bossExploding);
+    hasher.add(explosionCount);
+    hasher.add(explosionTimer);
+
+    world.each<PlayerShot, Transform, Velocity>([&](Entity, const PlayerShot& projectile, const Transform& transform,
+                                                    const Velocity& velocity) {
+        hasher.beginEntity(HashCategory::PlayerShots);
+        hasher.add(transform.position);
+        hasher.add(velocity.direction);
+        hasher.add(projectile.bounceCount);
+        hasher.add(projectile.damage);
+    });
+    world.each<EnemyShot, Transform, Velocity, Sprite>([&](Entity, const EnemyShot&, const Transform& transform,
+                                                           const Velocity& velocity, const Sprite& sprite) {
+        hasher.beginEntity(HashCategory::EnemyShots);
+        hasher.add(transform.position);
+        hasher.add(velocity.direction);
+        hasher.add(velocity.speed);
+        hasher.add(sprite.rotation);
+    });
+    world.each<Effect, Transform, SpriteAnimation>([&](Entity, const Effect&, const Transform& transform, const SpriteAnimation& animation) {
+        hasher.beginEntity(HashCategory::Effects);
+        hasher.add(transform.position);
+        hasher.add(animation.startTime);
+    });
+    hasher.beginEntity(HashCategory::Effects);
+    hasher.add(world.count<PlayerShot>());
+    hasher.add(world.count<EnemyShot>());
+    hasher.add(world.count<Effect>());
+
+    hasher.beginEntity(HashCategory::Score);
+    hasher.add(score);
+    hasher.add(bossDefeated);
+    hasher.add(isPaused);
+    hasher.add(timerEnd);
+
+    hasher.beginEntity(HashCategory::Rng);
+    hasher.add(rng.spawn);
+    hasher.add(rng.drops);
+    hasher.add(rng.boss);
+    hasher.add(rng.cosmetic);
+}
+
+void SceneBoss::fillBotView(BotView& view) const
+{
+    view.controllable = !isDead && !isPaused;
+    view.player = {player.position.x, player.position.y, player.width, player.height};
+    view.playerSpeed = static_cast<float>(player.speed);
+    view.fieldWidth = game.getWindowWidth();
+    view.fieldHeight = game.getWindowHeight();
+
+    if (!bossDefeated) {
+        const Transform& body = bossTransform();
+        SDL_FRect bossRect = {body.position.x, body.position.y, body.width, body.height};
+        view.threats.push_back({bossRect, {0, 0}});
+        view.targets.push_back(bossRect);
+    }
+    // 与updateBossProjectiles一致，使用子弹的碰撞框
+    world.each<EnemyShot, Transform, Velocity, Hitbox>([&](Entity, const EnemyShot&, const Transform& transform,
+                                                           const Velocity& velocity, const Hitbox& hitbox) {
+        BotThreat threat;
+        threat.rect = hitboxRect(transform, hitbox);
+        threat.velocity = {velocity.direction.x * velocity.speed, velocity.direction.y * velocity.speed};
+        view.threats.push_back(threat);
+    });
+}
@@ -3,27 +3,31 @@
 
 #include "Scene.h"
 #include "Object.h"
-#include "ObjectPool.h"
+#include "EcsSystems.h"
+#include "BossPatterns.h"
+#include "Random.h"
 #include <SDL3_mixer/SDL_mixer.h>
 #include <SDL3_ttf/SDL_ttf.h>
-#include <list>
 #include <map>
-#include <random>
 
 class SceneBoss : public Scene
 {
 public:
     SceneBoss(int playerScore = 0);
     SceneBoss(int playerScore, const Player& mainPlayer); // 构造函数
+    SceneBoss(GameServices& services, int playerScore, const Player& mainPlayer); // 使用指定的服务（无窗口模拟）
+    SceneBoss(GameServices& services, int playerScore, const Player& mainPlayer, const RngStreams& streams); // 沿用主场景的随机数流
     void update(float deltaTime) override;
     void render() override;
     void handleEvent(SDL_Event* event) override;
     void init() override;
     void clean() override;
+    void hashState(StateHasher& hasher) const override;
+    void fillBotView(BotView& view) const override;
 
 private:
     Player player;                          // 玩家对象
-    Boss boss;                              // Boss对象
+    Entity bossEntity;                      // Boss实体（Transform、Sprite和Boss组件）
     TTF_Font* scoreFont;                    // 分数字体
     SDL_Texture* uiHealth;                  // 血量UI纹理
     SDL_Texture* uiShield;                  // 护盾UI纹理
@@ -45,30 +49,23 @@ private:
     float bossTargetX;                      // Boss目标X位置
     float bossEnterSpeed = 100.0f;          // Boss出场速度
     
-    std::mt19937 gen;                       // 随机数生成器
-    std::uniform_real_distribution<float> dis; // 随机数分布器
+    RngStreams rng;                         // 本局的随机数流
+    bool hasRng = false;                    // 随机数流是否由主场景传入
     
     // 模板对象
     ProjectilePlayer projectilePlayerTemplate;
     ProjectileBoss projectileBossTemplate;
     Explosion explosionTemplate;
     
-    // 游戏对象容器
-    std::list<ProjectilePlayer*> projectilesPlayer;
-    std::list<ProjectileBoss*> projectilesBoss;
-    std::list<Explosion*> explosions;
-    std::map<std::string, Mix_Chunk*> sounds;
-    
-    // 对象池
-    ObjectPool<ProjectilePlayer> playerBulletPool;
-    ObjectPool<ProjectileBoss> bossBulletPool;
-    ObjectPool<Explosion> explosionPool;
+    // Boss、子弹和爆炸
+    EcsWorld world;
+    static constexpr size_t MAX_PLAYER_SHOTS = 50;
+    static constexpr size_t MAX_BOSS_SHOTS = 300;
+    static constexpr size_t MAX_EXPLOSIONS = 30;
+    BulletProgram bossPrograms[BOSS_PATTERN_COUNT]; // 编译后的Boss弹幕
     
     // 渲染相关
     void renderUI();
-    void renderExplosions();
-    void renderPlayerProjectiles();
-    void renderBossProjectiles();
     void renderBoss();
     void renderPauseOverlay();
     
@@ -83,13 +80,15 @@ private:
     
     // 射击相关
     void shootPlayer();
-    void shootBossPattern1();  // 圆形弹幕
-    void shootBossPattern2();  // 螺旋弹幕
-    void shootBossPattern3();  // 扇形弹幕
+    void fireBossPattern(int pattern); // 按BOSS_PATTERNS发射一轮弹幕
     
     // 其他
     void bossExplode();
     void createSingleExplosion();           // 创建单个爆炸效果
+    Boss& bossState() { return *world.get<Boss>(bossEntity); }
+    const Boss& bossState() const { return *world.get<Boss>(bossEntity); }
+    Transform& bossTransform() { return *world.get<Transform>(bossEntity); }
+    const Transform& bossTransform() const { return *world.get<Transform>(bossEntity); }
 };
 
 #endif // SCENEBOSS_H
\ No newline at end of file
@@ -7,7 +7,9 @@
 void SceneEnd::init()
 {
     // 使用全局音乐管理播放幻想.mp3（不会重新开始播放）
-    Game::getInstance().playBgm("assets/music/幻想.mp3");
+    Game::getInstance().playBgm(MusicId::Fantasy);
+    // 预先打开游戏场景音乐，便于"重新开始"
+    Game::getInstance().preloadBgm(MusicId::Classroom);
 
     if (isVictory) {
         // 加载胜利结算图像
@@ -152,7 +154,14 @@ void SceneEnd::handleEvent(SDL_Event *event)
                 if (name == ""){
                     name = "无名氏";
                 }
-                Game::getInstance().insertLeaderBoard(Game::getInstance().getFinalScore(), name); // 插入排行榜
+                auto& game = Game::getInstance();
+                beatRatio = game.getRunHistory().percentile(game.getDifficulty(), game.getFinalScore()); // 插入前统计超过的比例
+                game.insertLeaderBoard(game.getFinalScore(), name); // 插入排行榜
+                // 排行榜在本局记录写入后读取一次，渲染时不再重新查询
+                leaderboard.clear();
+                for (const auto* run : game.getRunHistory().topRuns(game.getDifficulty(), 8)) {
+                    leaderboard.push_back(*run);
+                }
             }
             if (event->key.scancode == SDL_SCANCODE_BACKSPACE){
                 removeLastUTF8Char(name); // 删除最后一个字符
@@ -186,7 +195,7 @@ void SceneEnd::handleEvent(SDL_Event *event)
                     if (isPointInButton(buttons[i], mouseX, mouseY)) {
                         buttons[i].isPressed = true;
                         // 播放按钮点击音效
-                        Game::getInstance().playSfx("button_click");
+                        Game::getInstance().playSfx(SoundId::ButtonClick);
                         break;
                     }
                 }
@@ -251,9 +260,9 @@ void SceneEnd::renderPhase1() const
     auto& game = Game::getInstance();
     
     auto score = game.getFinalScore();
-    std::string scoreText = "你的得分是：" + std::to_string(score);
-    std::string resultText = isVictory ? "胜利了" : "失败了";  // 根据胜负显示不同文字
-    std::string instrutionText = "请输入你的名字，按回车键确认：";
+    const char* scoreText = game.getFrameArena().format("你的得分是：%d", score);
+    const char* resultText = isVictory ? "胜利了" : "失败了";  // 根据胜负显示不同文字
+    const char* instrutionText = "请输入你的名字，按回车键确认：";
     
     game.renderTextCentered(scoreText, 0.1f, false);
     
@@ -306,14 +315,17 @@ void SceneEnd::renderPhase2()
     game.renderTextCentered("得分榜", 0.05f, true); // 修改：添加f后缀
     auto posY = static_cast<float>(0.2 * game.getWindowHeight()); // 修改：显式转换为float
     auto i = 1;
-    for (const auto& item : game.getLeaderBoard()){
-        std::string name = std::to_string(i) + ". " + item.second;
-        std::string score = std::to_string(item.first);
+    for (const auto& run : leaderboard){
+        const char* name = game.getFrameArena().format("%d. %s", i, run.name.c_str());
+        const char* score = game.getFrameArena().format("%d", run.score);
         game.renderTextPos(name, 100.0f, posY); // 修改：添加f后缀
         game.renderTextPos(score, 100.0f, posY, false); // 修改：添加f后缀
         posY += 45.0f; // 修改：添加f后缀
         i++;
     }
+    // 与全部历史记录比较
+    const char* summary = game.getFrameArena().format("本局得分超过了 %d%% 的记录", static_cast<int>(beatRatio * 100.0f));
+    game.renderTextCentered(summary, 0.75f, false);
 }
 
 void SceneEnd::removeLastUTF8Char(std::string &str)
@@ -3,6 +3,7 @@
 
 #include "Scene.h"
 #include "Object.h"
+#include "RunHistory.h"
 #include <string>
 #include <vector>
 #include <SDL3_mixer/SDL_mixer.h>
@@ -34,6 +35,8 @@ private:
     bool isPointInButton(const Button& button, float x, float y); // 检查点是否在按钮内
     void removeLastUTF8Char(std::string& str); // 删除最后一个UTF8字符
     bool isVictory = false;              // 是否胜利
+    float beatRatio = 0.0f;              // 本局得分超过的历史记录比例
+    std::vector<RunRecord> leaderboard;  // 当前难度得分最高的记录，本局记录写入后读取一次
     SDL_Texture* victoryTexture;         // 胜利结算图像
 };
 
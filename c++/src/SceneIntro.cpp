@@ -6,7 +6,7 @@
 void SceneIntro::init()
 {
     // 使用全局音乐管理播放幻想.mp3（不会重新开始播放）
-    Game::getInstance().playBgm("assets/music/幻想.mp3");
+    Game::getInstance().playBgm(MusicId::Fantasy);
     
     // 加载GIF动画
     gifAnimation = IMG_LoadAnimation("assets/video/冻青蛙.gif");
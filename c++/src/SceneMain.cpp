@@ -1,22 +1,30 @@
-#include "SceneTitle.h"
 #include "SceneMain.h"
-#include "SceneEnd.h"
 #include "SceneBoss.h"
 #include "Game.h"
-#include "ObjectPool.h"
+#include "StateHasher.h"
+#include "BotController.h"
+#include "FastMath.h"
 #include <SDL3/SDL.h>
 #include <SDL3_image/SDL_image.h>
-#include <random>
 #include <cmath>
-#include <algorithm>  // 添加这个头文件用于std::shuffle
+#include <cstdio>
+#include <algorithm>
 #include <vector>     // 添加这个头文件用于std::vector
 
-// 将宏定义转换为 constexpr 常量
-constexpr double M_PI = 3.14159265358979323846;
-
 void SceneMain::update(float deltaTime)
 {
-    auto& game = Game::getInstance();
+    const PlayerInput& input = game.getInput();
+    world.flush(); // 回收上一帧销毁的子弹、道具和特效
+    
+    // 暂停和升级选择也属于逻辑帧输入，回放时才能复现
+    if (weaponUpgradeAvailable) {
+        if (input.upgradeChoice >= 0 && input.upgradeChoice < static_cast<int>(upgradeOptions.size())) {
+            selectedUpgrade = input.upgradeChoice;
+            applyWeaponUpgrade(upgradeOptions[selectedUpgrade]);
+        }
+    } else if (input.pauseToggle) {
+        isPaused = !isPaused;
+    }
     
     // 如果武器升级暂停，只处理升级逻辑
     if (weaponUpgradePaused) {
@@ -33,9 +41,8 @@ void SceneMain::update(float deltaTime)
     
     // 检查是否需要开始Boss过渡
     if (shouldChangeToBoss) {
-        auto& game = Game::getInstance();
         // 传递玩家状态到Boss场景 - 使用正确的构造函数
-        game.changeScene(new SceneBoss(score, player));
+        game.changeScene(new SceneBoss(game, score, player, rng)); // 随机数流继续在Boss战中使用
         return;
     }
     
@@ -57,7 +64,7 @@ void SceneMain::update(float deltaTime)
     keyboardControl(deltaTime); // 处理玩家输入
     updatePlayerProjectiles(deltaTime); // 更新玩家子弹
     updateEnemyProjectiles(deltaTime); // 更新敌人子弹
-    spawEnemy(); // 生成敌人
+    spawEnemy(deltaTime); // 生成敌人
     updateEnemies(deltaTime); // 更新敌人
     updatePlayer(deltaTime); // 更新玩家状态
     updateExplosions(deltaTime); // 更新爆炸效果
@@ -69,8 +76,6 @@ void SceneMain::update(float deltaTime)
 
 void SceneMain::render()
 {
-    auto& game = Game::getInstance();
-    
     // 渲染背景
     game.renderBackground();
     
@@ -87,11 +92,11 @@ void SceneMain::render()
     }
     
     // 渲染其他游戏对象
-    renderEnemies();
-    renderPlayerProjectiles();
-    renderEnemyProjectiles();
-    renderExplosions();
-    renderItems();
+    renderSystem(world, game.getRenderer(), RenderLayer::Enemies); // 敌人
+    renderSystem(world, game.getRenderer(), RenderLayer::PlayerShots); // 玩家子弹
+    renderSystem(world, game.getRenderer(), RenderLayer::Shots); // 敌人子弹
+    renderSystem(world, game.getRenderer(), RenderLayer::Effects); // 爆炸
+    renderSystem(world, game.getRenderer(), RenderLayer::Items); // 道具
     renderUI();
     
     // 渲染过渡效果
@@ -119,12 +124,11 @@ void SceneMain::handleEvent(SDL_Event* event)
     
     if (event->type == SDL_EVENT_KEY_DOWN){
         if (event->key.scancode == SDL_SCANCODE_ESCAPE){
-            auto sceneTitle = new SceneTitle();
-            game.changeScene(sceneTitle); // 按ESC返回标题场景
+            game.returnToTitle(); // 按ESC返回标题场景
         }
         // 新增：回车键暂停/恢复游戏
         else if (event->key.scancode == SDL_SCANCODE_RETURN){
-            isPaused = !isPaused;
+            game.requestPauseToggle();
         }
     }
 }
@@ -133,10 +137,11 @@ void SceneMain::handleEvent(SDL_Event* event)
 void SceneMain::init()
 {
     // 游戏场景播放音乐教室.mp3
-    Game::getInstance().playBgm("assets/music/音乐教室.mp3");
-    uiHealth = IMG_LoadTexture(game.getRenderer(), "assets/image/Health UI Black.png"); // 读取血量UI
-    uiShield = IMG_LoadTexture(game.getRenderer(), "assets/image/护盾.png"); // 读取护盾UI（新增）
-    scoreFont = TTF_OpenFont("assets/font/VonwaonBitmap-12px.ttf", 24); // 载入字体
+    game.playBgm(MusicId::Classroom);
+    game.beginRun(); // 开始记录本局统计
+    uiHealth = game.loadTexture("assets/image/Health UI Black.png"); // 读取血量UI
+    uiShield = game.loadTexture("assets/image/护盾.png"); // 读取护盾UI（新增）
+    scoreFont = game.loadFont("assets/font/VonwaonBitmap-12px.ttf", 24); // 载入字体
     
     // 重置武器升级系统
     weaponUpgradeAvailable = false;
@@ -146,29 +151,11 @@ void SceneMain::init()
     selectedUpgrade = 0;
     
     // 加载衰减子弹纹理
-    bouncedBulletTexture = IMG_LoadTexture(game.getRenderer(), "assets/image/衰减子弹.png");
-    if (bouncedBulletTexture == nullptr) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load bounced bullet texture: %s", SDL_GetError());
-    }
-
-    // 读取音效资源
-    sounds["player_shoot"] = Mix_LoadWAV("assets/sound/laser_shoot4.mp3");
-    sounds["enemy_shoot"] = Mix_LoadWAV("assets/sound/xs_laser.mp3");
-    sounds["player_explode"] = Mix_LoadWAV("assets/sound/角色死亡音效.mp3");
-    sounds["enemy_explode"] = Mix_LoadWAV("assets/sound/explosion3.mp3");
-    sounds["hit"] = Mix_LoadWAV("assets/sound/eff11.mp3");
-    sounds["get_item"] = Mix_LoadWAV("assets/sound/eff5.mp3");
-
-    std::random_device rd;
-    gen = std::mt19937(rd());
-    dis = std::uniform_real_distribution<float>(0.0f, 1.0f);
+    bouncedBulletTexture = game.loadTexture("assets/image/衰减子弹.png");
+
+    rng.reseed(game.getRunSeed()); // 同一种子产生同一局游戏
     
-    player.texture = IMG_LoadTexture(game.getRenderer(), "assets/image/SpaceShip.png"); // 加载玩家纹理
-    if (player.texture == nullptr)
-    {
-        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to load player texture: %s", SDL_GetError());
-    }
-    SDL_GetTextureSize(player.texture, &player.width, &player.height);
+    player.texture = game.loadTexture("assets/image/SpaceShip.png", &player.width, &player.height); // 加载玩家纹理
     player.width /= 5;
     player.height /= 5;
     // 将玩家位置置于屏幕左侧中央
@@ -197,177 +184,78 @@ void SceneMain::init()
     }
     
     // 初始化各类模板对象
-    projectilePlayerTemplate.texture = IMG_LoadTexture(game.getRenderer(), "assets/image/子弹.png");
-    SDL_GetTextureSize(projectilePlayerTemplate.texture, &projectilePlayerTemplate.width, &projectilePlayerTemplate.height);
+    projectilePlayerTemplate.texture = game.loadTexture("assets/image/子弹.png", &projectilePlayerTemplate.width, &projectilePlayerTemplate.height);
     projectilePlayerTemplate.width /= 4;
     projectilePlayerTemplate.height /= 4;
 
-    // 敌人0模板 - 加载随机纹理
-    for (int i = 0; i < 10; i++) {
-        std::string texturePath = "assets/image/随机敌人" + std::to_string(i) + ".png";
-        enemyTemplate.randomTextures[i] = IMG_LoadTexture(game.getRenderer(), texturePath.c_str());
-        if (enemyTemplate.randomTextures[i] == nullptr) {
-            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load texture: %s", texturePath.c_str());
+    // 各类敌人共用的纹理和尺寸
+    for (int type = 0; type < ENEMY_ARCHETYPE_COUNT; type++) {
+        const EnemyArchetypeDef& def = ENEMY_ARCHETYPES[type];
+        EnemyArchetype& archetype = enemyArchetypes[type];
+        archetype.def = &def;
+        for (int i = 0; i < def.textureVariants && i < ENEMY_MAX_TEXTURE_VARIANTS; i++) {
+            char texturePath[256];
+            std::snprintf(texturePath, sizeof(texturePath), def.texturePath, i);
+            // 大小取第一个纹理的大小
+            archetype.textures[i] = i == 0 ? game.loadTexture(texturePath, &archetype.width, &archetype.height)
+                                           : game.loadTexture(texturePath);
         }
+        archetype.width /= def.sizeDivisor;
+        archetype.height /= def.sizeDivisor;
+        // 根据难度调整射击速度，未知难度按普通处理
+        archetype.coolDown = def.coolDown[difficulty >= 0 && difficulty <= 2 ? difficulty : 1];
     }
-    // 设置默认纹理为第一个随机纹理
-    enemyTemplate.texture = enemyTemplate.randomTextures[0];
-    SDL_GetTextureSize(enemyTemplate.texture, &enemyTemplate.width, &enemyTemplate.height);
-    enemyTemplate.width /= 4;
-    enemyTemplate.height /= 4;
-    enemyTemplate.speed = 140;
-    enemyTemplate.currentHealth = 7;
-    // 根据难度调整敌人射击速度
-    switch(difficulty) {
-        case 0: // 简单模式
-            enemyTemplate.coolDown = 2000;
-            break;
-        case 1: // 普通难度 - 保持原有敌人射击速度
-            enemyTemplate.coolDown = 2000;
-            break;
-        case 2: // 困难难度 - 提高敌人射击速度
-            enemyTemplate.coolDown = 1200; // 减少冷却时间，提高射击速度
-            break;
-        default:
-            enemyTemplate.coolDown = 2000;
-            break;
-    }
-    enemyTemplate.type = 0;  // 设置为敌人0类型
 
-    // 敌人1模板
-    enemyTemplate1.texture = IMG_LoadTexture(game.getRenderer(), "assets/image/敌人1.png");
-    SDL_GetTextureSize(enemyTemplate1.texture, &enemyTemplate1.width, &enemyTemplate1.height);
-    enemyTemplate1.width /= 3;
-    enemyTemplate1.height /= 3;
-    enemyTemplate1.speed = 200; // 更快
-    enemyTemplate1.currentHealth = 1; // 血量少
-    // 根据难度调整敌人1射击速度
-    switch(difficulty) {
-        case 0: // 简单模式
-            enemyTemplate1.coolDown = 1500;
-            break;
-        case 1: // 普通难度
-            enemyTemplate1.coolDown = 1500;
-            break;
-        case 2: // 困难难度 - 提高射击速度
-            enemyTemplate1.coolDown = 900;
-            break;
-        default:
-            enemyTemplate1.coolDown = 1500;
-            break;
+    // 烘焙敌人移动路径，失败的路径保持默认的直线
+    for (int i = 0; i < ENEMY_PATH_COUNT; i++) {
+        enemyPaths[i].bake(ENEMY_PATHS[i]);
     }
-    enemyTemplate1.type = 1;  // 设置为敌人1类型
 
-    // 敌人2模板
-    enemyTemplate2.texture = IMG_LoadTexture(game.getRenderer(), "assets/image/敌人2.png");
-    SDL_GetTextureSize(enemyTemplate2.texture, &enemyTemplate2.width, &enemyTemplate2.height);
-    enemyTemplate2.width /= 2;
-    enemyTemplate2.height /= 2;
-    enemyTemplate2.speed = 100; // 更慢
-    enemyTemplate2.currentHealth = 4; // 血量多
-    // 根据难度调整敌人2射击速度
-    switch(difficulty) {
-        case 0: // 简单模式
-            enemyTemplate2.coolDown = 3000;
-            break;
-        case 1: // 普通难度
-            enemyTemplate2.coolDown = 3000;
-            break;
-        case 2: // 困难难度 - 提高射击速度
-            enemyTemplate2.coolDown = 1800;
-            break;
-        default:
-            enemyTemplate2.coolDown = 3000;
-            break;
+    // 按难度读取敌人波次时间表，文件缺失时使用内置的随机生成
+    if (!waves.load(WaveSchedule::pathForDifficulty(difficulty))) {
+        waves.loadDefault();
     }
-    enemyTemplate2.type = 2;  // 设置为敌人2类型
 
-    projectileEnemyTemplate.texture = IMG_LoadTexture(game.getRenderer(), "assets/image/敌人子弹.png");
-    SDL_GetTextureSize(projectileEnemyTemplate.texture, &projectileEnemyTemplate.width, &projectileEnemyTemplate.height);
+    projectileEnemyTemplate.texture = game.loadTexture("assets/image/敌人子弹.png", &projectileEnemyTemplate.width, &projectileEnemyTemplate.height);
     projectileEnemyTemplate.width /= 2;
     projectileEnemyTemplate.height /= 2;
 
-    explosionTemplate.texture = IMG_LoadTexture(game.getRenderer(), "assets/effect/explosion.png");
-    SDL_GetTextureSize(explosionTemplate.texture, &explosionTemplate.width, &explosionTemplate.height);
+    explosionTemplate.texture = game.loadTexture("assets/effect/explosion.png", &explosionTemplate.width, &explosionTemplate.height);
     explosionTemplate.totlaFrame = static_cast<int>(explosionTemplate.width / explosionTemplate.height);
+    explosionTemplate.frameSize = explosionTemplate.height;
     float newHeight = explosionTemplate.height * 2.0f;  // 直接使用float类型
     explosionTemplate.height = newHeight;
     explosionTemplate.width = explosionTemplate.height;  // 都是float，无需转换
 
-    itemLifeTemplate.texture = IMG_LoadTexture(game.getRenderer(), "assets/image/bonus_life.png");
-    SDL_GetTextureSize(itemLifeTemplate.texture, &itemLifeTemplate.width, &itemLifeTemplate.height);
+    itemLifeTemplate.texture = game.loadTexture("assets/image/bonus_life.png", &itemLifeTemplate.width, &itemLifeTemplate.height);
     itemLifeTemplate.width /= 4;
     itemLifeTemplate.height /= 4;
     itemLifeTemplate.type = ItemType::Life;
     
     // 新增护盾道具模板
-    itemShieldTemplate.texture = IMG_LoadTexture(game.getRenderer(), "assets/image/bonus_shield.png");
-    SDL_GetTextureSize(itemShieldTemplate.texture, &itemShieldTemplate.width, &itemShieldTemplate.height);
+    itemShieldTemplate.texture = game.loadTexture("assets/image/bonus_shield.png", &itemShieldTemplate.width, &itemShieldTemplate.height);
     itemShieldTemplate.width /= 4;
     itemShieldTemplate.height /= 4;
     itemShieldTemplate.type = ItemType::Shield;
     
     // 新增时间道具模板
-    itemTimeTemplate.texture = IMG_LoadTexture(game.getRenderer(), "assets/image/超级奖励.png");
-    SDL_GetTextureSize(itemTimeTemplate.texture, &itemTimeTemplate.width, &itemTimeTemplate.height);
+    itemTimeTemplate.texture = game.loadTexture("assets/image/超级奖励.png", &itemTimeTemplate.width, &itemTimeTemplate.height);
     itemTimeTemplate.width /= 4;
     itemTimeTemplate.height /= 4;
     itemTimeTemplate.type = ItemType::Time;
     
     // 新增金币道具模板（动画效果）
-    itemGoldTemplate.texture = IMG_LoadTexture(game.getRenderer(), "assets/effect/金币(gold_coin)_爱给网_aigei_com.png");
-    SDL_GetTextureSize(itemGoldTemplate.texture, &itemGoldTemplate.width, &itemGoldTemplate.height);
+    itemGoldTemplate.texture = game.loadTexture("assets/effect/金币(gold_coin)_爱给网_aigei_com.png", &itemGoldTemplate.width, &itemGoldTemplate.height);
     itemGoldTemplate.totlaFrame = static_cast<int>(itemGoldTemplate.width / itemGoldTemplate.height); // 8帧动画
     itemGoldTemplate.width = static_cast<float>(itemGoldTemplate.height); // 单帧宽度
     //itemGoldTemplate.width /= 2;金币大小调整现在挺好
     //itemGoldTemplate.height /= 2;
     itemGoldTemplate.type = ItemType::Gold;
-    
-    // 初始化对象池（在模板对象设置完成后）
-    playerBulletPool.initialize(projectilePlayerTemplate, 50);
-    enemyBulletPool.initialize(projectileEnemyTemplate, 200);
-    explosionPool.initialize(explosionTemplate, 20); // 初始化爆炸对象池
 }
 void SceneMain::clean()
 {
-    // 清理容器
-    for (const auto& sound : sounds){
-        if (sound.second != nullptr){
-            Mix_FreeChunk(sound.second);
-        }
-    }
-    sounds.clear();
-    
-    // 清理子弹列表（不需要 delete，对象池会自动管理）
-    for (auto &projectile : projectilesPlayer) {
-        playerBulletPool.release(projectile);
-    }
-    projectilesPlayer.clear();
+    world.clear(); // 敌人、子弹、道具和爆炸
 
-    for (auto &enemy : enemies){
-        if (enemy != nullptr){
-            delete enemy;
-        }
-    }
-    enemies.clear();
-
-    for (auto &projectile : projectilesEnemy) {
-        enemyBulletPool.release(projectile);
-    }
-    projectilesEnemy.clear();
-
-    // 清理爆炸列表（使用对象池释放）
-    for (auto &explosion : explosions) {
-        explosionPool.release(explosion);
-    }
-    explosions.clear();
-
-    for (auto &item : items){
-        if (item != nullptr){
-            delete item;
-        }
-    }
-    items.clear();
 
     // 清理ui
     if (uiHealth != nullptr){
@@ -394,23 +282,15 @@ void SceneMain::clean()
     {
         SDL_DestroyTexture(projectilePlayerTemplate.texture);
     }
-    if (enemyTemplate.texture != nullptr){
-        SDL_DestroyTexture(enemyTemplate.texture);
-    }
-    // 清理随机敌人纹理
-    for (int i = 0; i < 10; i++) {
-        if (enemyTemplate.randomTextures[i] != nullptr) {
-            SDL_DestroyTexture(enemyTemplate.randomTextures[i]);
-            enemyTemplate.randomTextures[i] = nullptr;
+    // 清理敌人纹理
+    for (EnemyArchetype& archetype : enemyArchetypes) {
+        for (SDL_Texture*& texture : archetype.textures) {
+            if (texture != nullptr) {
+                SDL_DestroyTexture(texture);
+                texture = nullptr;
+            }
         }
     }
-    // 清理新敌人纹理
-    if (enemyTemplate1.texture != nullptr){
-        SDL_DestroyTexture(enemyTemplate1.texture);
-    }
-    if (enemyTemplate2.texture != nullptr){
-        SDL_DestroyTexture(enemyTemplate2.texture);
-    }
     if (projectileEnemyTemplate.texture != nullptr){
         SDL_DestroyTexture(projectileEnemyTemplate.texture);
     }
@@ -427,34 +307,34 @@ void SceneMain::keyboardControl(float deltaTime)
     if (isDead){
         return;
     }
-    const bool* keyboardState = SDL_GetKeyboardState(NULL);
+    const PlayerInput& input = game.getInput();
     
     // 基础移动速度
     float currentSpeed = static_cast<float>(player.speed);
     
     // J键加速功能
-    if (keyboardState[SDL_SCANCODE_J]){
+    if (input.isDown(INPUT_BOOST)){
         currentSpeed *= 1.3f; // 加30%
     }
     
     // K键作弊功能 - 标记需要切换到Boss战
-    if (keyboardState[SDL_SCANCODE_K]) {
+    if (input.isDown(INPUT_BOSS)) {
         startBossTransition();
         return;
     }
     
     // 允许在所有状态下移动（除了死亡状态）
-    if (keyboardState[SDL_SCANCODE_W]){
+    if (input.isDown(INPUT_UP)){
         player.position.y -= deltaTime * currentSpeed;
     }
-    if (keyboardState[SDL_SCANCODE_S]){
+    if (input.isDown(INPUT_DOWN)){
         player.position.y += deltaTime * currentSpeed;
     }
-    if (keyboardState[SDL_SCANCODE_A]){
+    if (input.isDown(INPUT_LEFT)){
         player.position.x -= deltaTime * currentSpeed;
         player.flip = SDL_FLIP_HORIZONTAL; // 向左移动时水平翻转
     }
-    if (keyboardState[SDL_SCANCODE_D]){
+    if (input.isDown(INPUT_RIGHT)){
         player.position.x += deltaTime * currentSpeed;
         player.flip = SDL_FLIP_NONE; // 向右移动时恢复正常
     }
@@ -463,14 +343,14 @@ void SceneMain::keyboardControl(float deltaTime)
     if (player.position.x < 0){
         player.position.x = 0;
     }
-    if (player.position.x > Game::getInstance().getWindowWidth() - player.width){
-        player.position.x = Game::getInstance().getWindowWidth() - player.width;
+    if (player.position.x > game.getWindowWidth() - player.width){
+        player.position.x = game.getWindowWidth() - player.width;
     }
     if (player.position.y < 0){
         player.position.y = 0;
     }
-    if (player.position.y > Game::getInstance().getWindowHeight() - player.height){
-        player.position.y = Game::getInstance().getWindowHeight() - player.height;
+    if (player.position.y > game.getWindowHeight() - player.height){
+        player.position.y = game.getWindowHeight() - player.height;
     }
 
     // 只在正常状态下自动发射子弹
@@ -482,442 +362,401 @@ void SceneMain::keyboardControl(float deltaTime)
 void SceneMain::shootPlayer()
 {
     // 在这里实现发射子弹的逻辑
-    auto* projectile = playerBulletPool.create();
-    if (projectile == nullptr) {
-        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Player bullet pool exhausted!");
-        return;
-    }
-    
-    // 设置子弹属性
-    *projectile = projectilePlayerTemplate;  // 重置为模板状态
-    
+    SDL_FPoint position;
+    SDL_FPoint direction;
     // 根据主角朝向设置子弹位置和方向
     if (player.flip == SDL_FLIP_HORIZONTAL) {
         // 向左发射
-        projectile->position.x = player.position.x - projectile->width;
-        projectile->direction = {-1, 0}; // 向左移动
+        position.x = player.position.x - projectilePlayerTemplate.width;
+        direction = {-1, 0}; // 向左移动
     } else {
         // 向右发射
-        projectile->position.x = player.position.x + player.width;
-        projectile->direction = {1, 0}; // 向右移动
+        position.x = player.position.x + player.width;
+        direction = {1, 0}; // 向右移动
     }
-    
-    projectile->position.y = player.position.y + player.height / 2 - projectile->height / 2;
-    projectile->bounceCount = 0; // 初始化弹射次数
-    projectilesPlayer.push_back(projectile);
-    Mix_PlayChannel(0, sounds["player_shoot"], 0);
-}
-
-void SceneMain::updatePlayerProjectiles(float deltaTime)
-{
-    int margin = 32; // 子弹超出屏幕外边界的距离
-    for (auto it = projectilesPlayer.begin(); it != projectilesPlayer.end();){
-        auto* projectile = *it; // 明确为指针，避免复制
-        projectile->position.x += projectile->speed * deltaTime * projectile->direction.x;
-        projectile->position.y += projectile->speed * deltaTime * projectile->direction.y;
-        
-        // 检查边界弹射（只在屏幕边缘）
-        bool shouldDelete = false;
-        
-        // 上下边界弹射
-        if (projectile->position.y <= 0 || projectile->position.y >= game.getWindowHeight() - projectile->height) {
-            if (projectile->bounceCount < projectile->maxBounces) {
-                projectile->direction.y = -projectile->direction.y; // 垂直方向反弹
-                projectile->bounceCount++;
-                // 确保子弹不会卡在边界
-                if (projectile->position.y <= 0) projectile->position.y = 0;
-                if (projectile->position.y >= game.getWindowHeight() - projectile->height) 
-                    projectile->position.y = game.getWindowHeight() - projectile->height;
-                
-                // 更改子弹材质为衰减子弹
-                if (bouncedBulletTexture != nullptr) {
-                    projectile->texture = bouncedBulletTexture;
-                }
-            } else {
-                shouldDelete = true;
-            }
-        }
-        
-        // 左右边界弹射
-        if (projectile->position.x <= 0 || projectile->position.x >= game.getWindowWidth() - projectile->width) {
-            if (projectile->bounceCount < projectile->maxBounces) {
-                projectile->direction.x = -projectile->direction.x; // 水平方向反弹
-                projectile->bounceCount++;
-                // 确保子弹不会卡在边界
-                if (projectile->position.x <= 0) projectile->position.x = 0;
-                if (projectile->position.x >= game.getWindowWidth() - projectile->width) 
-                    projectile->position.x = game.getWindowWidth() - projectile->width;
-                
-                // 更改子弹材质为衰减子弹
-                if (bouncedBulletTexture != nullptr) {
-                    projectile->texture = bouncedBulletTexture;
-                }
-            } else {
-                shouldDelete = true;
-            }
-        }
-        
-        // 检查子弹是否超出屏幕边界（用于删除）
-        if (projectile->position.x < -margin || projectile->position.x > game.getWindowWidth() + margin ||
-            projectile->position.y < -margin || projectile->position.y > game.getWindowHeight() + margin){
-            shouldDelete = true;
-        }
-        
-        if (shouldDelete) {
-            playerBulletPool.release(projectile);
-            it = projectilesPlayer.erase(it);
-        } else {
-            bool hit = false;
-            for (auto enemy : enemies){
-                SDL_FRect enemyRect = {
-                    enemy->position.x,
-                    enemy->position.y,
-                    enemy->width,
-                    enemy->height
-                };
-                SDL_FRect projectileRect = {
-                    projectile->position.x,
-                    projectile->position.y,
-                    projectile->width,
-                    projectile->height
-                };
-                if (SDL_HasRectIntersectionFloat(&enemyRect, &projectileRect)){
-                    // 检查这颗子弹是否已经击中过这个敌人（防止穿透子弹帧伤）
-                    bool alreadyHit = false;
-                    for (auto hitEnemy : projectile->hitEnemies) {
-                        if (hitEnemy == enemy) {
-                            alreadyHit = true;
-                            break;
-                        }
-                    }
-                    
-                    if (!alreadyHit) {
-                        enemy->currentHealth -= projectile->damage;
-                        hit = true;
-                        Mix_PlayChannel(-1, sounds["hit"], 0);
-                        
-                        // 将敌人添加到已击中列表
-                        projectile->hitEnemies.push_back(enemy);
-                        
-                        // 如果子弹没有穿透能力，则删除子弹
-                        if (!player.weapon.piercing) {
-                            playerBulletPool.release(projectile);
-                            it = projectilesPlayer.erase(it);
-                            break;
-                        }
-                    }
-                }
-            }
-            if (!hit || player.weapon.piercing){
-                ++it;
-            }
-        }
+    position.y = player.position.y + player.height / 2 - projectilePlayerTemplate.height / 2;
+    if (!createPlayerShot(position, direction)) {
+        return;
     }
+    game.playSfx(SoundId::PlayerShoot);
 }
 
-void SceneMain::renderPlayerProjectiles()
+bool SceneMain::createPlayerShot(SDL_FPoint position, SDL_FPoint direction)
 {
-    for (auto* projectile : projectilesPlayer){
-        SDL_FRect projectileRect = {
-            projectile->position.x,
-            projectile->position.y,
-            projectile->width,
-            projectile->height
-        };
-        SDL_RenderTexture(game.getRenderer(), projectile->texture, NULL, &projectileRect);
+    if (world.count<PlayerShot>() >= MAX_PLAYER_SHOTS) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Player bullet pool exhausted!");
+        return false;
     }
+    // 最大反弹次数与武器一致，见updatePlayerProjectiles
+    spawnPlayerShot(world, projectilePlayerTemplate, position, direction, player.weapon.damage, player.weapon.bounceCount);
+    return true;
 }
 
-void SceneMain::renderEnemyProjectiles()
+void SceneMain::updatePlayerProjectiles(float deltaTime)
 {
-
-    for (auto projectile : projectilesEnemy){
-        SDL_FRect projectileRect = {
-            projectile->position.x,
-            projectile->position.y,
-            projectile->width,
-            projectile->height
-        };
-        float angle = static_cast<float>(atan2(projectile->direction.y, projectile->direction.x) * 180 / M_PI - 90);
-        SDL_RenderTextureRotated(game.getRenderer(), projectile->texture, NULL, &projectileRect, angle, NULL, SDL_FLIP_NONE);
+    ProfileScope zone(game.getProfiler(), "player projectiles");
+    // 每批子弹只按当前武器选择一次更新函数，循环内不再判断武器类型
+    // 子弹的最大反弹次数在发射时取自武器，而武器的反弹次数和穿透在一局中只增不减，
+    // 所以武器不能反弹时场上也不会有能反弹的子弹
+    bool bounce = player.weapon.bounceCount > 0;
+    bool pierce = player.weapon.piercing;
+    float fieldWidth = static_cast<float>(game.getWindowWidth());
+    float fieldHeight = static_cast<float>(game.getWindowHeight());
+    int hits = 0;
+    if (bounce) {
+        if (pierce) {
+            hits = playerShotSystem<true, true>(world, deltaTime, fieldWidth, fieldHeight, bouncedBulletTexture);
+        } else {
+            hits = playerShotSystem<true, false>(world, deltaTime, fieldWidth, fieldHeight, bouncedBulletTexture);
+        }
+    } else {
+        if (pierce) {
+            hits = playerShotSystem<false, true>(world, deltaTime, fieldWidth, fieldHeight, bouncedBulletTexture);
+        } else {
+            hits = playerShotSystem<false, false>(world, deltaTime, fieldWidth, fieldHeight, bouncedBulletTexture);
+        }
+    }
+    if (hits > 0) {
+        game.playSfx(SoundId::Hit);
     }
 }
 
-void SceneMain::spawEnemy()
+void SceneMain::spawEnemy(float deltaTime)
 {
+    ProfileScope zone(game.getProfiler(), "spawn");
     // 过渡期间停止生成敌人
     if (transitionState != TransitionState::NORMAL) {
         return;
     }
     
-    if (dis(gen) > 1 / 60.0f){
+    // 时间表中本帧到期的波次
+    for (const WaveEvent* wave = waves.advance(deltaTime); wave != waves.getDueEnd(); ++wave) {
+        spawnWave(*wave);
+    }
+    
+    // 随机生成：每帧的概率由每秒生成数换算
+    float rate = waves.getAmbientRate();
+    if (rate <= 0 || rng.spawn.nextFloat() > rate * deltaTime){
         return;
     }
     
-    Enemy* enemy = nullptr;
-    // 随机选择敌人类型（概率：原敌人10%，敌人1 70%，敌人2 20%）
-    float randomValue = dis(gen);
-    if (randomValue < 0.1f) {
-        enemy = new Enemy(enemyTemplate);  // 10% 概率
-        // 为敌人0随机选择纹理
-        if (enemy->type == 0) {
-            enemy->currentTextureIndex = static_cast<int>(dis(gen) * 10); // 0-9随机
-            enemy->texture = enemy->randomTextures[enemy->currentTextureIndex];
+    // 按各类敌人的生成概率随机选择类型（原敌人10%，敌人1 70%，敌人2 20%）
+    float randomValue = rng.spawn.nextFloat();
+    int type = ENEMY_ARCHETYPE_COUNT - 1;
+    float threshold = 0;
+    for (int i = 0; i < ENEMY_ARCHETYPE_COUNT - 1; i++) {
+        threshold += ENEMY_ARCHETYPES[i].spawnWeight;
+        if (randomValue < threshold) {
+            type = i;
+            break;
         }
-    } else if (randomValue < 0.8f) {
-        enemy = new Enemy(enemyTemplate1); // 70% 概率
-    } else {
-        enemy = new Enemy(enemyTemplate2); // 20% 概率
     }
-    
+    const EnemyArchetype& archetype = enemyArchetypes[type];
     // 敌人从屏幕右侧随机Y位置生成
-    enemy->position.x = game.getWindowWidth();
-    enemy->position.y = dis(gen) * (game.getWindowHeight() - enemy->height);
-    enemies.push_back(enemy);
+    SDL_FPoint position;
+    position.x = game.getWindowWidth();
+    position.y = rng.spawn.nextFloat() * (game.getWindowHeight() - archetype.height);
+    createEnemy(type, position, archetype.def->motion);
+}
+
+void SceneMain::spawnWave(const WaveEvent& wave)
+{
+    const EnemyArchetype& archetype = enemyArchetypes[wave.archetype];
+    EnemyMotion motion = wave.defaultPath ? archetype.def->motion : wave.path;
+    float fieldWidth = static_cast<float>(game.getWindowWidth());
+    float maxY = game.getWindowHeight() - archetype.height;
+    float centerY = wave.y * game.getWindowHeight() - archetype.height / 2;
+    float spacingX = archetype.width * 1.5f;  // 前后间距
+    float spacingY = archetype.height * 1.2f; // 上下间距
+    for (int i = 0; i < wave.count; i++) {
+        float offset = i - (wave.count - 1) / 2.0f; // 相对队形中心的序号
+        SDL_FPoint position = {fieldWidth, centerY};
+        switch (wave.formation) {
+            case WaveFormation::Single:
+                position.x += i * spacingX;
+                break;
+            case WaveFormation::Column:
+                position.y += offset * spacingY;
+                break;
+            case WaveFormation::Vee:
+                position.x += std::fabs(offset) * spacingX;
+                position.y += offset * spacingY;
+                break;
+            case WaveFormation::Random:
+                position.y = rng.spawn.nextFloat() * maxY;
+                break;
+        }
+        position.y = std::clamp(position.y, 0.0f, maxY);
+        createEnemy(wave.archetype, position, motion, wave.motionPath);
+    }
+}
+
+Entity SceneMain::createEnemy(int type, SDL_FPoint position, EnemyMotion motion, int path)
+{
+    const EnemyArchetype& archetype = enemyArchetypes[type];
+    Enemy enemy;
+    enemy.type = type;
+    enemy.currentHealth = archetype.def->health;
+    enemy.id = nextEnemyId++;
+    Transform transform;
+    transform.position = position;
+    transform.width = archetype.width;
+    transform.height = archetype.height;
+    Sprite sprite;
+    sprite.texture = archetype.textures[0];
+    sprite.layer = RenderLayer::Enemies;
+    // 有多种外观时随机选择纹理
+    if (archetype.def->textureVariants > 1) {
+        sprite.texture = archetype.textures[rng.cosmetic.nextInt(archetype.def->textureVariants)];
+    }
+    Velocity velocity;
+    velocity.direction = {-1, 0}; // 向左移动
+    velocity.speed = archetype.def->speed;
+
+    // 按移动方式带上对应的组件，同一移动方式的敌人放在同一个原型中
+    switch (motion) {
+        case EnemyMotion::Straight:
+            return world.create(transform, velocity, sprite, enemy);
+        case EnemyMotion::Wave:
+            return world.create(transform, velocity, sprite, enemy, EnemyDrift{});
+        case EnemyMotion::Spin:
+            sprite.rotated = true; // 旋转的敌人（敌人2）需要旋转渲染
+            return world.create(transform, velocity, sprite, enemy, EnemySpin{});
+        case EnemyMotion::Path:
+            break;
+    }
+    // 沿路径移动的敌人没有Velocity，位置由followEnemyPaths计算
+    EnemyPath enemyPath;
+    enemyPath.path = static_cast<Uint8>(path);
+    enemyPath.origin = position;
+    return world.create(transform, sprite, enemy, enemyPath);
 }
 
 void SceneMain::changeSceneDelayed(float deltaTime, float delay)
 {
     timerEnd += deltaTime;
     if (timerEnd > delay){
-        auto sceneEnd = new SceneEnd();
-        game.changeScene(sceneEnd);
+        game.showRunResult(false);
     }
 }
 
 void SceneMain::updateEnemies(float deltaTime)
 {
-    auto currentTime = SDL_GetTicks();
-    for (auto it = enemies.begin(); it != enemies.end();){
-        auto enemy = *it;
-        
-        // 过渡期间让敌人向右移动退场
-        if (transitionState == TransitionState::PREPARING_BOSS || enemiesRetreating) {
-            enemy->position.x += enemy->speed * deltaTime * 2.0f; // 加速退场
-            
-            // 敌人移出屏幕右侧时删除
-            if (enemy->position.x > game.getWindowWidth() + enemy->width) {
-                delete enemy;
-                it = enemies.erase(it);
-                continue;
-            }
-            ++it;
-            continue;
+    ProfileScope zone(game.getProfiler(), "enemies");
+    // 过渡期间让敌人向右移动退场
+    if (transitionState == TransitionState::PREPARING_BOSS || enemiesRetreating) {
+        retreatEnemies(deltaTime);
+        return;
+    }
+    moveEnemies(deltaTime);
+    driftEnemies(deltaTime);
+    followEnemyPaths(deltaTime);
+    spinEnemies(deltaTime);
+    if (isDead == false) {
+        fireEnemies();
+    }
+    removeEnemies();
+}
+
+void SceneMain::retreatEnemies(float deltaTime)
+{
+    // 加速退场，敌人移出屏幕右侧时删除
+    float fieldWidth = static_cast<float>(game.getWindowWidth());
+    world.each<Enemy, Transform>([&](Entity entity, Enemy& enemy, Transform& transform) {
+        transform.position.x += archetypeOf(enemy).def->speed * deltaTime * 2.0f;
+        if (transform.position.x > fieldWidth + transform.width) {
+            world.destroy(entity);
         }
-        
-        // 敌人向左移动
-        enemy->position.x -= enemy->speed * deltaTime;
-        
-        // 敌人1的上下移动行为
-        if (enemy->type == 1) {
-            enemy->moveTimer += deltaTime;
-            // 使用正弦函数产生平滑的上下移动
-            float offsetY = sin(enemy->moveTimer * 3.0f) * 2.0f; // 小幅度移动
-            enemy->position.y += offsetY;
-            
-            // 确保不会移出屏幕
-            if (enemy->position.y < 0) {
-                enemy->position.y = 0;
-            } else if (enemy->position.y > game.getWindowHeight() - enemy->height) {
-                enemy->position.y = game.getWindowHeight() - enemy->height;
-            }
+    });
+}
+
+void SceneMain::moveEnemies(float deltaTime)
+{
+    // 敌人向左移动，沿路径移动的敌人没有Velocity，由followEnemyPaths处理
+    moveSystem<Enemy>(world, deltaTime);
+}
+
+void SceneMain::driftEnemies(float deltaTime)
+{
+    constexpr float DRIFT_SPEED = 120.0f; // 上下摆动的最大速度（像素/秒）
+    float fieldHeight = static_cast<float>(game.getWindowHeight());
+    world.each<EnemyDrift, Transform>([&](Entity, EnemyDrift& drift, Transform& transform) {
+        drift.moveTimer += deltaTime;
+        // 使用正弦函数产生平滑的上下移动，按时间积分，与帧率无关
+        transform.position.y += fastSin(drift.moveTimer * 3.0f) * DRIFT_SPEED * deltaTime;
+        // 确保不会移出屏幕
+        transform.position.y = std::clamp(transform.position.y, 0.0f, fieldHeight - transform.height);
+    });
+}
+
+void SceneMain::followEnemyPaths(float deltaTime)
+{
+    // 位置只由走过的距离决定：起点加上路径表中的偏移
+    world.each<Enemy, EnemyPath, Transform>([&](Entity, Enemy& enemy, EnemyPath& path, Transform& transform) {
+        path.moveTimer += deltaTime;
+        SDL_FPoint offset = enemyPaths[path.path].sample(archetypeOf(enemy).def->speed * path.moveTimer);
+        transform.position = {path.origin.x + offset.x, path.origin.y + offset.y};
+    });
+}
+
+void SceneMain::spinEnemies(float deltaTime)
+{
+    world.each<EnemySpin, Sprite>([&](Entity, EnemySpin&, Sprite& sprite) {
+        sprite.rotation += 90.0f * deltaTime; // 每秒旋转90度
+        if (sprite.rotation >= 360.0f) {
+            sprite.rotation -= 360.0f;
         }
-        
-        // 敌人2的旋转行为
-        if (enemy->type == 2) {
-            enemy->rotationAngle += 90.0f * deltaTime; // 每秒旋转90度
-            if (enemy->rotationAngle >= 360.0f) {
-                enemy->rotationAngle -= 360.0f;
-            }
+    });
+}
+
+void SceneMain::fireEnemies()
+{
+    auto currentTime = game.getSimTicks();
+    world.each<Enemy, Transform>([&](Entity, Enemy& enemy, Transform& transform) {
+        // 射击方式由类型决定；冷却结束且还在屏幕内的敌人射击，射击后重新计时
+        const EnemyArchetype& archetype = archetypeOf(enemy);
+        if (archetype.def->fire == EnemyFire::None || currentTime - enemy.lastShootTime <= archetype.coolDown ||
+            transform.position.x < -transform.width) {
+            return;
         }
-        
-        // 当敌人移出屏幕左侧时删除
-        if (enemy->position.x < -enemy->width){
-            delete enemy;
-            it = enemies.erase(it);
-        }else {
-            // 敌人射击行为 - 敌人0不射击，敌人1正常射击，敌人2多方向射击
-            if (currentTime - enemy->lastShootTime > enemy->coolDown && isDead == false){
-                // 敌人0不射击
-                if (enemy->type == 0) {
-                    // 不执行射击
-                } 
-                // 敌人1正常射击
-                else if (enemy->type == 1) {
-                    shootEnemy(enemy);
-                }
-                // 敌人2多方向射击
-                else if (enemy->type == 2) {
-                    shootEnemyMultiDirection(enemy, 5); // 发射5个子弹
-                }
-                
-                enemy->lastShootTime = static_cast<Uint32>(currentTime);
-            }
-            
-            if (enemy->currentHealth <= 0){
-                enemyExplode(enemy);
-                it = enemies.erase(it);
-            } else {
-                ++it;
-            }
+        enemy.lastShootTime = static_cast<Uint32>(currentTime);
+        if (archetype.def->fire == EnemyFire::Aimed) {
+            shootEnemy(transform);
+        } else {
+            shootEnemyMultiDirection(transform, archetype.def->bulletCount);
         }
-    }
+    });
 }
 
-void SceneMain::updateEnemyProjectiles(float deltaTime)
+void SceneMain::removeEnemies()
 {
-    auto margin = 32;
-    for (auto it = projectilesEnemy.begin(); it != projectilesEnemy.end();){
-        auto projectile = *it;
-        projectile->position.x += projectile->speed * projectile ->direction.x * deltaTime;
-        projectile->position.y += projectile->speed * projectile->direction.y * deltaTime;
-        if (projectile->position.y > game.getWindowHeight() + margin ||
-            projectile->position.y < - margin ||
-            projectile->position.x < - margin ||
-            projectile->position.x > game.getWindowWidth() + margin){
-            enemyBulletPool.release(*it);
-            it = projectilesEnemy.erase(it);
-        }else {
-            SDL_FRect projectileRect = {
-                projectile->position.x,
-                projectile->position.y,
-                projectile->width,
-                projectile->height
-            };
-            
-            SDL_FRect playerRect = {
-                player.position.x + player.width * 0.2f,  // 缩小碰撞范围
-                player.position.y + player.height * 0.2f,
-                player.width * 0.75f,   // 碰撞宽度为实际的75%
-                player.height * 0.60f   // 碰撞高度为实际的60%
-            };
-
-            if (SDL_HasRectIntersectionFloat(&projectileRect, &playerRect) && !isDead){
-                // 优先扣除护盾
-                if (player.currentShield > 0) {
-                    player.currentShield--;
-                } else {
-                    player.currentHealth -= projectile->damage;
-                }
-                enemyBulletPool.release(*it);
-                it = projectilesEnemy.erase(it);
-                Mix_PlayChannel(-1, sounds["hit"], 0);
-            } else {
-                ++it;
-            }
+    world.each<Enemy, Transform>([&](Entity entity, Enemy& enemy, Transform& transform) {
+        // 移出屏幕左侧时直接删除，被击毁时爆炸
+        if (transform.position.x < -transform.width) {
+            world.destroy(entity);
+        } else if (enemy.currentHealth <= 0) {
+            world.destroy(entity);
+            enemyExplode(transform);
         }
+    });
+}
+
+void SceneMain::updateEnemyProjectiles(float deltaTime)
+{
+    ProfileScope zone(game.getProfiler(), "enemy projectiles");
+    moveSystem<EnemyShot>(world, deltaTime);
+    boundsSystem(world, game.getWindowWidth(), game.getWindowHeight());
+    if (isDead) {
+        return;
     }
+    SDL_FRect playerRect = {
+        player.position.x + player.width * 0.2f,  // 缩小碰撞范围
+        player.position.y + player.height * 0.2f,
+        player.width * 0.75f,   // 碰撞宽度为实际的75%
+        player.height * 0.60f   // 碰撞高度为实际的60%
+    };
+    collisionSystem(world, playerRect, [&](Entity shot, Transform&, Damage& damage) {
+        // 优先扣除护盾
+        if (player.currentShield > 0) {
+            player.currentShield--;
+        } else {
+            player.currentHealth -= damage.amount;
+        }
+        world.destroy(shot);
+        game.playSfx(SoundId::Hit);
+    });
 }
             
 void SceneMain::updatePlayer(float)
 {
+    ProfileScope zone(game.getProfiler(), "player");
     if (isDead) {
         return;
     }
     if (player.currentHealth <= 0){
         // 玩家死亡，触发爆炸和切换场景
-        auto currentTime = SDL_GetTicks();
         isDead = true;
-        auto explosion = explosionPool.create(); // 使用对象池创建
-        if (explosion != nullptr) {
-            explosion->position.x = player.position.x + player.width / 2 - explosion->width / 2;
-            explosion->position.y = player.position.y + player.height / 2 - explosion->height / 2;
-            explosion->startTime = static_cast<Uint32>(currentTime);
-            explosions.push_back(explosion);
-        }
-        Mix_PlayChannel(-1, sounds["player_explode"], 0);
+        createExplosion({player.position.x + player.width / 2, player.position.y + player.height / 2});
+        game.playSfx(SoundId::PlayerExplode);
         game.setFinalScore(score);
+        game.endRun(player.weapon, BossProgress::None);
         return;
     }
-            for (auto enemy : enemies){
-            SDL_FRect enemyRect = {
-            enemy->position.x,
-            enemy->position.y,
-            enemy->width,
-            enemy->height
-            };
-            SDL_FRect playerRect = {
-            player.position.x,
-            player.position.y,
-            player.width,
-            player.height
-            };
-            if (SDL_HasRectIntersectionFloat(&playerRect, &enemyRect)){
+    SDL_FRect playerRect = {
+        player.position.x,
+        player.position.y,
+        player.width,
+        player.height
+    };
+    world.each<Enemy, Transform>([&](Entity, Enemy& enemy, Transform& transform) {
+        SDL_FRect enemyRect = {
+            transform.position.x,
+            transform.position.y,
+            transform.width,
+            transform.height
+        };
+        if (SDL_HasRectIntersectionFloat(&playerRect, &enemyRect)){
             // 优先扣除护盾
             if (player.currentShield > 0) {
-            player.currentShield--;
+                player.currentShield--;
             } else {
-            player.currentHealth -= 1;
-            }
-            enemy->currentHealth = 0;
-            }
-            }
+                player.currentHealth -= 1;
             }
+            enemy.currentHealth = 0;
+        }
+    });
+}
 
-void SceneMain::renderEnemies()
+void SceneMain::shootEnemy(const Transform& enemy)
 {
-    for (auto enemy : enemies){
-        SDL_FRect enemyRect = {
-            enemy->position.x,
-            enemy->position.y,
-            enemy->width,
-            enemy->height
-        };
-        
-        // 敌人2需要旋转渲染
-        if (enemy->type == 2) {
-            SDL_FPoint center = {enemy->width / 2, enemy->height / 2};
-            SDL_RenderTextureRotated(game.getRenderer(), enemy->texture, NULL, &enemyRect, enemy->rotationAngle, &center, SDL_FLIP_NONE);
-        } else {
-            SDL_RenderTexture(game.getRenderer(), enemy->texture, NULL, &enemyRect);
-        }
+    if (!createEnemyShot(enemy, getDirection(enemy))) {
+        return;
     }
+    game.playSfx(SoundId::EnemyShoot);
 }
 
-void SceneMain::shootEnemy(Enemy *enemy)
+bool SceneMain::createEnemyShot(const Transform& enemy, SDL_FPoint direction)
 {
-    auto* projectile = enemyBulletPool.create();
-    if (projectile == nullptr) {
+    if (world.count<EnemyShot>() >= MAX_ENEMY_SHOTS) {
         SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Enemy bullet pool exhausted!");
+        return false;
+    }
+    Transform transform;
+    transform.position.x = enemy.position.x + enemy.width / 2 - projectileEnemyTemplate.width / 2;
+    transform.position.y = enemy.position.y + enemy.height / 2 - projectileEnemyTemplate.height / 2;
+    transform.width = projectileEnemyTemplate.width;
+    transform.height = projectileEnemyTemplate.height;
+    Velocity velocity;
+    velocity.direction = direction;
+    velocity.speed = static_cast<float>(projectileEnemyTemplate.speed);
+    // 子弹贴图朝下，按飞行方向旋转
+    Sprite sprite;
+    sprite.texture = projectileEnemyTemplate.texture;
+    sprite.rotation = fastAtan2(direction.y, direction.x) * 180.0f / SDL_PI_F - 90.0f;
+    sprite.rotated = true;
+    world.create(transform, velocity, Bounds{32}, sprite, Hitbox{1.0f}, Damage{projectileEnemyTemplate.damage}, EnemyShot{});
+    return true;
+}
+
+void SceneMain::createExplosion(SDL_FPoint center)
+{
+    if (world.count<Effect>() >= MAX_EXPLOSIONS) {
         return;
     }
-    
-    // 设置子弹属性
-    *projectile = projectileEnemyTemplate;  // 重置为模板状态
-    projectile->position.x = enemy->position.x + enemy->width / 2 - projectile->width / 2;
-    projectile->position.y = enemy->position.y + enemy->height / 2 - projectile->height / 2;
-    projectile->direction = getDirection(enemy);
-    projectilesEnemy.push_back(projectile);
-    Mix_PlayChannel(-1, sounds["enemy_shoot"], 0);
+    spawnExplosion(world, explosionTemplate, center, static_cast<Uint32>(game.getSimTicks()));
 }
 
-SDL_FPoint SceneMain::getDirection(Enemy *enemy) const
+SDL_FPoint SceneMain::getDirection(const Transform& enemy) const
 {
-    auto x = (player.position.x + player.width / 2) - (enemy->position.x + enemy->width / 2);
-    auto y = (player.position.y + player.height / 2) - (enemy->position.y + enemy->height / 2);
-    auto length = sqrt(x * x + y * y);
-    
-    // 防止除零错误
-    if (length == 0) {
-        return SDL_FPoint{0, 0};
-    }
-    
-    x /= length;
-    y /= length;
-    return SDL_FPoint{x, y};
+    auto x = (player.position.x + player.width / 2) - (enemy.position.x + enemy.width / 2);
+    auto y = (player.position.y + player.height / 2) - (enemy.position.y + enemy.height / 2);
+    return fastNormalize(x, y); // 重合时返回(0, 0)，防止除零错误
 }
 
-void SceneMain::enemyExplode(Enemy* enemy)
+void SceneMain::enemyExplode(const Transform& enemy)
 {
-    auto currentTime = SDL_GetTicks();
-    auto explosion = explosionPool.create(); // 使用对象池创建
-    if (explosion != nullptr) {
-        explosion->position.x = enemy->position.x + enemy->width / 2 - explosion->width / 2;
-        explosion->position.y = enemy->position.y + enemy->height / 2 - explosion->height / 2;
-        explosion->startTime = static_cast<Uint32>(currentTime);
-        explosions.push_back(explosion);
-    }
-    Mix_PlayChannel(-1, sounds["enemy_explode"], 0);
+    createExplosion({enemy.position.x + enemy.width / 2, enemy.position.y + enemy.height / 2});
+    game.playSfx(SoundId::EnemyExplode);
     score += 10;
     
     // 检查是否达到Boss战条件
@@ -928,154 +767,140 @@ void SceneMain::enemyExplode(Enemy* enemy)
     }
     
     // 随机掉落道具
-    if (dis(gen) < 0.3f) { // 30%概率掉落道具
+    if (rng.drops.chance(0.3f)) { // 30%概率掉落道具
         dropItem(enemy);
     }
     
     // 随机掉落金币
-    if (dis(gen) < 0.8f) { // 80%概率掉落金币
-        dropGold(enemy->position.x + enemy->width / 2, enemy->position.y + enemy->height / 2);
+    if (rng.drops.chance(0.8f)) { // 80%概率掉落金币
+        dropGold(enemy.position.x + enemy.width / 2, enemy.position.y + enemy.height / 2);
     }
-    
-    delete enemy;
 }
 
-void SceneMain::updateExplosions(float deltaTime)
+void SceneMain::updateExplosions(float)
 {
-    auto currentTime = SDL_GetTicks();
-    for (auto it = explosions.begin(); it != explosions.end();)
-    {
-        auto explosion = *it;
-        explosion->currentFrame = static_cast<int>((currentTime - explosion->startTime) * explosion->FPS / 1000);
-        if (explosion->currentFrame >= explosion->totlaFrame){
-            explosionPool.release(explosion); // 使用对象池释放
-            it = explosions.erase(it);
-        }else{
-            ++it;
-        }
-    }
+    ProfileScope zone(game.getProfiler(), "explosions");
+    animationSystem(world, game.getSimTicks());
 }
 
-void SceneMain::renderExplosions()
-{
-    for (auto explosion : explosions)
-    {
-        SDL_FRect src = {explosion->currentFrame * explosion->width, 0, explosion->width / 2, explosion->height / 2};
-        SDL_FRect dst = {
-            explosion->position.x, 
-            explosion->position.y, 
-            explosion->width, 
-            explosion->height
-        };
-        SDL_RenderTexture(game.getRenderer(), explosion->texture, &src, &dst);
-    }
-}
-
-void SceneMain::dropItem(Enemy *enemy)
+void SceneMain::dropItem(const Transform& enemy)
 {
     // 随机选择掉落的物品类型
-    float itemRoll = dis(gen);
-    Item* item = nullptr;
+    float itemRoll = rng.drops.nextFloat();
+    const Item* itemTemplate = nullptr;
     
     if (itemRoll < 0.4f) {
         // 40% 概率掉落生命
-        item = new Item(itemLifeTemplate);
+        itemTemplate = &itemLifeTemplate;
     } else if (itemRoll < 0.8f) {
         // 25% 概率掉落护盾
-        item = new Item(itemShieldTemplate);
+        itemTemplate = &itemShieldTemplate;
     } else if (itemRoll < 0.9f) {
         // 20% 概率掉落时间
-        item = new Item(itemTimeTemplate);
+        itemTemplate = &itemTimeTemplate;
     } else {
         // 15% 概率掉落金币
-        item = new Item(itemGoldTemplate);
+        itemTemplate = &itemGoldTemplate;
     }
     
     // 设置物品位置和运动方向（与原有逻辑相同）
-    item->position.x = enemy->position.x + enemy->width / 2 - item->width / 2;
-    item->position.y = enemy->position.y + enemy->height / 2 - item->height / 2;
-    float angle = static_cast<float>(dis(gen) * 2 * M_PI);
-    item->direction.x = cos(angle);
-    item->direction.y = sin(angle);
-    items.push_back(item);
+    SDL_FPoint position;
+    position.x = enemy.position.x + enemy.width / 2 - itemTemplate->width / 2;
+    position.y = enemy.position.y + enemy.height / 2 - itemTemplate->height / 2;
+    SDL_FPoint direction;
+    float angle = static_cast<float>(rng.drops.nextFloat() * 2 * SDL_PI_D);
+    fastSinCos(angle, direction.y, direction.x);
+    createItem(*itemTemplate, position, direction, static_cast<float>(itemTemplate->speed));
+}
+
+void SceneMain::createItem(const Item& itemTemplate, SDL_FPoint position, SDL_FPoint direction, float speed)
+{
+    Transform transform;
+    transform.position = position;
+    transform.width = itemTemplate.width;
+    transform.height = itemTemplate.height;
+    Velocity velocity;
+    velocity.direction = direction;
+    velocity.speed = speed;
+    Sprite sprite;
+    sprite.texture = itemTemplate.texture;
+    sprite.layer = RenderLayer::Items;
+    Pickup pickup;
+    pickup.type = itemTemplate.type;
+    pickup.bounceCount = itemTemplate.bounceCount;
+    if (itemTemplate.totlaFrame <= 1) {
+        world.create(transform, velocity, sprite, pickup);
+        return;
+    }
+    // 有多帧的道具（金币）从掉落时开始循环播放动画
+    SpriteAnimation animation;
+    animation.frameWidth = itemTemplate.width;
+    animation.frameHeight = itemTemplate.height;
+    animation.startTime = static_cast<Uint32>(game.getSimTicks());
+    animation.fps = itemTemplate.FPS;
+    animation.frameCount = itemTemplate.totlaFrame;
+    animation.loop = true;
+    world.create(transform, velocity, sprite, animation, pickup);
 }
 
 void SceneMain::updateItems(float deltaTime)
 {
-    Uint32 currentTime = static_cast<Uint32>(SDL_GetTicks());
+    ProfileScope zone(game.getProfiler(), "items");
+    const float fieldWidth = static_cast<float>(game.getWindowWidth());
+    const float fieldHeight = static_cast<float>(game.getWindowHeight());
+    SDL_FRect playerRect = {
+        player.position.x, 
+        player.position.y, 
+        player.width, 
+        player.height
+    };
     
-    for (auto it = items.begin(); it != items.end();)
-    {
-        auto item = *it;
-        
-        // 更新金币动画
-        if (item->type == ItemType::Gold) {
-            if (item->startTime == 0) {
-                item->startTime = currentTime;
-            }
-            // 循环播放动画
-            item->currentFrame = ((currentTime - item->startTime) * item->FPS / 1000) % item->totlaFrame;
-        }
-        
-        // 更新位置
-        item->position.x += item->direction.x * item->speed * deltaTime;
-        item->position.y += item->direction.y * item->speed * deltaTime;
+    // 更新位置
+    moveSystem<Pickup>(world, deltaTime);
+    world.each<Pickup, Transform, Velocity>([&](Entity item, Pickup& pickup, Transform& transform, Velocity& velocity) {
+        SDL_FPoint& position = transform.position;
+        SDL_FPoint& direction = velocity.direction;
         // 处理屏幕边缘反弹
-        if (item->position.x < 0 && item->bounceCount > 0) {
-            item->direction.x = -item->direction.x;
-            item->bounceCount--;
+        if (position.x < 0 && pickup.bounceCount > 0) {
+            direction.x = -direction.x;
+            pickup.bounceCount--;
         }
-        if (item->position.x + item->width > game.getWindowWidth() && item->bounceCount > 0) {
-            item->direction.x = -item->direction.x;
-            item->bounceCount--;
+        if (position.x + transform.width > fieldWidth && pickup.bounceCount > 0) {
+            direction.x = -direction.x;
+            pickup.bounceCount--;
         }
-        if (item->position.y < 0 && item->bounceCount > 0) {
-            item->direction.y = -item->direction.y;
-            item->bounceCount--;
+        if (position.y < 0 && pickup.bounceCount > 0) {
+            direction.y = -direction.y;
+            pickup.bounceCount--;
         }
-        if (item->position.y + item->height > game.getWindowHeight() && item->bounceCount > 0) {
-            item->direction.y = -item->direction.y;
-            item->bounceCount--;
+        if (position.y + transform.height > fieldHeight && pickup.bounceCount > 0) {
+            direction.y = -direction.y;
+            pickup.bounceCount--;
         }
         
         // 如果超出屏幕范围则删除
-        if (item->position.x + item->width < 0 || 
-        item->position.x > game.getWindowWidth() ||
-        item->position.y + item->height < 0 || 
-        item->position.y > game.getWindowHeight()){
-            delete item;
-            it = items.erase(it);
+        if (position.x + transform.width < 0 || 
+        position.x > fieldWidth ||
+        position.y + transform.height < 0 || 
+        position.y > fieldHeight){
+            world.destroy(item);
+            return;
         }
-        else{
-            SDL_FRect itemRect = {
-                item->position.x, 
-                item->position.y, 
-                item->width, 
-                item->height
-            };
-            SDL_FRect playerRect = {
-                player.position.x, 
-                player.position.y, 
-                player.width, 
-                player.height
-            };
-            if (SDL_HasRectIntersectionFloat(&itemRect, &playerRect) && isDead == false)
-            {
-                playerGetItem(item);
-                delete item;
-                it = items.erase(it);
-            }else
-            {
-                ++it;
-            }
+        SDL_FRect itemRect = {position.x, position.y, transform.width, transform.height};
+        if (SDL_HasRectIntersectionFloat(&itemRect, &playerRect) && isDead == false)
+        {
+            // 时间道具会掉落新的道具，组件引用随之失效，先删除再处理效果
+            ItemType type = pickup.type;
+            world.destroy(item);
+            playerGetItem(type);
         }
-    }
+    });
 }
 
-void SceneMain::playerGetItem(Item* item)
+void SceneMain::playerGetItem(ItemType type)
 {
     // 在playerGetItem函数中（约第670-680行）
-    switch (item->type) {
+    switch (type) {
     case ItemType::Life:
         if (player.currentHealth < player.maxHealth) {
             player.currentHealth++;
@@ -1088,70 +913,34 @@ void SceneMain::playerGetItem(Item* item)
     case ItemType::Time:
         // 时间效果实现：所有敌人爆炸
         {
-            // 创建敌人列表的副本，避免在遍历时修改列表
-        std::list<Enemy*> enemiesCopy = enemies;  // 明确指定类型
-            for (const auto& enemy : enemiesCopy) {
-                // 创建爆炸效果
-                auto currentTime = SDL_GetTicks();
-                auto explosion = new Explosion(explosionTemplate);
-                explosion->position.x = enemy->position.x + enemy->width / 2 - explosion->width / 2;
-                explosion->position.y = enemy->position.y + enemy->height / 2 - explosion->height / 2;
-                explosion->startTime = static_cast<Uint32>(currentTime);
-                explosions.push_back(explosion);
+            Uint32 currentTime = static_cast<Uint32>(game.getSimTicks());
+            world.each<Enemy, Transform>([&](Entity entity, Enemy&, Transform& transform) {
+                // 创建爆炸效果，每个敌人都有，不受MAX_EXPLOSIONS限制
+                spawnExplosion(world, explosionTemplate, {transform.position.x + transform.width / 2, transform.position.y + transform.height / 2}, currentTime);
                 
                 // 掉落道具和金币（不加分数）
-                if (rand() % 100 < 50) {
-                    dropItem(enemy);
+                if (rng.drops.nextInt(100) < 50) {
+                    dropItem(transform);
                 }
-                if (rand() % 100 < 70) {
-                    dropGold(enemy->position.x, enemy->position.y);
+                if (rng.drops.nextInt(100) < 70) {
+                    dropGold(transform.position.x, transform.position.y);
                 }
-                
-                delete enemy;
-            }
-            // 清空敌人列表
-            enemies.clear();
+                world.destroy(entity);
+            });
             // 播放爆炸音效
-            Mix_PlayChannel(-1, sounds["enemy_explode"], 0);
+            game.playSfx(SoundId::EnemyExplode);
         }
         break;
     case ItemType::Gold:
         // 金币效果：+10分
         score += 10;
-        Mix_PlayChannel(-1, sounds["get_item"], 0);
+        game.playSfx(SoundId::GetItem);
         return; // 直接返回，不执行下面的统一+5分
     }
     
     // 其他道具统一效果（除了金币）
     score += 5;
-    Mix_PlayChannel(-1, sounds["get_item"], 0);
-}
-
-
-void SceneMain::renderItems()
-{
-    for (auto &item : items)
-    {
-        SDL_FRect itemRect = {
-            item->position.x, 
-            item->position.y, 
-            item->width, 
-            item->height
-        };
-        
-        // 如果是金币，使用动画帧渲染
-        if (item->type == ItemType::Gold) {
-            SDL_FRect src = {
-                (float)(item->currentFrame * (item->texture->w / item->totlaFrame)), 
-                0.0f, 
-                (float)(item->texture->w / item->totlaFrame), 
-                (float)(item->texture->h)
-            };
-            SDL_RenderTexture(game.getRenderer(), item->texture, &src, &itemRect);
-        } else {
-            SDL_RenderTexture(game.getRenderer(), item->texture, NULL, &itemRect);
-        }
-    }   
+    game.playSfx(SoundId::GetItem);
 }
 
 // 修改renderUI函数（约第710行）
@@ -1182,9 +971,9 @@ void SceneMain::renderUI()
         SDL_RenderTexture(game.getRenderer(), uiShield, NULL, &shieldRect);
         
         // 渲染护盾数量文字
-        auto shieldText = "x" + std::to_string(player.currentShield);
+        const char* shieldText = game.getFrameArena().format("x%d", player.currentShield);
         SDL_Color color = {255, 255, 255, 255};
-        SDL_Surface* surface = TTF_RenderText_Solid(scoreFont, shieldText.c_str(), 0, color);
+        SDL_Surface* surface = TTF_RenderText_Solid(scoreFont, shieldText, 0, color);
         SDL_Texture* texture = SDL_CreateTextureFromSurface(game.getRenderer(), surface);
         SDL_FRect textRect = {x + size - 15, shieldY + 30, static_cast<float>(surface->w), static_cast<float>(surface->h)};
         SDL_RenderTexture(game.getRenderer(), texture, NULL, &textRect);
@@ -1193,9 +982,9 @@ void SceneMain::renderUI()
     }
     
     // 渲染得分
-    auto text = "SCORE:" + std::to_string(score);
+    const char* text = game.getFrameArena().format("SCORE:%d", score);
     SDL_Color color = {255, 255, 255, 255};
-    SDL_Surface* surface = TTF_RenderText_Solid(scoreFont, text.c_str(),0, color);
+    SDL_Surface* surface = TTF_RenderText_Solid(scoreFont, text, 0, color);
     SDL_Texture* texture = SDL_CreateTextureFromSurface(game.getRenderer(), surface);
     SDL_FRect rect = {game.getWindowWidth() - 10 - static_cast<float>(surface->w), 10, static_cast<float>(surface->w), static_cast<float>(surface->h)};
     SDL_RenderTexture(game.getRenderer(), texture, NULL, &rect);
@@ -1207,48 +996,31 @@ void SceneMain::renderUI()
 // dropGold函数应该保持在文件末尾
 void SceneMain::dropGold(float x, float y)
 {
-    Item* item = new Item();
-    *item = itemGoldTemplate;
-    item->position.x = x;
-    item->position.y = y;
     // 修复：使用随机方向而不是调用getDirection
-    float angle = static_cast<float>((rand() % 360) * M_PI / 180.0f);
-    item->direction.x = cos(angle);
-    item->direction.y = sin(angle);
-    item->speed = 100;
-    item->bounceCount = 3;
-    item->startTime = 0; // 重置动画时间
-    items.push_back(item);
+    SDL_FPoint direction;
+    float angle = static_cast<float>(rng.drops.nextInt(360) * SDL_PI_D / 180.0f);
+    fastSinCos(angle, direction.y, direction.x);
+    createItem(itemGoldTemplate, {x, y}, direction, 100);
 }
 
 // 敌人2的多方向射击函数
-void SceneMain::shootEnemyMultiDirection(Enemy *enemy, int bulletCount)
+void SceneMain::shootEnemyMultiDirection(const Transform& enemy, int bulletCount)
 {
     for (int i = 0; i < bulletCount; i++) {
-        auto* projectile = enemyBulletPool.create();
-        if (projectile == nullptr) {
-            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Enemy bullet pool exhausted!");
-            return;
-        }
-        
-        // 设置子弹属性
-        *projectile = projectileEnemyTemplate;  // 重置为模板状态
-        projectile->position.x = enemy->position.x + enemy->width / 2 - projectile->width / 2;
-        projectile->position.y = enemy->position.y + enemy->height / 2 - projectile->height / 2;
-        
         // 计算发射角度，均匀分布在360度范围内
         float angle = (360.0f / bulletCount) * i;
-        float radians = static_cast<float>(angle * M_PI / 180.0f);
+        float radians = static_cast<float>(angle * SDL_PI_D / 180.0f);
         
         // 设置子弹方向
-        projectile->direction.x = cos(radians);
-        projectile->direction.y = sin(radians);
-        
-        projectilesEnemy.push_back(projectile);
+        SDL_FPoint direction;
+        fastSinCos(radians, direction.y, direction.x);
+        if (!createEnemyShot(enemy, direction)) {
+            return;
+        }
     }
     
     // 播放射击音效
-    Mix_PlayChannel(-1, sounds["enemy_shoot"], 0);
+    game.playSfx(SoundId::EnemyShoot);
 }
 void SceneMain::renderPauseOverlay()
 {
@@ -1298,14 +1070,14 @@ void SceneMain::updateTransition(float deltaTime)
         case TransitionState::WAITING_CLEAR: {
             transitionTimer += deltaTime;
             // 检查所有敌人是否已经退场（列表为空）和子弹是否清理完毕
-            if (enemies.empty() && areAllBulletsCleared()) {
+            if (world.count<Enemy>() == 0 && areAllBulletsCleared()) {
                 // 直接跳转到准备Boss战状态，不需要移动玩家
                 transitionState = TransitionState::READY_FOR_BOSS;
                 transitionTimer = 0.0f;
                 enemiesRetreating = false; // 重置退场状态
                 
                 // 开始背景加速滚动
-                Game::getInstance().setBackgroundSpeed(60, 40);
+                game.setBackgroundSpeed(60, 40);
             }
             break;
         }
@@ -1323,7 +1095,7 @@ void SceneMain::updateTransition(float deltaTime)
                 shouldChangeToBoss = true;
                 
                 // 恢复背景正常滚动速度
-                Game::getInstance().setBackgroundSpeed(30, 20);
+                game.setBackgroundSpeed(30, 20);
             }
             break;
         }
@@ -1339,6 +1111,8 @@ void SceneMain::startBossTransition()
     if (transitionState == TransitionState::NORMAL) {
         transitionState = TransitionState::PREPARING_BOSS;
         transitionTimer = 0.0f;
+        // 过渡期间在后台打开Boss战音乐
+        game.preloadBgm(MusicId::Mouse);
         // 移除缩放相关的初始化
     }
 }
@@ -1346,7 +1120,7 @@ void SceneMain::startBossTransition()
 // 检查所有子弹是否已清理
 bool SceneMain::areAllBulletsCleared()
 {
-    return projectilesPlayer.empty() && projectilesEnemy.empty();
+    return world.count<PlayerShot>() == 0 && world.count<EnemyShot>() == 0;
 }
 
 // 移动主角到目标位置（现在不强制移动）
@@ -1363,23 +1137,20 @@ void SceneMain::clearAllEnemiesAndBullets()
     enemiesRetreating = true;
     
     // 清理所有敌人子弹
-    for (auto projectile : projectilesEnemy) {
-        enemyBulletPool.release(projectile);
-    }
-    projectilesEnemy.clear();
+    world.each<EnemyShot>([&](Entity shot, EnemyShot&) {
+        world.destroy(shot);
+    });
     
     // 清理所有玩家子弹
-    for (auto projectile : projectilesPlayer) {
-        playerBulletPool.release(projectile);
-    }
-    projectilesPlayer.clear();
+    world.each<PlayerShot>([&](Entity shot, PlayerShot&) {
+        world.destroy(shot);
+    });
 }
 
 // 渲染过渡效果
 void SceneMain::renderTransitionEffect()
 {
     if (transitionState == TransitionState::MOVING_TO_BOSS) {
-        auto& game = Game::getInstance();
         // 渲染提示信息
         game.renderTextCentered("Move to the left side to enter Boss battle!", 
                                game.getWindowHeight() - 100, true);
@@ -1421,7 +1192,7 @@ void SceneMain::generateUpgradeOptions()
         WeaponUpgrade::PIERCE_UP
     };
     
-    std::shuffle(allUpgrades.begin(), allUpgrades.end(), gen);
+    rng.drops.shuffle(allUpgrades);
     
     for (int i = 0; i < 3 && i < allUpgrades.size(); i++) {
         upgradeOptions.push_back(allUpgrades[i]);
@@ -1459,7 +1230,6 @@ void SceneMain::applyWeaponUpgrade(WeaponUpgrade upgrade)
 // 渲染武器升级界面
 void SceneMain::renderWeaponUpgradeUI()
 {
-    auto& game = Game::getInstance();
     SDL_Renderer* renderer = game.getRenderer();
     
     // 绘制半透明背景
@@ -1495,9 +1265,9 @@ void SceneMain::renderWeaponUpgradeUI()
         float optionY = centerY - 60 + i * 40;
         
         // 先获取文本尺寸
-        std::string optionText = getUpgradeText(upgradeOptions[i]);
+        const char* optionText = getUpgradeText(upgradeOptions[i]);
         SDL_Color textColor = {255, 255, 255, 255};
-        SDL_Surface* textSurface = TTF_RenderText_Solid(scoreFont, optionText.c_str(), 0, textColor);
+        SDL_Surface* textSurface = TTF_RenderText_Solid(scoreFont, optionText, 0, textColor);
         
         if (textSurface) {
             // 选中高亮 - 根据实际文本大小调整
@@ -1547,7 +1317,7 @@ void SceneMain::handleWeaponUpgradeInput(SDL_Event* event)
                 selectedUpgrade = (selectedUpgrade + 1) % upgradeOptions.size();
                 break;
             case SDL_SCANCODE_RETURN:
-                applyWeaponUpgrade(upgradeOptions[selectedUpgrade]);
+                game.requestUpgradeChoice(selectedUpgrade); // 在下一个逻辑帧生效
                 break;
         }
     }
@@ -1556,41 +1326,31 @@ void SceneMain::handleWeaponUpgradeInput(SDL_Event* event)
 // 使用武器系统的射击
 void SceneMain::shootPlayerWithWeapon()
 {
-    Uint64 currentTime = SDL_GetTicks();
+    Uint64 currentTime = game.getSimTicks();
     Uint64 weaponCooldown = player.weapon.getCooldown(player.coolDown);
     
     if (currentTime - player.lastShootTime >= weaponCooldown) {
         player.lastShootTime = currentTime;
         
         // 播放射击音效
-        if (sounds["player_shoot"]) {
-            Mix_PlayChannel(-1, sounds["player_shoot"], 0);
-        }
+        game.playSfx(SoundId::PlayerShoot);
         
         // 根据分裂数量创建子弹
         if (player.weapon.splitCount == 1) {
-            // 单发子弹
-            auto* bullet = playerBulletPool.create();
-            if (bullet) {
-                *bullet = projectilePlayerTemplate;
-                
-                // 根据主角朝向设置子弹位置和方向
-                if (player.flip == SDL_FLIP_HORIZONTAL) {
-                    // 向左发射
-                    bullet->position.x = player.position.x - bullet->width;
-                    bullet->direction = {-1, 0};
-                } else {
-                    // 向右发射
-                    bullet->position.x = player.position.x + player.width;
-                    bullet->direction = {1, 0};
-                }
-                
-                bullet->position.y = player.position.y + player.height / 2 - bullet->height / 2;
-                bullet->damage = player.weapon.damage;
-                bullet->maxBounces = player.weapon.bounceCount;
-                bullet->bounceCount = 0;
-                projectilesPlayer.push_back(bullet);
+            // 单发子弹，根据主角朝向设置子弹位置和方向
+            SDL_FPoint position;
+            SDL_FPoint direction;
+            if (player.flip == SDL_FLIP_HORIZONTAL) {
+                // 向左发射
+                position.x = player.position.x - projectilePlayerTemplate.width;
+                direction = {-1, 0};
+            } else {
+                // 向右发射
+                position.x = player.position.x + player.width;
+                direction = {1, 0};
             }
+            position.y = player.position.y + player.height / 2 - projectilePlayerTemplate.height / 2;
+            createPlayerShot(position, direction);
         } else {
             // 分裂子弹
             SDL_FPoint startPos = {
@@ -1613,30 +1373,25 @@ void SceneMain::createSplitBullets(SDL_FPoint startPos, SDL_FPoint direction, in
     float angleStep = 0.5f; // 分裂角度间隔
     float startAngle = -(count - 1) * angleStep / 2.0f;
     
+    // 所有分裂方向的正弦余弦一次算出
+    FrameArena& arena = game.getFrameArena();
+    FrameVector<float> sines(count, 0.0f, ArenaAllocator<float>(arena));
+    FrameVector<float> cosines(count, 0.0f, ArenaAllocator<float>(arena));
     for (int i = 0; i < count; i++) {
-        auto* bullet = playerBulletPool.create();
-        if (bullet) {
-            *bullet = projectilePlayerTemplate;
-            bullet->position.x = startPos.x;
-            bullet->position.y = startPos.y;
-            bullet->position.w = bullet->width;
-            bullet->position.h = bullet->height;
-            
-            float angle = startAngle + i * angleStep;
-            bullet->direction.x = direction.x * cos(angle) - direction.y * sin(angle);
-            bullet->direction.y = direction.x * sin(angle) + direction.y * cos(angle);
-            
-            bullet->damage = player.weapon.damage;
-            bullet->maxBounces = player.weapon.bounceCount;
-            bullet->bounceCount = 0;
-            
-            projectilesPlayer.push_back(bullet);
-        }
+        sines[i] = startAngle + i * angleStep;
+    }
+    fastSinCosBatch(sines.data(), sines.data(), cosines.data(), sines.size());
+    
+    for (int i = 0; i < count; i++) {
+        SDL_FPoint bulletDirection;
+        bulletDirection.x = direction.x * cosines[i] - direction.y * sines[i];
+        bulletDirection.y = direction.x * sines[i] + direction.y * cosines[i];
+        createPlayerShot(startPos, bulletDirection);
     }
 }
 
 // 获取升级选项文本
-std::string SceneMain::getUpgradeText(WeaponUpgrade upgrade)
+const char* SceneMain::getUpgradeText(WeaponUpgrade upgrade)
 {
     switch (upgrade) {
         case WeaponUpgrade::DAMAGE_UP:
@@ -1652,4 +1407,125 @@ std::string SceneMain::getUpgradeText(WeaponUpgrade upgrade)
         default:
             return "未知升级";
     }
-}
\ No newline at end of file
+}
+// 按固定顺序把影响游戏逻辑的状态写入哈希，纹理、字体等只影响画面的字段不参与
+void SceneMain::hashState(StateHasher& hasher) const
+{
+    hasher.beginEntity(HashCategory::Player);
+    hasher.add(player.position);
+    hasher.add(player.currentHealth);
+    hasher.add(player.currentShield);
+    hasher.add(player.lastShootTime);
+    hasher.add(player.weapon.damage);
+    hasher.add(player.weapon.fireRate);
+    hasher.add(player.weapon.bounceCount);
+    hasher.add(player.weapon.splitCount);
+    hasher.add(player.weapon.piercing);
+    hasher.add(player.weapon.level);
+    hasher.add(isDead);
+
+    world.each<Enemy, Transform, Sprite>([&](Entity entity, const Enemy& enemy, const Transform& transform, const Sprite& sprite) {
+        hasher.beginEntity(HashCategory::Enemies);
+        hasher.add(transform.position);
+        hasher.add(enemy.currentHealth);
+        hasher.add(enemy.type);
+        hasher.add(sprite.rotation);
+        // 摆动和沿路径移动的敌人各自的计时
+        float moveTimer = 0.0f;
+        if (const EnemyDrift* drift = world.get<EnemyDrift>(entity)) {
+            moveTimer = drift->moveTimer;
+        } else if (const EnemyPath* path = world.get<EnemyPath>(entity)) {
+            moveTimer = path->moveTimer;
+        }
+        hasher.add(moveTimer);
+        hasher.add(enemy.lastShootTime);
+    });
+    world.each<PlayerShot, Transform, Velocity>([&](Entity, const PlayerShot& projectile, const Transform& transform,
+                                                    const Velocity& velocity) {
+        hasher.beginEntity(HashCategory::PlayerShots);
+        hasher.add(transform.position);
+        hasher.add(velocity.direction);
+        hasher.add(projectile.bounceCount);
+        hasher.add(projectile.damage);
+    });
+    world.each<EnemyShot, Transform, Velocity>([&](Entity, const EnemyShot&, const Transform& transform, const Velocity& velocity) {
+        hasher.beginEntity(HashCategory::EnemyShots);
+        hasher.add(transform.position);
+        hasher.add(velocity.direction);
+    });
+    world.each<Pickup, Transform, Velocity>([&](Entity, const Pickup& pickup, const Transform& transform, const Velocity& velocity) {
+        hasher.beginEntity(HashCategory::Items);
+        hasher.add(transform.position);
+        hasher.add(velocity.direction);
+        hasher.add(pickup.bounceCount);
+        hasher.add(pickup.type);
+    });
+    world.each<Effect, Transform, SpriteAnimation>([&](Entity, const Effect&, const Transform& transform, const SpriteAnimation& animation) {
+        hasher.beginEntity(HashCategory::Effects);
+        hasher.add(transform.position);
+        hasher.add(animation.startTime);
+    });
+    // 各类实体的数量单独作为一个实体，漏删的实体也能被发现
+    hasher.beginEntity(HashCategory::Effects);
+    hasher.add(world.count<Enemy>());
+    hasher.add(world.count<PlayerShot>());
+    hasher.add(world.count<EnemyShot>());
+    hasher.add(world.count<Effect>());
+
+    hasher.beginEntity(HashCategory::Score);
+    hasher.add(score);
+    hasher.add(lastUpgradeScore);
+    hasher.add(weaponUpgradeAvailable);
+    hasher.add(weaponUpgradePaused);
+    hasher.add(isPaused);
+    hasher.add(transitionState);
+    hasher.add(transitionTimer);
+    hasher.add(timerEnd);
+
+    hasher.beginEntity(HashCategory::Rng);
+    hasher.add(rng.spawn);
+    hasher.add(rng.drops);
+    hasher.add(rng.boss);
+    hasher.add(rng.cosmetic);
+}
+
+void SceneMain::fillBotView(BotView& view) const
+{
+    view.controllable = !isDead && !isPaused;
+    view.player = {player.position.x, player.position.y, player.width, player.height};
+    view.playerSpeed = static_cast<float>(player.speed);
+    view.facingLeft = player.flip == SDL_FLIP_HORIZONTAL;
+    view.canTurn = true;
+    view.fieldWidth = game.getWindowWidth();
+    view.fieldHeight = game.getWindowHeight();
+    if (weaponUpgradeAvailable) {
+        view.upgrades = upgradeOptions;
+    }
+
+    // 敌人机体也会撞伤玩家；退场时向右加速移动
+    bool retreating = transitionState == TransitionState::PREPARING_BOSS || enemiesRetreating;
+    world.each<Enemy, Transform>([&](Entity entity, const Enemy& enemy, const Transform& transform) {
+        const EnemyArchetype& archetype = archetypeOf(enemy);
+        SDL_FRect rect = {transform.position.x, transform.position.y, transform.width, transform.height};
+        BotThreat threat;
+        threat.rect = rect;
+        threat.velocity = {retreating ? archetype.def->speed * 2.0f : -archetype.def->speed, 0};
+        const EnemyPath* path = world.get<EnemyPath>(entity);
+        if (!retreating && path != nullptr) {
+            SDL_FPoint direction = enemyPaths[path->path].direction(archetype.def->speed * path->moveTimer);
+            threat.velocity = {direction.x * archetype.def->speed, direction.y * archetype.def->speed};
+        }
+        view.threats.push_back(threat);
+        view.targets.push_back(rect);
+    });
+    world.each<EnemyShot, Transform, Velocity, Hitbox>([&](Entity, const EnemyShot&, const Transform& transform,
+                                                           const Velocity& velocity, const Hitbox& hitbox) {
+        BotThreat threat;
+        threat.rect = hitboxRect(transform, hitbox);
+        threat.velocity = {velocity.direction.x * velocity.speed, velocity.direction.y * velocity.speed};
+        view.threats.push_back(threat);
+    });
+    world.each<Pickup, Transform>([&](Entity, const Pickup&, const Transform& transform) {
+        view.pickups.push_back({transform.position.x + transform.width / 2, transform.position.y + transform.height / 2});
+    });
+}
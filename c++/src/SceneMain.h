@@ -3,13 +3,15 @@
 
 #include "Scene.h"
 #include "Object.h"
-#include <list>
-#include <random>
+#include "EnemyArchetype.h"
+#include "EnemyPaths.h"
+#include "EcsSystems.h"
+#include "WaveSchedule.h"
 #include <map>
 #include <SDL3/SDL.h>
 #include <SDL3_mixer/SDL_mixer.h>
 #include <SDL3_ttf/SDL_ttf.h>
-#include "ObjectPool.h" 
+#include "Random.h"
 
 class Game;
 
@@ -34,11 +36,18 @@ public:
         player.position.x = 400;
         player.position.y = 300;
     }
+    explicit SceneMain(GameServices& services) : Scene(services), uiShield(nullptr), uiHealth(nullptr), scoreFont(nullptr), bgm(nullptr)
+    {
+        player.position.x = 400;
+        player.position.y = 300;
+    }
     void update(float deltaTime) override; // 更新逻辑
     void render() override; // 渲染
     void handleEvent(SDL_Event* event) override; // 处理输入
     void init() override; // 初始化
     void clean() override; // 清理资源
+    void hashState(StateHasher& hasher) const override; // 写入状态哈希
+    void fillBotView(BotView& view) const override; // 填写机器人视图
     bool shouldChangeToBoss = false; // 标记是否需要切换到Boss场景
     bool enemiesRetreating = false; // 敌人是否正在退场
    
@@ -54,8 +63,7 @@ private:
 
     bool isDead = false; // 玩家是否死亡
     bool isPaused = false; // 游戏是否暂停
-    std::mt19937 gen; // 随机数生成器
-    std::uniform_real_distribution<float> dis; // 随机数分布器
+    RngStreams rng; // 本局的随机数流
 
     // 过渡状态管理
     TransitionState transitionState = TransitionState::NORMAL;
@@ -64,9 +72,8 @@ private:
     float playerMoveSpeed = 200.0f; // 主角移动到目标位置的速度
     
     // 模板对象
-    Enemy enemyTemplate; // 敌人模板
-    Enemy enemyTemplate1; // 敌人1模板
-    Enemy enemyTemplate2; // 敌人2模板
+    EnemyArchetype enemyArchetypes[ENEMY_ARCHETYPE_COUNT]; // 各类敌人共用的纹理和尺寸
+    MotionPath enemyPaths[ENEMY_PATH_COUNT]; // 加载时烘焙的敌人移动路径
     ProjectilePlayer projectilePlayerTemplate; // 玩家子弹模板
     ProjectileEnemy projectileEnemyTemplate; // 敌人子弹模板
     Explosion explosionTemplate; // 爆炸模板
@@ -76,49 +83,52 @@ private:
     Item itemGoldTemplate; // 金币道具模板（带动画）
 
     // 游戏对象容器
-    std::list<Enemy*> enemies; // 敌人列表
-    std::list<ProjectilePlayer*> projectilesPlayer; // 玩家子弹列表
-    std::list<ProjectileEnemy*> projectilesEnemy; // 敌人子弹列表
-    std::list<Explosion*> explosions; // 爆炸列表
-    std::list<Item*> items; // 道具列表
-    std::map<std::string, Mix_Chunk*> sounds; // 音效
+    Uint32 nextEnemyId = 1; // 下一个生成的敌人的编号
+    WaveSchedule waves; // 敌人波次时间表（按难度选择）
+    EcsWorld world; // 敌人（按移动方式分原型）、玩家和敌人的子弹、道具、爆炸特效
+    static constexpr size_t MAX_PLAYER_SHOTS = 50; // 同时存在的玩家子弹上限
+    static constexpr size_t MAX_ENEMY_SHOTS = 200; // 同时存在的敌人子弹上限
+    static constexpr size_t MAX_EXPLOSIONS = 20; // 敌人被击毁时同时存在的爆炸上限
 
     // 渲染相关
-    void renderItems(); // 渲染道具
     void renderUI(); // 渲染UI
-    void renderExplosions(); // 渲染爆炸
-    void renderPlayerProjectiles(); // 渲染玩家子弹
-    void renderEnemyProjectiles(); // 渲染敌人子弹
-    void renderEnemies(); // 渲染敌人
 
     // 更新相关
-    void updateEnemies(float deltaTime); // 更新敌人
+    void updateEnemies(float deltaTime); // 更新敌人：依次执行下面的各个行为
+    void retreatEnemies(float deltaTime); // 退场：所有敌人向右加速移动
+    void moveEnemies(float deltaTime); // 所有敌人向左移动
+    void driftEnemies(float deltaTime); // 上下摆动（带EnemyDrift的敌人）
+    void followEnemyPaths(float deltaTime); // 沿路径移动（带EnemyPath的敌人）
+    void spinEnemies(float deltaTime); // 旋转（带EnemySpin的敌人）
+    void fireEnemies(); // 冷却结束的敌人按类型的射击方式射击
+    void removeEnemies(); // 删除移出屏幕和被击毁的敌人
     void updateEnemyProjectiles(float deltaTime); // 更新敌人子弹
     void updatePlayer(float deltaTime); // 更新玩家
     void updateItems(float deltaTime); // 更新道具
     void updateExplosions(float deltaTime); // 更新爆炸
-    void updatePlayerProjectiles(float deltaTime); // 更新玩家子弹
+    void updatePlayerProjectiles(float deltaTime); // 按当前武器选择特化的playerShotSystem更新玩家子弹
     void keyboardControl(float deltaTime); // 键盘控制
-    void spawEnemy(); // 生成敌人
+    void spawEnemy(float deltaTime); // 按波次时间表生成敌人
+    void spawnWave(const WaveEvent& wave); // 按队形生成一波敌人
+    Entity createEnemy(int type, SDL_FPoint position, EnemyMotion motion, int path = 0); // 生成一个敌人，按移动方式带上对应的组件，path为路径下标
     void changeSceneDelayed(float deltaTime, float delay); // 延迟切换场景
 
     // 其它
-    void playerGetItem(Item* item); // 玩家获得道具
+    void playerGetItem(ItemType type); // 玩家获得道具
     void shootPlayer(); // 玩家射击
-    void shootEnemy(Enemy* enemy); // 敌人射击
-    SDL_FPoint getDirection(Enemy *enemy) const; // 获取敌人射击方向
-    void enemyExplode(Enemy* enemy); // 敌人爆炸
-    void dropItem(Enemy* enemy); // 敌人掉落道具
+    bool createPlayerShot(SDL_FPoint position, SDL_FPoint direction); // 按当前武器发射一颗子弹，达到上限时返回false
+    void shootEnemy(const Transform& enemy); // 敌人射击
+    SDL_FPoint getDirection(const Transform& enemy) const; // 获取敌人射击方向
+    void enemyExplode(const Transform& enemy); // 敌人爆炸
+    void dropItem(const Transform& enemy); // 敌人掉落道具
     void dropGold(float x, float y); // 新增金币掉落函数
+    void createItem(const Item& itemTemplate, SDL_FPoint position, SDL_FPoint direction, float speed); // 用模板创建道具
     void renderPauseOverlay(); // 渲染暂停覆盖层
     // 敌人2的多方向射击函数
-    void shootEnemyMultiDirection(Enemy* enemy, int bulletCount);
-    
-    // 添加对象池
-    ObjectPool<ProjectilePlayer> playerBulletPool;
-    ObjectPool<ProjectileEnemy> enemyBulletPool;
-    ObjectPool<Explosion> explosionPool; // 爆炸对象池
-
+    void shootEnemyMultiDirection(const Transform& enemy, int bulletCount);
+    bool createEnemyShot(const Transform& enemy, SDL_FPoint direction); // 从敌人中心发射一颗子弹，达到上限时返回false
+    void createExplosion(SDL_FPoint center); // 在指定中心创建爆炸，受MAX_EXPLOSIONS限制
+    const EnemyArchetype& archetypeOf(const Enemy& enemy) const { return enemyArchetypes[enemy.type]; } // 敌人的类型数据
     
     // 新增过渡相关函数
     void updateTransition(float deltaTime); // 更新过渡状态
@@ -147,7 +157,7 @@ private:
     // 修改射击函数以支持武器系统
     void shootPlayerWithWeapon();           // 使用武器系统的射击
     void createSplitBullets(SDL_FPoint startPos, SDL_FPoint direction, int count); // 创建分裂子弹
-    std::string getUpgradeText(WeaponUpgrade upgrade); // 获取升级选项文本
+    const char* getUpgradeText(WeaponUpgrade upgrade); // 获取升级选项文本
 };
 
 #endif // SCENE_MAIN_H
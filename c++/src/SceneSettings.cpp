@@ -7,7 +7,7 @@
 void SceneSettings::init()
 {
     // 使用全局音乐管理播放幻想.mp3（不会重新开始播放）
-    Game::getInstance().playBgm("assets/music/幻想.mp3");
+    Game::getInstance().playBgm(MusicId::Fantasy);
     
     loadSettings();
     initButtons();
@@ -131,7 +131,7 @@ void SceneSettings::renderSliders()
     
     for (auto& slider : sliders) {
         // 渲染标签
-        std::string labelText = slider.label + ": " + std::to_string(slider.value) + "%";
+        const char* labelText = game.getFrameArena().format("%s: %d%%", slider.label.c_str(), slider.value);
         game.renderTextPos(labelText, slider.rect.x, slider.rect.y - 40, true);
         
         // 渲染滑动条轨道
@@ -184,7 +184,7 @@ void SceneSettings::handleEvent(SDL_Event *event)
                 if (isPointInButton(buttons[i], mouseX, mouseY)) {
                     buttons[i].isPressed = true;
                     // 播放按钮点击音效
-                    Game::getInstance().playSfx("button_click");
+                    Game::getInstance().playSfx(SoundId::ButtonClick);
                     break;
                 }
             }
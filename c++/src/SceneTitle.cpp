@@ -8,11 +8,20 @@
 void SceneTitle::init()
 {
     // 使用全局音乐管理播放幻想.mp3
-    Game::getInstance().playBgm("assets/music/幻想.mp3");
+    Game::getInstance().playBgm(MusicId::Fantasy);
+    // 预先打开游戏场景音乐，开始游戏时无需等待文件读取
+    Game::getInstance().preloadBgm(MusicId::Classroom);
     
     showLeaderboard = false;
     showHelp = false;
     initButtons();
+
+    // 排行榜只在进入场景时读取，渲染时不再重新查询
+    auto& history = Game::getInstance().getRunHistory();
+    leaderboard.clear();
+    for (const auto* run : history.topRuns(Game::getInstance().getDifficulty(), 8)) {
+        leaderboard.push_back(*run);
+    }
     
     // 初始化提示按钮
     auto& game = Game::getInstance();
@@ -60,7 +69,7 @@ void SceneTitle::handleEvent(SDL_Event *event)
             if (isPointInButton(helpButton, mouseX, mouseY)) {
                 helpButton.isPressed = true;
                 // 播放按钮点击音效
-                Game::getInstance().playSfx("button_click");
+                Game::getInstance().playSfx(SoundId::ButtonClick);
                 return;
             }
             
@@ -68,7 +77,7 @@ void SceneTitle::handleEvent(SDL_Event *event)
                 if (isPointInButton(buttons[i], mouseX, mouseY)) {
                     buttons[i].isPressed = true;
                     // 播放按钮点击音效
-                    Game::getInstance().playSfx("button_click");
+                    Game::getInstance().playSfx(SoundId::ButtonClick);
                     break;
                 }
             }
@@ -314,18 +323,18 @@ void SceneTitle::renderLeaderboard()
     auto& game = Game::getInstance();
     
     // 显示当前难度的排行榜
-    std::string title = "得分榜 - ";
+    const char* difficultyName = "";
     switch(game.getDifficulty()) {
-        case 0: title += "简单"; break;
-        case 1: title += "普通"; break;
-        case 2: title += "困难"; break;
+        case 0: difficultyName = "简单"; break;
+        case 1: difficultyName = "普通"; break;
+        case 2: difficultyName = "困难"; break;
     }
     
-    game.renderTextCentered(title, 0.05f, true);
+    game.renderTextCentered(game.getFrameArena().format("得分榜 - %s", difficultyName), 0.05f, true);
     
     int index = 1;
-    for (const auto& item : game.getLeaderBoard()){
-        std::string text = std::to_string(index) + ". " + item.second + ": " + std::to_string(item.first);
+    for (const auto& run : leaderboard){
+        const char* text = game.getFrameArena().format("%d. %s: %d", index, run.name.c_str(), run.score);
         game.renderTextCentered(text, 0.15f + index * 0.08f, false);
         index++;
     }
@@ -3,6 +3,7 @@
 
 #include "Scene.h"
 #include "Object.h"
+#include "RunHistory.h"
 #include <SDL3/SDL.h>
 #include <SDL3_image/SDL_image.h>
 #include <SDL3_ttf/SDL_ttf.h>
@@ -34,6 +35,7 @@ private:
     float timer = 0.0f; // 通用计时器
     bool showLeaderboard; // 是否显示排行榜界面
     bool showHelp; // 是否显示帮助信息
+    std::vector<RunRecord> leaderboard; // 当前难度得分最高的记录，init时读取一次
     
     // UI元素
     std::vector<Button> buttons; // 主要按钮列表
@@ -0,0 +1,146 @@
+#include "SfxManager.h"
+#include <cstring>
+
+// 播放规则表，顺序与SoundId一致
+const SfxManager::SoundConfig SfxManager::configs[static_cast<int>(SoundId::Count)] = {
+    // 路径                                 发声上限 优先级 重播间隔
+    {"assets/sound/laser_shoot4.mp3",       2,       1,     50},  // PlayerShoot
+    {"assets/sound/xs_laser.mp3",           4,       1,     60},  // EnemyShoot
+    {"assets/sound/xs_laser.mp3",           2,       1,     80},  // BossShoot
+    {"assets/sound/eff11.mp3",              4,       2,     40},  // Hit
+    {"assets/sound/eff5.mp3",               3,       3,     30},  // GetItem
+    {"assets/sound/explosion3.mp3",         6,       3,     30},  // EnemyExplode
+    {"assets/sound/explosion3.mp3",         3,       4,     50},  // BossExplode
+    {"assets/sound/角色死亡音效.mp3",       1,       5,     0},   // PlayerExplode
+    {"assets/sound/死亡音效.mp3",           1,       5,     0},   // PlayerDeath
+    {"assets/sound/按钮声音.mp3",           2,       5,     0},   // ButtonClick
+};
+
+void SfxManager::init()
+{
+    // 设置音效channel数量
+    Mix_AllocateChannels(CHANNEL_COUNT);
+
+    for (int i = 0; i < static_cast<int>(SoundId::Count); i++) {
+        // 相同文件只加载一次
+        for (int j = 0; j < i; j++) {
+            if (std::strcmp(configs[i].path, configs[j].path) == 0) {
+                chunks[i] = chunks[j];
+                break;
+            }
+        }
+        if (chunks[i] == nullptr) {
+            chunks[i] = Mix_LoadWAV(configs[i].path);
+            if (chunks[i] == nullptr) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load sound %s: %s", configs[i].path, SDL_GetError());
+            }
+        }
+        requests[i] = 0;
+        hasPlayed[i] = false;
+    }
+    for (auto& voice : voices) {
+        voice = Voice();
+    }
+}
+
+void SfxManager::clean()
+{
+    for (int i = 0; i < static_cast<int>(SoundId::Count); i++) {
+        if (chunks[i] == nullptr) {
+            continue;
+        }
+        // 共享的音效只释放一次
+        Mix_Chunk* chunk = chunks[i];
+        for (int j = i; j < static_cast<int>(SoundId::Count); j++) {
+            if (chunks[j] == chunk) {
+                chunks[j] = nullptr;
+            }
+        }
+        Mix_FreeChunk(chunk);
+    }
+}
+
+void SfxManager::flush(Uint64 now)
+{
+    // 回收已播放完毕的通道
+    for (int ch = 0; ch < CHANNEL_COUNT; ch++) {
+        if (voices[ch].sound >= 0 && !Mix_Playing(ch)) {
+            voices[ch].sound = -1;
+        }
+    }
+
+    // 按优先级从高到低派发，同一帧的重复请求只播放一次
+    for (int priority = 5; priority >= 0; priority--) {
+        for (int i = 0; i < static_cast<int>(SoundId::Count); i++) {
+            if (requests[i] == 0 || configs[i].priority != priority) {
+                continue;
+            }
+            requests[i] = 0;
+            if (chunks[i] == nullptr) {
+                continue;
+            }
+            if (hasPlayed[i] && now - lastPlayTime[i] < configs[i].minIntervalMs) {
+                continue; // 距上次播放太近，合并到上一次
+            }
+            dispatch(i, now);
+        }
+    }
+}
+
+void SfxManager::dispatch(int sound, Uint64 now)
+{
+    // 统计该音效当前的发声数，并找出最早开始的通道
+    int activeVoices = 0;
+    int oldestChannel = -1;
+    for (int ch = 0; ch < CHANNEL_COUNT; ch++) {
+        if (voices[ch].sound != sound) {
+            continue;
+        }
+        activeVoices++;
+        if (oldestChannel < 0 || voices[ch].startTime < voices[oldestChannel].startTime) {
+            oldestChannel = ch;
+        }
+    }
+
+    int channel;
+    if (activeVoices >= configs[sound].maxVoices) {
+        // 达到上限时在最早的通道上重新播放
+        channel = Mix_PlayChannel(oldestChannel, chunks[sound], 0);
+    } else {
+        channel = Mix_PlayChannel(-1, chunks[sound], 0);
+        if (channel < 0) {
+            // 没有空闲通道，尝试抢占低优先级音效
+            int victim = findVictim(sound);
+            if (victim < 0) {
+                return;
+            }
+            channel = Mix_PlayChannel(victim, chunks[sound], 0);
+        }
+    }
+
+    if (channel >= 0 && channel < CHANNEL_COUNT) {
+        voices[channel].sound = sound;
+        voices[channel].startTime = now;
+        lastPlayTime[sound] = now;
+        hasPlayed[sound] = true;
+    }
+}
+
+int SfxManager::findVictim(int sound) const
+{
+    int victim = -1;
+    for (int ch = 0; ch < CHANNEL_COUNT; ch++) {
+        int other = voices[ch].sound;
+        if (other < 0 || configs[other].priority >= configs[sound].priority) {
+            continue;
+        }
+        // 优先抢占优先级最低、开始最早的通道
+        if (victim < 0 ||
+            configs[other].priority < configs[voices[victim].sound].priority ||
+            (configs[other].priority == configs[voices[victim].sound].priority &&
+             voices[ch].startTime < voices[victim].startTime)) {
+            victim = ch;
+        }
+    }
+    return victim;
+}
@@ -0,0 +1,74 @@
+#ifndef SFX_MANAGER_H
+#define SFX_MANAGER_H
+
+#include <SDL3/SDL.h>
+#include <SDL3_mixer/SDL_mixer.h>
+
+// 音效枚举，代替字符串查找
+enum class SoundId {
+    PlayerShoot,    // 玩家射击
+    EnemyShoot,     // 敌人射击
+    BossShoot,      // Boss射击
+    Hit,            // 子弹命中
+    GetItem,        // 拾取道具
+    EnemyExplode,   // 敌人爆炸
+    BossExplode,    // Boss爆炸
+    PlayerExplode,  // 玩家爆炸
+    PlayerDeath,    // 玩家死亡
+    ButtonClick,    // 按钮点击
+    Count           // 音效数量
+};
+
+/**
+ * 音效管理器
+ * 游戏逻辑只提交播放请求，每帧结束时统一派发：
+ * 同一帧内的重复请求合并为一次，按优先级分配通道，
+ * 并限制每种音效的同时发声数和最短重播间隔
+ */
+class SfxManager
+{
+public:
+    static constexpr int CHANNEL_COUNT = 32; // 混音通道数量
+
+    void init();  // 分配通道并加载所有音效
+    void clean(); // 释放所有音效
+
+    /**
+     * 提交音效播放请求，在flush时才真正播放
+     * @param id 音效
+     */
+    void play(SoundId id) { requests[static_cast<int>(id)]++; }
+
+    /**
+     * 派发本帧的所有播放请求
+     * @param now 当前时间（毫秒）
+     */
+    void flush(Uint64 now);
+
+private:
+    // 每种音效的播放规则
+    struct SoundConfig {
+        const char* path;      // 文件路径
+        int maxVoices;         // 同时发声上限
+        int priority;          // 优先级（0-5），通道不足时高优先级可抢占低优先级
+        Uint32 minIntervalMs;  // 最短重播间隔（毫秒）
+    };
+    static const SoundConfig configs[static_cast<int>(SoundId::Count)];
+
+    // 通道占用情况
+    struct Voice {
+        int sound = -1;        // 正在播放的音效，-1为空闲
+        Uint64 startTime = 0;  // 开始播放时间
+    };
+
+    Mix_Chunk* chunks[static_cast<int>(SoundId::Count)] = {nullptr};
+    int requests[static_cast<int>(SoundId::Count)] = {0};   // 本帧请求次数
+    Uint64 lastPlayTime[static_cast<int>(SoundId::Count)] = {0};
+    bool hasPlayed[static_cast<int>(SoundId::Count)] = {false};
+    Voice voices[CHANNEL_COUNT];
+
+    void dispatch(int sound, Uint64 now); // 播放单个音效
+    int findVictim(int sound) const;      // 寻找可被抢占的通道，找不到返回-1
+};
+
+#endif // SFX_MANAGER_H
@@ -0,0 +1,140 @@
+#include "SimWorld.h"
+#include "SceneMain.h"
+#include "SceneBoss.h"
+#include <SDL3_image/SDL_image.h>
+#include <map>
+#include <mutex>
+
+namespace
+{
+    // 图片原始大小，所有模拟共用，每张图片只在第一次用到时读取
+    std::mutex imageSizeMutex;
+    std::map<std::string, SDL_FPoint> imageSizes;
+
+    SDL_FPoint getImageSize(const char* path)
+    {
+        std::lock_guard<std::mutex> lock(imageSizeMutex);
+        auto it = imageSizes.find(path);
+        if (it != imageSizes.end()) {
+            return it->second;
+        }
+        SDL_FPoint size = {0, 0};
+        SDL_Surface* surface = IMG_Load(path);
+        if (surface != nullptr) {
+            size = {static_cast<float>(surface->w), static_cast<float>(surface->h)};
+            SDL_DestroySurface(surface);
+        } else {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to load image %s: %s", path, SDL_GetError());
+        }
+        imageSizes[path] = size;
+        return size;
+    }
+}
+
+SimWorld::SimWorld(const SimWorldConfig& config) : config(config)
+{
+    if (this->config.fps <= 0) {
+        this->config.fps = 60;
+    }
+    deltaTime = 1.0f / this->config.fps;
+}
+
+SimWorld::~SimWorld()
+{
+    if (currentScene != nullptr) {
+        currentScene->clean();
+        delete currentScene;
+    }
+}
+
+bool SimWorld::start()
+{
+    bot = BotController::create(config.botKind, config.botUpgrades);
+    if (bot == nullptr) {
+        return false;
+    }
+    if (config.startAtBoss) {
+        // 与Game中直接进入Boss战的设置相同
+        beginRun();
+        Player player;
+        player.position.x = 100;
+        player.position.y = config.fieldHeight / 2;
+        changeScene(new SceneBoss(*this, 0, player));
+    } else {
+        changeScene(new SceneMain(*this));
+    }
+    return true;
+}
+
+void SimWorld::step()
+{
+    if (isDone()) {
+        return;
+    }
+    frameArena.reset();
+    botView.clear();
+    currentScene->fillBotView(botView);
+    input = bot->decide(botView, simTicks);
+    currentScene->update(deltaTime); // 可能切换场景，之后不再使用旧场景
+    simTicks++;
+    ticks++;
+    result.ticks = ticks;
+}
+
+SimResult SimWorld::run()
+{
+    while (!isDone()) {
+        step();
+    }
+    return result;
+}
+
+const TickHash& SimWorld::hashState()
+{
+    // 与Game相同，记为刚完成的逻辑帧，哈希日志可以互相比较
+    stateHasher.beginTick(static_cast<Uint32>(simTicks > 0 ? simTicks - 1 : 0));
+    currentScene->hashState(stateHasher);
+    return stateHasher.endTick();
+}
+
+SDL_Texture* SimWorld::loadTexture(const char* path, float* width, float* height)
+{
+    // 不创建纹理，只提供碰撞框需要的大小
+    if (width != nullptr || height != nullptr) {
+        SDL_FPoint size = getImageSize(path);
+        if (width != nullptr) {
+            *width = size.x;
+        }
+        if (height != nullptr) {
+            *height = size.y;
+        }
+    }
+    return nullptr;
+}
+
+void SimWorld::changeScene(Scene* scene)
+{
+    Scene* oldScene = currentScene;
+    currentScene = scene;
+    if (currentScene != nullptr) {
+        currentScene->init();
+    }
+    if (oldScene != nullptr) {
+        oldScene->clean();
+        delete oldScene;
+    }
+}
+
+void SimWorld::endRun(const Weapon& weapon, BossProgress progress)
+{
+    result.durationMs = static_cast<Uint32>(getSimTicks());
+    result.weapon = weapon;
+    result.bossProgress = progress;
+}
+
+void SimWorld::showRunResult(bool victory)
+{
+    result.victory = victory;
+    result.finished = true;
+    finished = true;
+}
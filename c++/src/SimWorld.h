@@ -0,0 +1,105 @@
+#ifndef SIM_WORLD_H
+#define SIM_WORLD_H
+
+#include "GameServices.h"
+#include "Scene.h"
+#include "Profiler.h"
+#include "StateHasher.h"
+#include "BotController.h"
+#include <SDL3/SDL.h>
+#include <memory>
+#include <string>
+
+// 一个模拟的设置
+struct SimWorldConfig {
+    Uint64 seed = 0;                  // 本局随机种子
+    int difficulty = 1;               // 游戏难度 (0=简单, 1=普通, 2=困难)
+    bool startAtBoss = false;         // 直接从Boss战开始
+    std::string botKind = "dodge";    // 操作玩家的机器人类型
+    std::string botUpgrades = "cycle"; // 机器人的升级选择策略
+    float fieldWidth = 1200;          // 场地宽度，与游戏窗口一致
+    float fieldHeight = 750;          // 场地高度
+    int fps = 60;                     // 逻辑帧率
+    Uint64 maxTicks = 0;              // 最多运行的逻辑帧数（0表示不限）
+};
+
+// 一局模拟的结果
+struct SimResult {
+    bool finished = false;            // 本局是否正常结束（否则为达到帧数上限）
+    bool victory = false;             // 是否击败Boss
+    int finalScore = 0;               // 最终得分
+    BossProgress bossProgress = BossProgress::None; // Boss战进度
+    Weapon weapon;                    // 结束时的武器
+    Uint32 durationMs = 0;            // 本局时长（模拟时间，到本局结束为止）
+    Uint64 ticks = 0;                 // 运行的逻辑帧数
+};
+
+/**
+ * 无窗口的游戏模拟
+ * 自己提供时钟、输入（机器人）、随机种子，音频和渲染为空实现，
+ * 不使用Game单例，同一进程中可以同时运行多个，也可以分别放在不同线程中
+ */
+class SimWorld : public GameServices
+{
+public:
+    explicit SimWorld(const SimWorldConfig& config);
+    ~SimWorld() override;
+    SimWorld(const SimWorld&) = delete;
+    SimWorld& operator=(const SimWorld&) = delete;
+
+    /**
+     * 创建机器人和起始场景
+     * @return 机器人类型或升级策略无法识别时返回false
+     */
+    bool start();
+    void step();        // 推进一个逻辑帧
+    SimResult run();    // 一直运行到本局结束或达到帧数上限
+    bool isDone() const { return finished || (config.maxTicks > 0 && ticks >= config.maxTicks); }
+    const SimResult& getResult() const { return result; }
+    const TickHash& hashState(); // 计算刚完成的逻辑帧的状态哈希
+
+    // GameServices
+    Uint64 getSimTicks() const override { return simTicks * 1000 / config.fps; }
+    const PlayerInput& getInput() const override { return input; }
+    void requestPauseToggle() override {}
+    void requestUpgradeChoice(int) override {}
+    float getWindowWidth() const override { return config.fieldWidth; }
+    float getWindowHeight() const override { return config.fieldHeight; }
+    int getDifficulty() const override { return config.difficulty; }
+    Uint64 getRunSeed() const override { return config.seed; }
+    Profiler& getProfiler() override { return profiler; }
+    FrameArena& getFrameArena() override { return frameArena; }
+    void playSfx(SoundId) override {}
+    void playBgm(MusicId, bool = false) override {}
+    void preloadBgm(MusicId) override {}
+    SDL_Texture* loadTexture(const char* path, float* width = nullptr, float* height = nullptr) override;
+    TTF_Font* loadFont(const char*, float) override { return nullptr; }
+    SDL_Renderer* getRenderer() const override { return nullptr; }
+    SDL_FPoint renderTextCentered(std::string_view, float, bool) override { return {0, 0}; }
+    void renderTextPos(std::string_view, float, float, bool = true) override {}
+    void renderBackground() override {}
+    void setBackgroundSpeed(int, int) override {}
+    void changeScene(Scene* scene) override;
+    void beginRun() override { simTicks = 0; }
+    void endRun(const Weapon& weapon, BossProgress progress) override;
+    void setFinalScore(int score) override { result.finalScore = score; }
+    void showRunResult(bool victory) override;
+    void returnToTitle() override { finished = true; }
+
+private:
+    SimWorldConfig config;
+    Scene* currentScene = nullptr;
+    std::unique_ptr<BotController> bot;
+    BotView botView;            // 每帧交给机器人的场景信息
+    PlayerInput input;          // 当前逻辑帧的输入
+    Profiler profiler;          // 默认不启用
+    FrameArena frameArena;      // 每个逻辑帧开始时清空
+    StateHasher stateHasher;
+    SimResult result;
+    float deltaTime;            // 每个逻辑帧的时长（秒）
+    Uint64 simTicks = 0;        // 本局已模拟的逻辑帧数
+    Uint64 ticks = 0;           // 启动以来运行的逻辑帧数
+    bool finished = false;      // 本局已结束
+};
+
+#endif // SIM_WORLD_H
@@ -0,0 +1,84 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+/**
+ * 单生产者单消费者无锁环形队列
+ * 只允许一个线程调用push，另一个线程调用pop，双方都不会加锁或分配内存
+ * @tparam T 元素类型，要求可平凡复制
+ * @tparam Capacity 容量，必须是2的幂
+ */
+template<typename T, size_t Capacity>
+class SpscQueue
+{
+    static_assert((Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+    static_assert(std::is_trivially_copyable_v<T>, "SpscQueue element must be trivially copyable");
+
+public:
+    /**
+     * 生产者线程调用：写入一个元素
+     * @return 队列已满时返回false，元素被丢弃
+     */
+    bool push(const T& value) {
+        size_t tail = writeIndex.load(std::memory_order_relaxed);
+        if (tail - cachedReadIndex >= Capacity) {
+            cachedReadIndex = readIndex.load(std::memory_order_acquire);
+            if (tail - cachedReadIndex >= Capacity) {
+                return false;
+            }
+        }
+        buffer[tail & (Capacity - 1)] = value;
+        writeIndex.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * 消费者线程调用：取出一个元素
+     * @return 队列为空时返回false
+     */
+    bool pop(T& value) {
+        size_t head = readIndex.load(std::memory_order_relaxed);
+        if (head == cachedWriteIndex) {
+            cachedWriteIndex = writeIndex.load(std::memory_order_acquire);
+            if (head == cachedWriteIndex) {
+                return false;
+            }
+        }
+        value = buffer[head & (Capacity - 1)];
+        readIndex.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * 生产者线程调用：当前可写入的元素数
+     * 消费者可能同时取出元素，实际可用空间只会比返回值多
+     */
+    size_t freeSpace() {
+        cachedReadIndex = readIndex.load(std::memory_order_acquire);
+        return Capacity - (writeIndex.load(std::memory_order_relaxed) - cachedReadIndex);
+    }
+
+    /**
+     * 消费者线程调用：队列是否为空
+     * 生产者可能同时写入元素，返回true之后队列可能已经不为空
+     */
+    bool empty() {
+        cachedWriteIndex = writeIndex.load(std::memory_order_acquire);
+        return readIndex.load(std::memory_order_relaxed) == cachedWriteIndex;
+    }
+
+    size_t capacity() const { return Capacity; }
+
+private:
+    // 读写索引分开放在不同缓存行，避免伪共享
+    alignas(64) std::atomic<size_t> writeIndex{0}; // 生产者写入位置
+    size_t cachedReadIndex = 0;                     // 生产者缓存的读取位置
+    alignas(64) std::atomic<size_t> readIndex{0};  // 消费者读取位置
+    size_t cachedWriteIndex = 0;                    // 消费者缓存的写入位置
+    alignas(64) T buffer[Capacity];
+};
+
+#endif // SPSC_QUEUE_H
@@ -0,0 +1,82 @@
+#include "StateHasher.h"
+
+namespace
+{
+    constexpr Uint64 ENTITY_SEED = 0xCBF29CE484222325ull;
+    constexpr Uint64 CATEGORY_SEED = 0x84222325CBF29CE4ull;
+
+    // 最终混合，保证单个比特的变化扩散到整个结果
+    Uint64 finalize(Uint64 value)
+    {
+        value ^= value >> 33;
+        value *= 0xFF51AFD7ED558CCDull;
+        value ^= value >> 33;
+        value *= 0xC4CEB9FE1A85EC53ull;
+        value ^= value >> 33;
+        return value;
+    }
+}
+
+void StateHasher::beginTick(Uint32 tick)
+{
+    current.tick = tick;
+    for (int i = 0; i < HASH_CATEGORY_COUNT; i++) {
+        categoryState[i] = CATEGORY_SEED;
+        current.counts[i] = 0;
+        current.entities[i].clear();
+    }
+    openCategory = -1;
+}
+
+void StateHasher::beginEntity(HashCategory category)
+{
+    closeEntity();
+    openCategory = static_cast<int>(category);
+    entityState = ENTITY_SEED;
+}
+
+void StateHasher::add(const Rng& rng)
+{
+    for (int i = 0; i < 4; i++) {
+        add(rng.getState(i));
+    }
+}
+
+void StateHasher::closeEntity()
+{
+    if (openCategory < 0) {
+        return;
+    }
+    Uint64 entityHash = finalize(entityState);
+    categoryState[openCategory] = (categoryState[openCategory] ^ entityHash) * 0x9E3779B97F4A7C15ull;
+    current.counts[openCategory]++;
+    if (detail) {
+        current.entities[openCategory].push_back(static_cast<Uint32>(entityHash));
+    }
+    openCategory = -1;
+}
+
+const TickHash& StateHasher::endTick()
+{
+    closeEntity();
+    for (int i = 0; i < HASH_CATEGORY_COUNT; i++) {
+        current.hashes[i] = static_cast<Uint32>(finalize(categoryState[i] ^ current.counts[i]));
+    }
+    return current;
+}
+
+const char* StateHasher::getCategoryName(HashCategory category)
+{
+    switch (category) {
+        case HashCategory::Player: return "player";
+        case HashCategory::Boss: return "boss";
+        case HashCategory::Enemies: return "enemies";
+        case HashCategory::PlayerShots: return "player projectiles";
+        case HashCategory::EnemyShots: return "enemy projectiles";
+        case HashCategory::Items: return "items";
+        case HashCategory::Effects: return "effects";
+        case HashCategory::Score: return "score";
+        case HashCategory::Rng: return "rng";
+        default: return "unknown";
+    }
+}
@@ -0,0 +1,80 @@
+#ifndef STATE_HASHER_H
+#define STATE_HASHER_H
+
+#include "Random.h"
+#include <SDL3/SDL.h>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+// 参与哈希的状态分类，出现不一致时按分类定位
+enum class HashCategory : Uint8 {
+    Player,      // 玩家位置、血量、武器
+    Boss,        // Boss位置、血量、弹幕状态
+    Enemies,     // 敌人
+    PlayerShots, // 玩家子弹
+    EnemyShots,  // 敌人和Boss子弹
+    Items,       // 道具
+    Effects,     // 爆炸和各类实体的数量
+    Score,       // 分数、升级和过渡状态
+    Rng,         // 随机数流状态
+    Count
+};
+
+constexpr int HASH_CATEGORY_COUNT = static_cast<int>(HashCategory::Count);
+
+// 一个逻辑帧结束时的状态哈希
+struct TickHash {
+    Uint32 tick = 0;                                    // 本局内的逻辑帧序号
+    Uint32 hashes[HASH_CATEGORY_COUNT] = {};            // 各分类的哈希
+    Uint16 counts[HASH_CATEGORY_COUNT] = {};            // 各分类的实体数量
+    std::vector<Uint32> entities[HASH_CATEGORY_COUNT];  // 各实体的哈希（仅详细模式）
+};
+
+/**
+ * 模拟状态哈希
+ * 场景在每个逻辑帧结束后按固定顺序把实体字段逐个喂进来，
+ * 每个字段只做一次异或和乘法，几百个实体的开销在微秒级
+ */
+class StateHasher
+{
+public:
+    void setDetail(bool enabled) { detail = enabled; } // 是否保存每个实体的哈希
+    bool isDetail() const { return detail; }
+
+    void beginTick(Uint32 tick); // 开始一个逻辑帧
+    const TickHash& endTick();   // 结束并返回本帧哈希
+
+    /**
+     * 开始一个新实体，之后add的字段都属于它
+     * @param category 实体所属分类
+     */
+    void beginEntity(HashCategory category);
+
+    // 加入一个字段（整数、浮点、枚举等不超过8字节的平凡类型）
+    template<typename T>
+    void add(const T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value && sizeof(T) <= 8, "field must be a plain value");
+        Uint64 bits = 0;
+        std::memcpy(&bits, &value, sizeof(T));
+        entityState = (entityState ^ bits) * 0x100000001B3ull;
+        entityState ^= entityState >> 29;
+    }
+
+    void add(const SDL_FPoint& point) { add(point.x); add(point.y); }
+    void add(const Rng& rng); // 加入随机数生成器的完整状态
+
+    static const char* getCategoryName(HashCategory category);
+
+private:
+    TickHash current;
+    Uint64 categoryState[HASH_CATEGORY_COUNT] = {};
+    Uint64 entityState = 0;
+    int openCategory = -1; // 正在写入的实体所属分类
+    bool detail = false;
+
+    void closeEntity(); // 把当前实体并入所属分类
+};
+
+#endif // STATE_HASHER_H
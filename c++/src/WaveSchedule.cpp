@@ -0,0 +1,180 @@
+#include "WaveSchedule.h"
+#include "EnemyPaths.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+    Uint64 secondsToMicros(double seconds)
+    {
+        return static_cast<Uint64>(std::llround(seconds * 1000000.0));
+    }
+
+    bool parseFormation(const std::string& name, WaveFormation& formation)
+    {
+        if (name == "single") formation = WaveFormation::Single;
+        else if (name == "column") formation = WaveFormation::Column;
+        else if (name == "vee") formation = WaveFormation::Vee;
+        else if (name == "random") formation = WaveFormation::Random;
+        else return false;
+        return true;
+    }
+
+    bool parsePath(const std::string& name, WaveEvent& event)
+    {
+        event.defaultPath = false;
+        if (name == "default") event.defaultPath = true;
+        else if (name == "straight") event.path = EnemyMotion::Straight;
+        else if (name == "wave") event.path = EnemyMotion::Wave;
+        else if (name == "spin") event.path = EnemyMotion::Spin;
+        else {
+            for (int i = 0; i < ENEMY_PATH_COUNT; i++) {
+                if (name == ENEMY_PATHS[i].name) {
+                    event.path = EnemyMotion::Path;
+                    event.motionPath = i;
+                    return true;
+                }
+            }
+            return false;
+        }
+        return true;
+    }
+}
+
+bool WaveSchedule::load(const std::string& path)
+{
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Wave file not found: %s", path.c_str());
+        return false;
+    }
+
+    std::vector<WaveEvent> loadedEvents;
+    std::vector<AmbientSpawn> loadedAmbients;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+        std::istringstream iss(line);
+        std::string first;
+        if (!(iss >> first)) {
+            continue; // 空行
+        }
+
+        if (first == "ambient") {
+            double start = 0;
+            std::string end;
+            float rate = 0;
+            if (!(iss >> start >> end >> rate) || start < 0 || rate < 0) {
+                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "%s:%d: expected 'ambient <start> <end|-> <rate>'", path.c_str(), lineNumber);
+                continue;
+            }
+            AmbientSpawn ambient;
+            ambient.start = secondsToMicros(start);
+            ambient.end = end == "-" ? SDL_MAX_UINT64 : secondsToMicros(std::atof(end.c_str()));
+            ambient.rate = rate;
+            if (ambient.end <= ambient.start) {
+                SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "%s:%d: ambient spawn ends before it starts", path.c_str(), lineNumber);
+                continue;
+            }
+            loadedAmbients.push_back(ambient);
+            continue;
+        }
+
+        WaveEvent event;
+        double seconds = std::atof(first.c_str());
+        std::string formation, pathName;
+        if (!(iss >> event.archetype >> event.count >> formation >> pathName) || seconds < 0) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "%s:%d: expected '<time> <type> <count> <formation> <path> [y]'", path.c_str(), lineNumber);
+            continue;
+        }
+        if (event.archetype < 0 || event.archetype >= ENEMY_ARCHETYPE_COUNT || event.count <= 0 ||
+            !parseFormation(formation, event.formation) || !parsePath(pathName, event)) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "%s:%d: invalid wave '%s'", path.c_str(), lineNumber, line.c_str());
+            continue;
+        }
+        iss >> event.y; // 可选，默认屏幕中间
+        event.y = std::clamp(event.y, 0.0f, 1.0f);
+        event.time = secondsToMicros(seconds);
+        loadedEvents.push_back(event);
+    }
+
+    if (loadedEvents.empty() && loadedAmbients.empty()) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Wave file has no spawns: %s", path.c_str());
+        return false;
+    }
+
+    // 同一时间的事件保持文件中的顺序
+    std::stable_sort(loadedEvents.begin(), loadedEvents.end(),
+                     [](const WaveEvent& a, const WaveEvent& b) { return a.time < b.time; });
+    std::stable_sort(loadedAmbients.begin(), loadedAmbients.end(),
+                     [](const AmbientSpawn& a, const AmbientSpawn& b) { return a.start < b.start; });
+    // 随机生成时段不重叠，重叠时前一段在后一段开始时结束
+    for (size_t i = 1; i < loadedAmbients.size(); i++) {
+        if (loadedAmbients[i - 1].end > loadedAmbients[i].start) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "%s: overlapping ambient spawns, earlier one is cut short", path.c_str());
+            loadedAmbients[i - 1].end = loadedAmbients[i].start;
+        }
+    }
+
+    events = std::move(loadedEvents);
+    ambients = std::move(loadedAmbients);
+    restart();
+    return true;
+}
+
+void WaveSchedule::loadDefault()
+{
+    events.clear();
+    ambients.clear();
+    AmbientSpawn ambient;
+    ambient.start = 0;
+    ambient.end = SDL_MAX_UINT64;
+    ambient.rate = 1.0f;
+    ambients.push_back(ambient);
+    restart();
+}
+
+void WaveSchedule::restart()
+{
+    cursor = 0;
+    ambientCursor = 0;
+    time = 0;
+}
+
+const WaveEvent* WaveSchedule::advance(float deltaTime)
+{
+    time += secondsToMicros(deltaTime);
+    const WaveEvent* first = events.data() + cursor;
+    while (cursor < events.size() && events[cursor].time <= time) {
+        cursor++;
+    }
+    while (ambientCursor < ambients.size() && ambients[ambientCursor].end <= time) {
+        ambientCursor++;
+    }
+    return first;
+}
+
+float WaveSchedule::getAmbientRate() const
+{
+    if (ambientCursor < ambients.size() && ambients[ambientCursor].start <= time) {
+        return ambients[ambientCursor].rate;
+    }
+    return 0.0f;
+}
+
+const char* WaveSchedule::pathForDifficulty(int difficulty)
+{
+    switch (difficulty) {
+        case 0: return "assets/waves/easy.txt";
+        case 2: return "assets/waves/hard.txt";
+        default: return "assets/waves/normal.txt";
+    }
+}
@@ -0,0 +1,80 @@
+#ifndef WAVE_SCHEDULE_H
+#define WAVE_SCHEDULE_H
+
+#include "EnemyArchetype.h"
+#include <SDL3/SDL.h>
+#include <string>
+#include <vector>
+
+// 一波敌人的队形
+enum class WaveFormation : Uint8 {
+    Single, // 同一高度依次从右侧进入
+    Column, // 竖排同时进入
+    Vee,    // V字形，中间的敌人在最前
+    Random  // 每个敌人随机高度
+};
+
+// 一波敌人：到时间后按队形生成count个同类敌人
+struct WaveEvent {
+    Uint64 time = 0;                               // 生成时间（微秒，从关卡开始计）
+    int archetype = 0;                             // 敌人类型（ENEMY_ARCHETYPES的下标）
+    int count = 1;                                 // 敌人数量
+    WaveFormation formation = WaveFormation::Single;
+    EnemyMotion path = EnemyMotion::Straight;      // 移动方式
+    int motionPath = 0;                            // path为Path时的路径（ENEMY_PATHS的下标）
+    bool defaultPath = true;                       // 为true时使用敌人类型自己的移动方式
+    float y = 0.5f;                                // 队形中心的高度（0为顶部，1为底部）
+};
+
+// 随机生成时段：时段内平均每秒生成rate个按权重随机选择类型的敌人（每个逻辑帧的生成概率为rate乘以帧时长）
+struct AmbientSpawn {
+    Uint64 start = 0;   // 开始时间（微秒）
+    Uint64 end = 0;     // 结束时间（微秒），不包含
+    float rate = 0;     // 平均每秒生成的敌人数
+};
+
+/**
+ * 敌人波次时间表
+ * 从文本文件读取，每行一条，#之后为注释，时间单位为秒：
+ *   <时间> <类型> <数量> <队形> <路径> [高度]
+ *     队形: single | column | vee | random
+ *     路径: default | straight | wave | spin | ENEMY_PATHS中的路径名（swoop、loop等）
+ *   ambient <开始> <结束|-> <每秒数量>
+ * 事件按时间排好序，每帧只检查下一条，开销只与本帧到期的事件数有关
+ * 时钟只在关卡正常进行时推进（暂停和Boss过渡时停止）
+ */
+class WaveSchedule
+{
+public:
+    /**
+     * 读取时间表
+     * @param path 文件路径
+     * @return 文件不存在或没有有效内容时返回false，原内容不变
+     */
+    bool load(const std::string& path);
+    void loadDefault();  // 内置时间表：整局每秒随机生成一个敌人
+    void restart();      // 时钟回到0
+
+    /**
+     * 推进时钟
+     * @param deltaTime 经过的时间（秒）
+     * @return 本帧到期的第一个事件，到期事件在[返回值, getDueEnd())中
+     */
+    const WaveEvent* advance(float deltaTime);
+    const WaveEvent* getDueEnd() const { return events.data() + cursor; }
+    float getAmbientRate() const; // 当前的随机生成速率（每秒）
+
+    Uint64 getTime() const { return time; }
+    size_t getEventCount() const { return events.size(); }
+
+    static const char* pathForDifficulty(int difficulty); // 各难度使用的时间表文件
+
+private:
+    std::vector<WaveEvent> events;       // 按时间排序
+    std::vector<AmbientSpawn> ambients;  // 按开始时间排序
+    size_t cursor = 0;                   // 下一个未到期的事件
+    size_t ambientCursor = 0;            // 当前或下一个随机生成时段
+    Uint64 time = 0;                     // 关卡时钟（微秒）
+};
+
+#endif // WAVE_SCHEDULE_H